@@ -8,10 +8,12 @@ extern char* analyze_frame(void* engine, const uint8_t* image_data, int width, i
 extern void* enhance_image(void* engine, const uint8_t* image_data, int width, int height, int format,
                            const float* corners, int apply_perspective, int apply_deskew, int apply_enhance,
                            int apply_sharpening, float sharpening_strength, int enhance_mode,
-                           int output_width, int output_height);
+                           int output_width, int output_height, int apply_moire_removal,
+                           const int* level_sizes, int level_count);
 extern void* enhance_image_with_guide_frame(void* engine, const uint8_t* image_data, int width, int height, int format,
                            float guide_left, float guide_top, float guide_right, float guide_bottom,
-                           int apply_sharpening, float sharpening_strength, int enhance_mode);
+                           int apply_sharpening, float sharpening_strength, int enhance_mode,
+                           int rotation, const int* level_sizes, int level_count);
 extern int get_enhancement_success(void* result);
 extern uint8_t* get_enhancement_image_data(void* result);
 extern int get_enhancement_width(void* result);
@@ -51,8 +53,8 @@ extern const char* get_version(void);
         free_string(NULL);
 
         // Force link enhance_image and result accessors
-        void* result = enhance_image(NULL, NULL, 0, 0, 0, NULL, 0, 0, 0, 0, 0.0f, 0, 0, 0);
-        enhance_image_with_guide_frame(NULL, NULL, 0, 0, 0, 0.0f, 0.0f, 0.0f, 0.0f, 0, 0.0f, 0);
+        void* result = enhance_image(NULL, NULL, 0, 0, 0, NULL, 0, 0, 0, 0, 0.0f, 0, 0, 0, 0, NULL, 0);
+        enhance_image_with_guide_frame(NULL, NULL, 0, 0, 0, 0.0f, 0.0f, 0.0f, 0.0f, 0, 0.0f, 0, 0, NULL, 0);
         get_enhancement_success(result);
         get_enhancement_image_data(result);
         get_enhancement_width(result);
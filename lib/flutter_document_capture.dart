@@ -15,6 +15,101 @@ enum EnhanceMode {
   contrastStretch, // Contrast stretching
   adaptiveBinarize, // Adaptive binarization
   sauvola,       // Sauvola binarization
+  auto,          // Chain and output size chosen by the detected document type
+}
+
+/// Document type from quad geometry and page appearance
+enum DocumentType {
+  unknown,
+  receipt,
+  a4,
+  letter,
+  idCard,
+  whiteboard,
+  page,       // Other paper page
+}
+
+/// Cause of blur, for "hold still" vs "refocus" hints
+enum BlurType {
+  none,    // Sharp enough
+  defocus, // Out of focus: tap to refocus / move back
+  motion,  // Camera or page moving: hold still
+}
+
+/// Framing instruction (directions are phone movements)
+enum FramingGuidance {
+  none,          // No document
+  ok,
+  moveCloser,
+  moveBack,      // Too large or cut off by the frame
+  moveLeft,
+  moveRight,
+  moveUp,
+  moveDown,
+  holdParallel,  // Tilted; hold the phone parallel to the page
+}
+
+/// Known document format for fixed-aspect detection
+enum DocumentProfile {
+  any,      // Any convex quad
+  idCard,   // ISO/IEC 7810 ID-1 (85.60 x 53.98 mm)
+  passport, // ID-3 passport page (125 x 88 mm)
+  a4,       // 297 x 210 mm
+  letter,   // 11 x 8.5 in
+  custom,   // Aspect given by the caller
+}
+
+/// Document detector implementation
+enum DetectorBackend {
+  classical, // Canny + contour quad search
+  dnn,       // Edge/corner heatmap network (OpenCV dnn, CPU)
+}
+
+/// Kind of machine-readable code region
+enum CodeType {
+  unknown,
+  qr,     // QR code (three finder patterns)
+  linear, // 1-D barcode
+}
+
+/// Reason for the recommended analysis rate
+enum RateState {
+  active,    // Converging on a document: full rate
+  searching, // Scene changing, no document yet
+  idle,      // Nothing changing
+  moving,    // Fast device motion
+}
+
+/// IMU sample type for [DocumentCaptureEngine.pushImuSample]
+enum ImuSampleType {
+  gyroscope,     // rad/s
+  accelerometer, // m/s^2, gravity included
+}
+
+/// Continuous (book) scan state
+enum ScanState {
+  off,            // Continuous scan disabled
+  waitingForTurn, // Showing the last captured page
+  turning,        // Page content changing
+  settling,       // New page, waiting for it to hold still
+}
+
+/// Per-frame status of receipt stitching
+enum StitchFrameStatus {
+  inactive, // Stitching not started
+  started,  // First strip written
+  appended, // New content appended
+  tracking, // Registered, waiting for more new content
+  lost,     // Registration failed, hold steady / realign
+  tooFast,  // Panning too fast
+  full,     // Maximum height reached
+}
+
+/// Snap target for manual corner editing
+enum SnapMode {
+  auto,   // Nearest corner, falls back to nearest edge
+  corner, // Corners only
+  edge,   // Edges only
 }
 
 const String _libName = 'flutter_document_capture';
@@ -57,6 +152,35 @@ class DocumentCaptureEngine {
   /// Check if engine is initialized
   bool get isInitialized => _isInitialized;
 
+  /// Prime the engine before the scanner opens
+  ///
+  /// Sizes the frame buffers for the declared stream and runs
+  /// analysis/enhancement once on a synthetic page,
+  /// so the first real [analyzeFrame] runs at steady-state speed. Tracking
+  /// state is reset afterwards. Returns the warm-up time in ms (-1 on error).
+  ///
+  /// [format] - 0: BGRA, 1: BGR, 2: RGB (same as the stream)
+  double warmUp(int width, int height, {int format = 0, int rotation = 0}) {
+    if (!_isInitialized || _engine == null) {
+      return -1;
+    }
+    return _bindings.capture_engine_warm_up(_engine!, width, height, format, rotation);
+  }
+
+  /// Startup latency since engine creation (see [StartupStats])
+  StartupStats getStartupStats() {
+    if (!_isInitialized || _engine == null) {
+      return StartupStats();
+    }
+
+    final resultPtr = _bindings.capture_engine_get_startup_stats(_engine!);
+    try {
+      return StartupStats.fromJson(jsonDecode(resultPtr.cast<Utf8>().toDartString()));
+    } finally {
+      _bindings.free_string(resultPtr);
+    }
+  }
+
   /// Reset engine state (clears stability history)
   void reset() {
     if (_isInitialized && _engine != null) {
@@ -64,6 +188,119 @@ class DocumentCaptureEngine {
     }
   }
 
+  /// Enable or disable continuous (hands-free book) scan mode
+  ///
+  /// When enabled, [analyzeFrame] tracks content change on the document
+  /// region and sets [FrameAnalysisResult.scanTrigger] once per new page,
+  /// after the turned page has settled.
+  void setContinuousScan(bool enabled) {
+    if (_isInitialized && _engine != null) {
+      _bindings.capture_engine_set_continuous_scan(_engine!, enabled ? 1 : 0);
+    }
+  }
+
+  /// Load a detector network for [DetectorBackend.dnn]
+  ///
+  /// [modelPath] - Local model file readable by OpenCV dnn (e.g. ONNX) with
+  /// a 1x3xSxS RGB input and either 4 corner heatmaps (TL,TR,BR,BL) or one
+  /// edge probability map as output.
+  /// [inputSize] - Network input side S
+  /// Returns false if the model can't be loaded or dnn is not built in.
+  bool loadDetectorModel(String modelPath, {int inputSize = 256}) {
+    if (!_isInitialized || _engine == null) {
+      return false;
+    }
+
+    final pathPtr = modelPath.toNativeUtf8();
+    try {
+      return _bindings.capture_engine_load_detector_model(
+              _engine!, pathPtr.cast<Char>(), inputSize) !=
+          0;
+    } finally {
+      malloc.free(pathPtr);
+    }
+  }
+
+  /// Select the document detector used by [analyzeFrame]
+  ///
+  /// Returns false (and keeps the current backend) when [DetectorBackend.dnn]
+  /// is requested without a loaded model.
+  bool setDetectorBackend(DetectorBackend backend) {
+    if (!_isInitialized || _engine == null) {
+      return false;
+    }
+    return _bindings.capture_engine_set_detector_backend(_engine!, backend.index) != 0;
+  }
+
+  /// Constrain detection to a known document format
+  ///
+  /// Candidates are scored against the aspect ratio after removing
+  /// perspective, and auto-sized perspective output has exactly that aspect.
+  /// [customAspect] - Long/short side ratio for [DocumentProfile.custom]
+  void setDocumentProfile(DocumentProfile profile, {double customAspect = 0}) {
+    if (_isInitialized && _engine != null) {
+      _bindings.capture_engine_set_document_profile(_engine!, profile.index, customAspect);
+    }
+  }
+
+  /// Set bounds for [FrameAnalysisResult.recommendedFps]
+  ///
+  /// Defaults are 5 (idle) and 30 (converging). Values <= 0 keep the
+  /// current setting.
+  void setFrameRateLimits({int minFps = 0, int maxFps = 0}) {
+    if (_isInitialized && _engine != null) {
+      _bindings.capture_engine_set_frame_rate_limits(_engine!, minFps, maxFps);
+    }
+  }
+
+  /// Set framing guidance targets
+  ///
+  /// [targetFill] - Desired document area as a fraction of the frame
+  /// [minTextPx] - Minimum estimated text height in analyzed-frame pixels
+  /// Values <= 0 keep the current setting.
+  void setFramingTarget({double targetFill = 0, double minTextPx = 0}) {
+    if (_isInitialized && _engine != null) {
+      _bindings.capture_engine_set_framing_target(_engine!, targetFill, minTextPx);
+    }
+  }
+
+  /// Enable or disable QR/barcode region detection (default: disabled)
+  ///
+  /// When enabled, [FrameAnalysisResult.codes] lists candidate code regions
+  /// found on the low-resolution analysis image. Decode them from the
+  /// full-resolution frame and skip full-page OCR when the code carries
+  /// the data.
+  void setBarcodeDetection(bool enabled) {
+    if (_isInitialized && _engine != null) {
+      _bindings.capture_engine_set_barcode_detection(_engine!, enabled ? 1 : 0);
+    }
+  }
+
+  /// Enable or disable the occlusion veto (default: enabled)
+  ///
+  /// When enabled, fingers detected over the document edges keep
+  /// [FrameAnalysisResult.captureReady] false. Occluded edges are reported
+  /// either way in [FrameAnalysisResult.occludedEdges].
+  void setOcclusionVeto(bool enabled) {
+    if (_isInitialized && _engine != null) {
+      _bindings.capture_engine_set_occlusion_veto(_engine!, enabled ? 1 : 0);
+    }
+  }
+
+  /// Push a gyroscope or accelerometer sample (e.g. from sensors_plus)
+  ///
+  /// With IMU samples flowing, stability reacts to device motion
+  /// immediately and [analyzeFrame] skips image analysis during fast motion
+  /// (see [FrameAnalysisResult.analysisSkipped]). Samples older than ~300 ms
+  /// are ignored, so stopping the stream falls back to image-only stability.
+  ///
+  /// [timestampNs] - Sensor timestamp in nanoseconds (monotonic)
+  void pushImuSample(ImuSampleType type, double x, double y, double z, int timestampNs) {
+    if (_isInitialized && _engine != null) {
+      _bindings.capture_engine_push_imu_sample(_engine!, type.index, x, y, z, timestampNs);
+    }
+  }
+
   /// Analyze a single frame for document detection and quality assessment
   ///
   /// [imageData] - Raw image bytes
@@ -132,6 +369,12 @@ class DocumentCaptureEngine {
   /// [enhanceMode] - Enhancement mode for OCR optimization
   /// [outputWidth] - Desired output width (0 for auto)
   /// [outputHeight] - Desired output height (0 for auto)
+  /// [removeMoire] - Notch-filter screen moire (see [FrameAnalysisResult.moireScore])
+  /// [store] - Append the page to this store instead of copying it to Dart;
+  ///   the result then has [EnhancementResult.pageIndex] and no image data
+  /// [levelSizes] - Long side (px) of up to 3 extra downscaled outputs, e.g.
+  ///   [1280, 240] for a display image and a thumbnail, made in the same
+  ///   call from the enhanced page (see [EnhancementResult.levels])
   ///
   /// Returns [EnhancementResult] with corrected image data
   EnhancementResult enhanceImage(
@@ -148,6 +391,9 @@ class DocumentCaptureEngine {
     EnhanceMode enhanceMode = EnhanceMode.none,
     int outputWidth = 0,
     int outputHeight = 0,
+    bool removeMoire = false,
+    PageStore? store,
+    List<int> levelSizes = const [],
   }) {
     if (!_isInitialized || _engine == null) {
       return EnhancementResult.error('Engine not initialized');
@@ -165,6 +411,8 @@ class DocumentCaptureEngine {
       cornersPtr[i] = corners[i];
     }
 
+    final levelsPtr = _allocLevelSizes(levelSizes);
+
     Pointer<Void>? resultPtr;
     try {
       resultPtr = _bindings.enhance_image(
@@ -182,6 +430,9 @@ class DocumentCaptureEngine {
         enhanceMode.index,
         outputWidth,
         outputHeight,
+        removeMoire ? 1 : 0,
+        levelsPtr,
+        levelSizes.length,
       );
 
       if (resultPtr == nullptr) {
@@ -198,6 +449,22 @@ class DocumentCaptureEngine {
       final resultWidth = _bindings.get_enhancement_width(resultPtr);
       final resultHeight = _bindings.get_enhancement_height(resultPtr);
       final channels = _bindings.get_enhancement_channels(resultPtr);
+
+      if (store != null) {
+        final pageIndex = store._appendResult(resultPtr, enhanceMode.index, cornersPtr);
+        if (pageIndex < 0) {
+          return EnhancementResult.error(store.lastError);
+        }
+        return EnhancementResult(
+          success: true,
+          width: resultWidth,
+          height: resultHeight,
+          channels: channels,
+          pageIndex: pageIndex,
+          levels: _readLevels(resultPtr, channels),
+        );
+      }
+
       final imageDataPtr = _bindings.get_enhancement_image_data(resultPtr);
 
       final dataSize = resultWidth * resultHeight * channels;
@@ -211,10 +478,12 @@ class DocumentCaptureEngine {
         width: resultWidth,
         height: resultHeight,
         channels: channels,
+        levels: _readLevels(resultPtr, channels),
       );
     } finally {
       malloc.free(dataPtr);
       malloc.free(cornersPtr);
+      malloc.free(levelsPtr);
       if (resultPtr != null && resultPtr != nullptr) {
         _bindings.free_enhancement_result(resultPtr);
       }
@@ -251,6 +520,7 @@ class DocumentCaptureEngine {
     double sharpeningStrength = 0.5,
     EnhanceMode enhanceMode = EnhanceMode.none,
     int rotation = 0,
+    List<int> levelSizes = const [],
   }) {
     if (!_isInitialized || _engine == null) {
       return EnhancementResult.error('Engine not initialized');
@@ -259,6 +529,8 @@ class DocumentCaptureEngine {
     final dataPtr = malloc<Uint8>(imageData.length);
     dataPtr.asTypedList(imageData.length).setAll(0, imageData);
 
+    final levelsPtr = _allocLevelSizes(levelSizes);
+
     Pointer<Void>? resultPtr;
     try {
       resultPtr = _bindings.enhance_image_with_guide_frame(
@@ -275,6 +547,8 @@ class DocumentCaptureEngine {
         sharpeningStrength,
         enhanceMode.index,
         rotation,
+        levelsPtr,
+        levelSizes.length,
       );
 
       if (resultPtr == nullptr) {
@@ -304,136 +578,1254 @@ class DocumentCaptureEngine {
         width: resultWidth,
         height: resultHeight,
         channels: channels,
+        levels: _readLevels(resultPtr, channels),
       );
     } finally {
       malloc.free(dataPtr);
+      malloc.free(levelsPtr);
       if (resultPtr != null && resultPtr != nullptr) {
         _bindings.free_enhancement_result(resultPtr);
       }
     }
   }
 
-  /// Dispose the engine and free resources
-  void dispose() {
-    if (_isInitialized && _engine != null) {
-      _bindings.capture_engine_destroy(_engine!);
-      _engine = null;
-      _isInitialized = false;
+  /// Extract the ruling-line table grid of a page
+  ///
+  /// [corners] - Document corners [x0,y0,x1,y1,x2,y2,x3,y3] (TL,TR,BR,BL) to
+  /// rectify first, or null if [imageData] is already a rectified page.
+  /// Cell rectangles are in rectified page coordinates.
+  TableAnalysisResult analyzeTable(
+    Uint8List imageData,
+    int width,
+    int height, {
+    List<double>? corners,
+    int format = 1,
+  }) {
+    if (!_isInitialized || _engine == null) {
+      return TableAnalysisResult.error('Engine not initialized');
     }
-  }
-}
 
-/// Represents a single text region bounds [x, y, width, height]
-class TextRegionBounds {
-  final double x;
-  final double y;
-  final double width;
-  final double height;
+    if (corners != null && corners.length != 8) {
+      return TableAnalysisResult.error('Corners must have 8 values');
+    }
 
-  TextRegionBounds({
-    required this.x,
-    required this.y,
-    required this.width,
-    required this.height,
-  });
+    final dataPtr = malloc<Uint8>(imageData.length);
+    dataPtr.asTypedList(imageData.length).setAll(0, imageData);
 
-  Rect toRect() => Rect.fromLTWH(x, y, width, height);
-}
+    Pointer<Float> cornersPtr = nullptr;
+    if (corners != null) {
+      cornersPtr = malloc<Float>(8);
+      for (int i = 0; i < 8; i++) {
+        cornersPtr[i] = corners[i];
+      }
+    }
 
-/// Result of frame analysis
-class FrameAnalysisResult {
-  final bool documentFound;
-  final bool tableFound;       // True if table detected (clear rectangular border)
-  final bool textRegionFound;  // True if text region detected (fallback)
-  final List<double> corners;
-  final double cornerConfidence;
-  final double blurScore;
-  final double brightnessScore;
-  final double stabilityScore;
-  final double overallScore;
-  final bool captureReady;
-  final String? error;
+    Pointer<Char>? resultPtr;
+    try {
+      resultPtr = _bindings.analyze_table(
+        _engine!,
+        dataPtr,
+        width,
+        height,
+        format,
+        cornersPtr,
+      );
 
-  // Table/Trapezoid data
-  final bool isTrapezoid;      // True if shape needs perspective correction
-  final double skewRatio;      // Overall skew ratio (max of vertical and horizontal)
-  final double topWidth;       // Width of top edge
-  final double bottomWidth;    // Width of bottom edge
-  final double leftHeight;     // Height of left edge
-  final double rightHeight;    // Height of right edge
-  final double verticalSkew;   // Vertical skew (front-back tilt)
-  final double horizontalSkew; // Horizontal skew (left-right offset)
+      if (resultPtr == nullptr) {
+        return TableAnalysisResult.error('Table analysis failed');
+      }
 
-  // Multiple text regions data
-  final int textRegionCount;
-  final double coverageRatio;
-  final List<double> overallBounds;  // [x, y, width, height]
-  final List<TextRegionBounds> textRegions;  // Individual regions
+      final jsonStr = resultPtr.cast<Utf8>().toDartString();
+      return TableAnalysisResult.fromJson(jsonDecode(jsonStr));
+    } finally {
+      malloc.free(dataPtr);
+      if (cornersPtr != nullptr) {
+        malloc.free(cornersPtr);
+      }
+      if (resultPtr != null && resultPtr != nullptr) {
+        _bindings.free_string(resultPtr);
+      }
+    }
+  }
 
-  FrameAnalysisResult({
-    required this.documentFound,
-    this.tableFound = false,
-    this.textRegionFound = false,
-    required this.corners,
-    required this.cornerConfidence,
-    required this.blurScore,
-    required this.brightnessScore,
-    required this.stabilityScore,
-    required this.overallScore,
-    required this.captureReady,
-    this.error,
-    this.isTrapezoid = false,
-    this.skewRatio = 0,
-    this.topWidth = 0,
-    this.bottomWidth = 0,
-    this.leftHeight = 0,
-    this.rightHeight = 0,
-    this.verticalSkew = 0,
-    this.horizontalSkew = 0,
-    this.textRegionCount = 0,
-    this.coverageRatio = 0,
-    this.overallBounds = const [],
-    this.textRegions = const [],
-  });
+  /// Export OCR-ready text-line crops of a page in one packed buffer
+  ///
+  /// Lines are segmented on the rectified page, converted to gray and scaled
+  /// to [lineHeight] rows. All crops are returned back-to-back in a single
+  /// buffer with an offsets table (see [TextLineBatch.lineAt]).
+  ///
+  /// [corners] - Document corners to rectify first, or null if [imageData]
+  /// is already a rectified page.
+  TextLineBatch extractTextLines(
+    Uint8List imageData,
+    int width,
+    int height, {
+    List<double>? corners,
+    int format = 1,
+    int lineHeight = 48,
+  }) {
+    if (!_isInitialized || _engine == null) {
+      return TextLineBatch.error('Engine not initialized');
+    }
 
-  /// Returns true if either table or text region was found
-  bool get hasRegion => tableFound || textRegionFound;
+    if (corners != null && corners.length != 8) {
+      return TextLineBatch.error('Corners must have 8 values');
+    }
 
-  /// Get overall bounds as Rect (or null if not available)
-  Rect? get overallRect {
-    if (overallBounds.length == 4) {
-      return Rect.fromLTWH(overallBounds[0], overallBounds[1], overallBounds[2], overallBounds[3]);
+    final dataPtr = malloc<Uint8>(imageData.length);
+    dataPtr.asTypedList(imageData.length).setAll(0, imageData);
+
+    Pointer<Float> cornersPtr = nullptr;
+    if (corners != null) {
+      cornersPtr = malloc<Float>(8);
+      for (int i = 0; i < 8; i++) {
+        cornersPtr[i] = corners[i];
+      }
     }
-    return null;
-  }
 
-  /// Get skew percentage for display
-  int get skewPercent => (skewRatio * 100).round();
+    Pointer<Void>? batchPtr;
+    try {
+      batchPtr = _bindings.extract_text_lines(
+        _engine!,
+        dataPtr,
+        width,
+        height,
+        format,
+        cornersPtr,
+        lineHeight,
+      );
 
-  factory FrameAnalysisResult.fromJson(Map<String, dynamic> json) {
-    // Parse text regions
-    final regionsData = json['text_regions'] as List? ?? [];
-    final textRegions = regionsData.map((r) {
-      final bounds = (r as List).map((e) => (e as num).toDouble()).toList();
-      return TextRegionBounds(
-        x: bounds.isNotEmpty ? bounds[0] : 0,
-        y: bounds.length > 1 ? bounds[1] : 0,
-        width: bounds.length > 2 ? bounds[2] : 0,
-        height: bounds.length > 3 ? bounds[3] : 0,
+      if (batchPtr == nullptr) {
+        return TextLineBatch.error('Text line extraction failed');
+      }
+
+      if (_bindings.get_text_lines_success(batchPtr) != 1) {
+        final error = _bindings.get_text_lines_error(batchPtr).cast<Utf8>().toDartString();
+        return TextLineBatch.error(error);
+      }
+
+      final count = _bindings.get_text_lines_count(batchPtr);
+      final dataSize = _bindings.get_text_lines_data_size(batchPtr);
+
+      final offsets = <int>[];
+      final widths = <int>[];
+      final boxes = <Rect>[];
+      Uint8List data = Uint8List(0);
+
+      if (count > 0) {
+        data = Uint8List.fromList(_bindings.get_text_lines_data(batchPtr).asTypedList(dataSize));
+        final offsetsPtr = _bindings.get_text_lines_offsets(batchPtr);
+        final widthsPtr = _bindings.get_text_lines_widths(batchPtr);
+        final boxesPtr = _bindings.get_text_lines_boxes(batchPtr);
+        for (int i = 0; i < count; i++) {
+          offsets.add(offsetsPtr[i]);
+          widths.add(widthsPtr[i]);
+          boxes.add(Rect.fromLTWH(boxesPtr[i * 4], boxesPtr[i * 4 + 1],
+              boxesPtr[i * 4 + 2], boxesPtr[i * 4 + 3]));
+        }
+      }
+
+      return TextLineBatch(
+        success: true,
+        data: data,
+        lineHeight: _bindings.get_text_lines_height(batchPtr),
+        offsets: offsets,
+        widths: widths,
+        boxes: boxes,
       );
-    }).toList();
+    } finally {
+      malloc.free(dataPtr);
+      if (cornersPtr != nullptr) {
+        malloc.free(cornersPtr);
+      }
+      if (batchPtr != null && batchPtr != nullptr) {
+        _bindings.free_text_lines(batchPtr);
+      }
+    }
+  }
 
-    return FrameAnalysisResult(
+  /// Compute a 64-bit perceptual hash of a captured page
+  ///
+  /// Call at capture time, before enhancement, and check it with
+  /// [findDuplicatePage] to skip enhancement/OCR of re-captured pages.
+  ///
+  /// [corners] - Page corners (TL,TR,BR,BL), or null to hash the whole image
+  int computePageHash(
+    Uint8List imageData,
+    int width,
+    int height, {
+    List<double>? corners,
+    int format = 2,
+  }) {
+    if (!_isInitialized || _engine == null) {
+      return 0;
+    }
+
+    final dataPtr = malloc<Uint8>(imageData.length);
+    dataPtr.asTypedList(imageData.length).setAll(0, imageData);
+
+    Pointer<Float> cornersPtr = nullptr;
+    if (corners != null && corners.length == 8) {
+      cornersPtr = malloc<Float>(8);
+      for (int i = 0; i < 8; i++) {
+        cornersPtr[i] = corners[i];
+      }
+    }
+
+    try {
+      return _bindings.page_hash_compute(_engine!, dataPtr, width, height, format, cornersPtr);
+    } finally {
+      malloc.free(dataPtr);
+      if (cornersPtr != nullptr) {
+        malloc.free(cornersPtr);
+      }
+    }
+  }
+
+  /// Find a near-duplicate of [hash] among pages registered in this session
+  ///
+  /// Returns null if no page is within [maxDistance] bits (of 64).
+  DuplicatePageMatch? findDuplicatePage(int hash, {int maxDistance = 10}) {
+    if (!_isInitialized || _engine == null) {
+      return null;
+    }
+
+    final distancePtr = malloc<Int32>(1);
+    try {
+      final pageId = _bindings.page_index_find_duplicate(_engine!, hash, maxDistance, distancePtr);
+      if (pageId < 0) {
+        return null;
+      }
+      return DuplicatePageMatch(pageId: pageId, distance: distancePtr.value);
+    } finally {
+      malloc.free(distancePtr);
+    }
+  }
+
+  /// Register a page hash in the session index, returns its page id
+  int registerPage(int hash) {
+    if (!_isInitialized || _engine == null) {
+      return -1;
+    }
+    return _bindings.page_index_add(_engine!, hash);
+  }
+
+  /// Remove a page from the session index (e.g. user deleted the page)
+  bool removePage(int pageId) {
+    if (!_isInitialized || _engine == null) {
+      return false;
+    }
+    return _bindings.page_index_remove(_engine!, pageId) == 1;
+  }
+
+  /// Clear the session page index (start a new multi-page session)
+  void clearPages() {
+    if (_isInitialized && _engine != null) {
+      _bindings.page_index_clear(_engine!);
+    }
+  }
+
+  /// Start stitching a long receipt from multiple frames
+  ///
+  /// Pan top-to-bottom along the receipt and feed frames with
+  /// [addStitchFrame]. Output is [outputWidth] wide and at most [maxHeight]
+  /// rows; memory for the canvas is allocated once here.
+  bool beginStitching({int outputWidth = 800, int maxHeight = 8000}) {
+    if (!_isInitialized || _engine == null) {
+      return false;
+    }
+    return _bindings.stitch_begin(_engine!, outputWidth, maxHeight) == 1;
+  }
+
+  /// Add a frame to the stitching session
+  ///
+  /// [corners] - Receipt quad in the (rotated) frame, or null to track the
+  /// receipt edges automatically.
+  StitchStatus addStitchFrame(
+    Uint8List imageData,
+    int width,
+    int height, {
+    List<double>? corners,
+    int format = 0,
+    int rotation = 0,
+  }) {
+    if (!_isInitialized || _engine == null) {
+      return StitchStatus.error('Engine not initialized');
+    }
+
+    final dataPtr = malloc<Uint8>(imageData.length);
+    dataPtr.asTypedList(imageData.length).setAll(0, imageData);
+
+    Pointer<Float> cornersPtr = nullptr;
+    if (corners != null && corners.length == 8) {
+      cornersPtr = malloc<Float>(8);
+      for (int i = 0; i < 8; i++) {
+        cornersPtr[i] = corners[i];
+      }
+    }
+
+    Pointer<Char>? resultPtr;
+    try {
+      resultPtr = _bindings.stitch_add_frame(
+        _engine!,
+        dataPtr,
+        width,
+        height,
+        format,
+        rotation,
+        cornersPtr,
+      );
+
+      if (resultPtr == nullptr) {
+        return StitchStatus.error('Stitching failed');
+      }
+
+      final jsonStr = resultPtr.cast<Utf8>().toDartString();
+      return StitchStatus.fromJson(jsonDecode(jsonStr));
+    } finally {
+      malloc.free(dataPtr);
+      if (cornersPtr != nullptr) {
+        malloc.free(cornersPtr);
+      }
+      if (resultPtr != null && resultPtr != nullptr) {
+        _bindings.free_string(resultPtr);
+      }
+    }
+  }
+
+  /// Finish stitching and return the long receipt image (BGR)
+  EnhancementResult finishStitching() {
+    if (!_isInitialized || _engine == null) {
+      return EnhancementResult.error('Engine not initialized');
+    }
+
+    Pointer<Void>? resultPtr;
+    try {
+      resultPtr = _bindings.stitch_finish(_engine!);
+      return _readEnhancementResult(resultPtr);
+    } finally {
+      if (resultPtr != null && resultPtr != nullptr) {
+        _bindings.free_enhancement_result(resultPtr);
+      }
+    }
+  }
+
+  /// Cancel stitching and release the canvas
+  void cancelStitching() {
+    if (_isInitialized && _engine != null) {
+      _bindings.stitch_cancel(_engine!);
+    }
+  }
+
+  /// Native copy of the requested level sizes (at most 3 are used)
+  static Pointer<Int32> _allocLevelSizes(List<int> levelSizes) {
+    final levelsPtr = malloc<Int32>(levelSizes.isEmpty ? 1 : levelSizes.length);
+    for (int i = 0; i < levelSizes.length; i++) {
+      levelsPtr[i] = levelSizes[i];
+    }
+    return levelsPtr;
+  }
+
+  /// Copy the downscaled output levels of a native result
+  static List<EnhancementLevel> _readLevels(Pointer<Void> resultPtr, int channels) {
+    final count = _bindings.get_enhancement_level_count(resultPtr);
+    return [
+      for (int i = 0; i < count; i++)
+        EnhancementLevel(
+          imageData: Uint8List.fromList(_bindings
+              .get_enhancement_level_data(resultPtr, i)
+              .asTypedList(_bindings.get_enhancement_level_stride(resultPtr, i) *
+                  _bindings.get_enhancement_level_height(resultPtr, i))),
+          width: _bindings.get_enhancement_level_width(resultPtr, i),
+          height: _bindings.get_enhancement_level_height(resultPtr, i),
+          channels: channels,
+        ),
+    ];
+  }
+
+  /// Copy a native EnhancementResult into Dart memory
+  static EnhancementResult _readEnhancementResult(Pointer<Void> resultPtr) {
+    if (resultPtr == nullptr) {
+      return EnhancementResult.error('Enhancement failed');
+    }
+
+    final success = _bindings.get_enhancement_success(resultPtr) == 1;
+    if (!success) {
+      final errorPtr = _bindings.get_enhancement_error(resultPtr);
+      return EnhancementResult.error(errorPtr.cast<Utf8>().toDartString());
+    }
+
+    final resultWidth = _bindings.get_enhancement_width(resultPtr);
+    final resultHeight = _bindings.get_enhancement_height(resultPtr);
+    final channels = _bindings.get_enhancement_channels(resultPtr);
+    final imageDataPtr = _bindings.get_enhancement_image_data(resultPtr);
+
+    final dataSize = resultWidth * resultHeight * channels;
+    return EnhancementResult(
+      success: true,
+      imageData: Uint8List.fromList(imageDataPtr.asTypedList(dataSize)),
+      width: resultWidth,
+      height: resultHeight,
+      channels: channels,
+      levels: _readLevels(resultPtr, channels),
+    );
+  }
+
+  /// Remove glare by compositing several frames of the same page
+  ///
+  /// [frames] - Frames of equal size/format taken from different angles
+  /// [corners] - Document quad per frame (8 values: TL,TR,BR,BL)
+  /// Output size defaults to the first quad's size.
+  EnhancementResult removeGlare(
+    List<Uint8List> frames,
+    int width,
+    int height,
+    List<List<double>> corners, {
+    int format = 0,
+    int outputWidth = 0,
+    int outputHeight = 0,
+  }) {
+    if (!_isInitialized || _engine == null) {
+      return EnhancementResult.error('Engine not initialized');
+    }
+    if (frames.isEmpty || frames.length != corners.length) {
+      return EnhancementResult.error('Need one corner set per frame');
+    }
+
+    final count = frames.length;
+    final framePtrs = malloc<Pointer<Uint8>>(count);
+    final cornersPtr = malloc<Float>(count * 8);
+    for (int i = 0; i < count; i++) {
+      final dataPtr = malloc<Uint8>(frames[i].length);
+      dataPtr.asTypedList(frames[i].length).setAll(0, frames[i]);
+      framePtrs[i] = dataPtr;
+      for (int j = 0; j < 8; j++) {
+        cornersPtr[i * 8 + j] = corners[i][j];
+      }
+    }
+
+    Pointer<Void>? resultPtr;
+    try {
+      resultPtr = _bindings.remove_glare(
+        _engine!,
+        framePtrs,
+        count,
+        width,
+        height,
+        format,
+        cornersPtr,
+        outputWidth,
+        outputHeight,
+      );
+      return _readEnhancementResult(resultPtr);
+    } finally {
+      for (int i = 0; i < count; i++) {
+        malloc.free(framePtrs[i]);
+      }
+      malloc.free(framePtrs);
+      malloc.free(cornersPtr);
+      if (resultPtr != null && resultPtr != nullptr) {
+        _bindings.free_enhancement_result(resultPtr);
+      }
+    }
+  }
+
+  /// Measure latency and accuracy of every detector backend on [frames]
+  ///
+  /// [groundTruth] - Document quad per frame (8 values: TL,TR,BR,BL); when
+  /// null, accuracy is measured against the classical backend.
+  /// [iterations] - Timed runs per frame
+  List<DetectorBenchmarkResult> benchmarkDetectors(
+    List<Uint8List> frames,
+    int width,
+    int height, {
+    List<List<double>>? groundTruth,
+    int format = 0,
+    int iterations = 3,
+  }) {
+    if (!_isInitialized || _engine == null || frames.isEmpty) {
+      return [];
+    }
+    if (groundTruth != null && groundTruth.length != frames.length) {
+      return [];
+    }
+
+    final count = frames.length;
+    final framePtrs = malloc<Pointer<Uint8>>(count);
+    for (int i = 0; i < count; i++) {
+      final dataPtr = malloc<Uint8>(frames[i].length);
+      dataPtr.asTypedList(frames[i].length).setAll(0, frames[i]);
+      framePtrs[i] = dataPtr;
+    }
+
+    Pointer<Float> truthPtr = nullptr;
+    if (groundTruth != null) {
+      truthPtr = malloc<Float>(count * 8);
+      for (int i = 0; i < count; i++) {
+        for (int j = 0; j < 8; j++) {
+          truthPtr[i * 8 + j] = groundTruth[i][j];
+        }
+      }
+    }
+
+    Pointer<Char>? resultPtr;
+    try {
+      resultPtr = _bindings.benchmark_detectors(
+        _engine!,
+        framePtrs,
+        count,
+        width,
+        height,
+        format,
+        truthPtr,
+        iterations,
+      );
+
+      if (resultPtr == nullptr) {
+        return [];
+      }
+
+      final json = jsonDecode(resultPtr.cast<Utf8>().toDartString()) as Map<String, dynamic>;
+      final backends = json['backends'] as List? ?? [];
+      return backends
+          .map((b) => DetectorBenchmarkResult.fromJson(b as Map<String, dynamic>))
+          .toList();
+    } finally {
+      for (int i = 0; i < count; i++) {
+        malloc.free(framePtrs[i]);
+      }
+      malloc.free(framePtrs);
+      if (truthPtr != nullptr) {
+        malloc.free(truthPtr);
+      }
+      if (resultPtr != null && resultPtr != nullptr) {
+        _bindings.free_string(resultPtr);
+      }
+    }
+  }
+
+  /// Prepare edge snapping for the manual corner editor
+  ///
+  /// Computes gradient and corner maps for a captured image once, so that
+  /// [snapCorner] and [getMagnifierPatch] can be called per touch event.
+  ///
+  /// [format] - 0: BGRA, 1: BGR, 2: RGB
+  bool prepareCornerSnapping(
+    Uint8List imageData,
+    int width,
+    int height, {
+    int format = 2,
+  }) {
+    if (!_isInitialized || _engine == null) {
+      return false;
+    }
+
+    final dataPtr = malloc<Uint8>(imageData.length);
+    dataPtr.asTypedList(imageData.length).setAll(0, imageData);
+
+    try {
+      return _bindings.corner_snap_prepare(_engine!, dataPtr, width, height, format) == 1;
+    } finally {
+      malloc.free(dataPtr);
+    }
+  }
+
+  /// Find the nearest strong corner or edge to ([x], [y]) within [radius]
+  ///
+  /// Returns null if nothing strong enough is within [radius] (image pixels).
+  CornerSnapResult? snapCorner(
+    double x,
+    double y, {
+    double radius = 40,
+    SnapMode mode = SnapMode.auto,
+  }) {
+    if (!_isInitialized || _engine == null) {
+      return null;
+    }
+
+    final outPtr = malloc<Float>(4);
+    try {
+      final kind = _bindings.corner_snap_query(_engine!, x, y, radius, mode.index, outPtr);
+      if (kind == 0) {
+        return null;
+      }
+      return CornerSnapResult(
+        isCorner: kind == 1,
+        x: outPtr[0],
+        y: outPtr[1],
+        strength: outPtr[2],
+        distance: outPtr[3],
+      );
+    } finally {
+      malloc.free(outPtr);
+    }
+  }
+
+  /// Get a magnified patch around ([x], [y]) for the corner loupe
+  ///
+  /// Reads only the (2 * [radius])^2 source window and scales it to
+  /// [outputSize] x [outputSize] BGR pixels.
+  MagnifierPatch? getMagnifierPatch(
+    double x,
+    double y, {
+    int radius = 32,
+    int outputSize = 128,
+  }) {
+    if (!_isInitialized || _engine == null) {
+      return null;
+    }
+
+    final capacity = outputSize * outputSize * 3;
+    final outPtr = malloc<Uint8>(capacity);
+    try {
+      final channels = _bindings.corner_snap_get_patch(
+          _engine!, x, y, radius, outputSize, outPtr, capacity);
+      if (channels == 0) {
+        return null;
+      }
+      return MagnifierPatch(
+        imageData: Uint8List.fromList(outPtr.asTypedList(outputSize * outputSize * channels)),
+        size: outputSize,
+        channels: channels,
+      );
+    } finally {
+      malloc.free(outPtr);
+    }
+  }
+
+  /// Release cached snapping maps (call when the corner editor closes)
+  void releaseCornerSnapping() {
+    if (_isInitialized && _engine != null) {
+      _bindings.corner_snap_release(_engine!);
+    }
+  }
+
+  /// Dispose the engine and free resources
+  void dispose() {
+    if (_isInitialized && _engine != null) {
+      _bindings.capture_engine_destroy(_engine!);
+      _engine = null;
+      _isInitialized = false;
+    }
+  }
+}
+
+/// Pool of native engines for server-side batch processing.
+///
+/// Many sessions (e.g. concurrent uploads) share a bounded number of
+/// engines and a memory budget. Waiting jobs are served least-served
+/// session first, so one large batch can't starve the others.
+/// [processPhoto] blocks until the job may run, so call it from worker
+/// isolates; pass [address] and rebuild with [DocumentEnginePool.fromAddress].
+class DocumentEnginePool {
+  Pointer<Void>? _pool;
+  final bool _owned;
+
+  DocumentEnginePool({int maxEngines = 4, int memoryBudgetMb = 512})
+      : _pool = _bindings.engine_pool_create(maxEngines, memoryBudgetMb),
+        _owned = true;
+
+  /// Use a pool created in another isolate (does not take ownership)
+  DocumentEnginePool.fromAddress(int address)
+      : _pool = Pointer<Void>.fromAddress(address),
+        _owned = false;
+
+  int get address => _pool?.address ?? 0;
+
+  int openSession() {
+    if (_pool == null) return 0;
+    return _bindings.engine_pool_open_session(_pool!);
+  }
+
+  void closeSession(int sessionId) {
+    if (_pool != null) {
+      _bindings.engine_pool_close_session(_pool!, sessionId);
+    }
+  }
+
+  /// Detect the page and enhance the whole photo on a pooled engine.
+  /// Falls back to the full frame when no page is found.
+  EnhancementResult processPhoto(
+    int sessionId,
+    Uint8List imageData,
+    int width,
+    int height, {
+    int format = 1,
+    bool applySharpening = true,
+    double sharpeningStrength = 0.5,
+    EnhanceMode enhanceMode = EnhanceMode.auto,
+    int outputWidth = 0,
+    int outputHeight = 0,
+  }) {
+    if (_pool == null) {
+      return EnhancementResult.error('Pool disposed');
+    }
+
+    final dataPtr = malloc<Uint8>(imageData.length);
+    Pointer<Void>? resultPtr;
+    try {
+      dataPtr.asTypedList(imageData.length).setAll(0, imageData);
+      resultPtr = _bindings.engine_pool_process_photo(
+        _pool!,
+        sessionId,
+        dataPtr,
+        width,
+        height,
+        format,
+        applySharpening ? 1 : 0,
+        sharpeningStrength,
+        enhanceMode.index,
+        outputWidth,
+        outputHeight,
+      );
+      return DocumentCaptureEngine._readEnhancementResult(resultPtr);
+    } finally {
+      malloc.free(dataPtr);
+      if (resultPtr != null && resultPtr != nullptr) {
+        _bindings.free_enhancement_result(resultPtr);
+      }
+    }
+  }
+
+  PoolStats getStats() {
+    if (_pool == null) return PoolStats();
+
+    final resultPtr = _bindings.engine_pool_get_stats(_pool!);
+    try {
+      return PoolStats.fromJson(jsonDecode(resultPtr.cast<Utf8>().toDartString()));
+    } finally {
+      _bindings.free_string(resultPtr);
+    }
+  }
+
+  /// Destroy the pool (owner only; no jobs may be running)
+  void dispose() {
+    if (_pool != null && _owned) {
+      _bindings.engine_pool_destroy(_pool!);
+    }
+    _pool = null;
+  }
+}
+
+/// Engine pool occupancy
+class PoolStats {
+  final int engines;
+  final int busy;
+  final int sessions;
+  final int waiting;          // Jobs queued for an engine or memory
+  final int memoryInUse;      // Bytes (estimated) held by running jobs
+  final int memoryBudget;
+  final int jobsCompleted;
+  final int threads;          // OpenCV worker threads (process-wide)
+
+  PoolStats({
+    this.engines = 0,
+    this.busy = 0,
+    this.sessions = 0,
+    this.waiting = 0,
+    this.memoryInUse = 0,
+    this.memoryBudget = 0,
+    this.jobsCompleted = 0,
+    this.threads = 0,
+  });
+
+  factory PoolStats.fromJson(Map<String, dynamic> json) {
+    return PoolStats(
+      engines: json['engines'] ?? 0,
+      busy: json['busy'] ?? 0,
+      sessions: json['sessions'] ?? 0,
+      waiting: json['waiting'] ?? 0,
+      memoryInUse: json['memory_in_use'] ?? 0,
+      memoryBudget: json['memory_budget'] ?? 0,
+      jobsCompleted: json['jobs_completed'] ?? 0,
+      threads: json['threads'] ?? 0,
+    );
+  }
+}
+
+/// Disk-backed store of rectified pages for multi-page sessions.
+///
+/// Pages are appended to a memory-mapped file with an index (geometry,
+/// enhancement mode, source corners, thumbnail), so RAM use stays flat
+/// regardless of page count. Pass the store to
+/// [DocumentCaptureEngine.enhanceImage] to write pages without copying
+/// them through Dart, and [mapPage] them back zero-copy for export.
+class PageStore {
+  Pointer<Void>? _store;
+
+  PageStore() : _store = _bindings.page_store_create();
+
+  /// Open (or create) the store file. With [resume] the pages already in
+  /// the file are kept, e.g. to restore a session after the app was killed.
+  bool open(String path, {bool resume = false}) {
+    if (_store == null) return false;
+
+    final pathPtr = path.toNativeUtf8();
+    try {
+      return _bindings.page_store_open(_store!, pathPtr.cast<Char>(), resume ? 1 : 0) != 0;
+    } finally {
+      malloc.free(pathPtr);
+    }
+  }
+
+  int get pageCount => _store == null ? 0 : _bindings.page_store_count(_store!);
+
+  String get lastError {
+    if (_store == null) return 'Store disposed';
+
+    final errorPtr = _bindings.page_store_get_error(_store!);
+    try {
+      return errorPtr.cast<Utf8>().toDartString();
+    } finally {
+      _bindings.free_string(errorPtr);
+    }
+  }
+
+  int _appendResult(Pointer<Void> resultPtr, int enhanceMode, Pointer<Float> cornersPtr) {
+    if (_store == null) return -1;
+    return _bindings.page_store_append_result(_store!, resultPtr, enhanceMode, cornersPtr);
+  }
+
+  /// Append a page held in Dart (tightly packed rows). Returns the page
+  /// index, -1 on error (see [lastError]).
+  int addPage(
+    Uint8List imageData,
+    int width,
+    int height,
+    int channels, {
+    EnhanceMode enhanceMode = EnhanceMode.none,
+    List<double>? corners,
+  }) {
+    if (_store == null) return -1;
+
+    final dataPtr = malloc<Uint8>(imageData.length);
+    final cornersPtr = corners != null && corners.length == 8 ? malloc<Float>(8) : nullptr;
+    try {
+      dataPtr.asTypedList(imageData.length).setAll(0, imageData);
+      if (cornersPtr != nullptr) {
+        for (int i = 0; i < 8; i++) {
+          cornersPtr[i] = corners![i];
+        }
+      }
+      return _bindings.page_store_append_image(
+          _store!, dataPtr, width, height, channels, enhanceMode.index, cornersPtr);
+    } finally {
+      malloc.free(dataPtr);
+      if (cornersPtr != nullptr) {
+        malloc.free(cornersPtr);
+      }
+    }
+  }
+
+  /// Index of all stored pages
+  List<StoredPage> getPages() {
+    if (_store == null) return [];
+
+    final resultPtr = _bindings.page_store_get_index(_store!);
+    try {
+      final json = jsonDecode(resultPtr.cast<Utf8>().toDartString());
+      final pages = json['pages'] as List? ?? [];
+      return [
+        for (int i = 0; i < pages.length; i++) StoredPage.fromJson(i, pages[i]),
+      ];
+    } finally {
+      _bindings.free_string(resultPtr);
+    }
+  }
+
+  /// Map a page (or its thumbnail) without copying. The pixels stay valid
+  /// until [MappedPage.release], even after further appends or [close].
+  MappedPage? mapPage(int index, {bool thumbnail = false}) {
+    if (_store == null) return null;
+
+    final viewPtr = _bindings.page_store_map_page(_store!, index, thumbnail ? 1 : 0);
+    if (viewPtr == nullptr) return null;
+
+    final height = _bindings.page_view_height(viewPtr);
+    final stride = _bindings.page_view_stride(viewPtr);
+    return MappedPage._(
+      viewPtr,
+      _bindings.page_view_data(viewPtr).asTypedList(stride * height),
+      _bindings.page_view_width(viewPtr),
+      height,
+      _bindings.page_view_channels(viewPtr),
+      stride,
+    );
+  }
+
+  /// Flush written pages to disk
+  bool sync() => _store != null && _bindings.page_store_sync(_store!) != 0;
+
+  void close() {
+    if (_store != null) {
+      _bindings.page_store_close(_store!);
+    }
+  }
+
+  void dispose() {
+    if (_store != null) {
+      _bindings.page_store_destroy(_store!);
+      _store = null;
+    }
+  }
+}
+
+/// Index entry of a stored page
+class StoredPage {
+  final int index;
+  final int width;
+  final int height;
+  final int channels;
+  final EnhanceMode enhanceMode;
+  final List<double> corners;   // Source quad in the captured frame
+  final int thumbWidth;
+  final int thumbHeight;
+
+  StoredPage({
+    required this.index,
+    required this.width,
+    required this.height,
+    required this.channels,
+    required this.enhanceMode,
+    required this.corners,
+    required this.thumbWidth,
+    required this.thumbHeight,
+  });
+
+  factory StoredPage.fromJson(int index, Map<String, dynamic> json) {
+    final mode = json['enhance_mode'] ?? 0;
+    return StoredPage(
+      index: index,
+      width: json['width'] ?? 0,
+      height: json['height'] ?? 0,
+      channels: json['channels'] ?? 0,
+      enhanceMode: mode >= 0 && mode < EnhanceMode.values.length
+          ? EnhanceMode.values[mode]
+          : EnhanceMode.none,
+      corners: (json['corners'] as List?)?.map((e) => (e as num).toDouble()).toList() ?? [],
+      thumbWidth: json['thumb_width'] ?? 0,
+      thumbHeight: json['thumb_height'] ?? 0,
+    );
+  }
+}
+
+/// Zero-copy view of stored page pixels (rows are [stride] bytes apart)
+class MappedPage {
+  Pointer<Void>? _view;
+  final Uint8List data;
+  final int width;
+  final int height;
+  final int channels;
+  final int stride;
+
+  MappedPage._(this._view, this.data, this.width, this.height, this.channels, this.stride);
+
+  /// Unmap the pixels; [data] must not be used afterwards
+  void release() {
+    if (_view != null) {
+      _bindings.page_view_release(_view!);
+      _view = null;
+    }
+  }
+}
+
+/// Startup latency of an engine (warm-up frames excluded)
+class StartupStats {
+  final double constructMs;             // Native engine constructor
+  final double warmupMs;                // Last warmUp call (0 if never called)
+  final double createToFirstResultMs;   // Engine creation to first analyzeFrame result
+  final double firstAnalysisMs;         // Duration of the first analyzeFrame
+  final double steadyAnalysisMs;        // Running average of later frames
+  final int analyzedFrames;
+  final bool warmedUp;
+
+  StartupStats({
+    this.constructMs = 0,
+    this.warmupMs = 0,
+    this.createToFirstResultMs = 0,
+    this.firstAnalysisMs = 0,
+    this.steadyAnalysisMs = 0,
+    this.analyzedFrames = 0,
+    this.warmedUp = false,
+  });
+
+  factory StartupStats.fromJson(Map<String, dynamic> json) {
+    return StartupStats(
+      constructMs: (json['construct_ms'] as num?)?.toDouble() ?? 0.0,
+      warmupMs: (json['warmup_ms'] as num?)?.toDouble() ?? 0.0,
+      createToFirstResultMs: (json['create_to_first_result_ms'] as num?)?.toDouble() ?? 0.0,
+      firstAnalysisMs: (json['first_analysis_ms'] as num?)?.toDouble() ?? 0.0,
+      steadyAnalysisMs: (json['steady_analysis_ms'] as num?)?.toDouble() ?? 0.0,
+      analyzedFrames: json['analyzed_frames'] ?? 0,
+      warmedUp: json['warmed_up'] ?? false,
+    );
+  }
+}
+
+/// Represents a single text region bounds [x, y, width, height]
+class TextRegionBounds {
+  final double x;
+  final double y;
+  final double width;
+  final double height;
+
+  TextRegionBounds({
+    required this.x,
+    required this.y,
+    required this.width,
+    required this.height,
+  });
+
+  Rect toRect() => Rect.fromLTWH(x, y, width, height);
+}
+
+/// QR/barcode candidate region in frame coordinates
+///
+/// Only located, not decoded: crop this region from the full-resolution
+/// frame and hand it to a decoder.
+class CodeRegion {
+  final CodeType type;
+  final double x;
+  final double y;
+  final double width;
+  final double height;
+  final double score;  // 0.0 - 1.0
+
+  CodeRegion({
+    required this.type,
+    required this.x,
+    required this.y,
+    required this.width,
+    required this.height,
+    this.score = 0,
+  });
+
+  Rect toRect() => Rect.fromLTWH(x, y, width, height);
+}
+
+/// Result of frame analysis
+class FrameAnalysisResult {
+  final bool documentFound;
+  final bool tableFound;       // True if table detected (clear rectangular border)
+  final bool textRegionFound;  // True if text region detected (fallback)
+  final List<double> corners;
+  final double cornerConfidence;
+  final double documentAspect;  // True width/height of the page (perspective removed)
+  final DocumentType documentType;
+  final double documentTypeConfidence;
+  final double blurScore;
+  final BlurType blurType;
+  final double blurDirection;  // Motion direction in degrees [0,180), 0 = horizontal
+  final double blurStrength;   // 0-1
+  final double brightnessScore;
+  final double stabilityScore;
+  final double overallScore;
+  final bool captureReady;
+
+  // Finger/hand occlusion (bitmask: 1 top, 2 right, 4 bottom, 8 left)
+  final int occludedEdges;
+  final double occlusionScore;
+
+  final double moireScore;        // Photographed screen (enable removeMoire when high)
+
+  final List<CodeRegion> codes;   // QR/barcode candidates (see setBarcodeDetection)
+
+  // Framing guidance (document found only)
+  final FramingGuidance guidance;
+  final double fillRatio;         // Document area / frame area
+  final double targetFill;
+  final double centerOffsetX;     // -1..1
+  final double centerOffsetY;     // -1..1
+  final double tiltX;             // Degrees (top/bottom keystone)
+  final double tiltY;             // Degrees (left/right keystone)
+  final double rotationAngle;     // Degrees, in-plane
+  final double textPx;            // Estimated text height in frame pixels
+
+  // Camera control hints
+  final double focusX;            // 0-1, recommended focus/metering point
+  final double focusY;
+  final bool focusOnTile;         // Softest text tile rather than page center
+  final double exposureEv;        // Suggested exposure compensation
+
+  // Power saving: throttle the analysis loop to this rate
+  final int recommendedFps;
+  final RateState rateState;
+
+  final String? error;
+
+  // Table/Trapezoid data
+  final bool isTrapezoid;      // True if shape needs perspective correction
+  final double skewRatio;      // Overall skew ratio (max of vertical and horizontal)
+  final double topWidth;       // Width of top edge
+  final double bottomWidth;    // Width of bottom edge
+  final double leftHeight;     // Height of left edge
+  final double rightHeight;    // Height of right edge
+  final double verticalSkew;   // Vertical skew (front-back tilt)
+  final double horizontalSkew; // Horizontal skew (left-right offset)
+
+  // Multiple text regions data
+  final int textRegionCount;
+  final double coverageRatio;
+  final List<double> overallBounds;  // [x, y, width, height]
+  final List<TextRegionBounds> textRegions;  // Individual regions
+
+  // Continuous scan data
+  final ScanState scanState;
+  final bool scanTrigger;         // Capture now: a new page has settled
+  final double scanChangeScore;   // Difference from last captured page
+  final double scanMotionScore;   // Frame-to-frame content change
+
+  // IMU motion data
+  final bool imuActive;           // IMU samples are being pushed
+  final double imuMotionScore;    // Device motion (0 = still)
+  final bool analysisSkipped;     // Fast motion: geometry is from the last analyzed frame
+
+  FrameAnalysisResult({
+    required this.documentFound,
+    this.tableFound = false,
+    this.textRegionFound = false,
+    required this.corners,
+    required this.cornerConfidence,
+    this.documentAspect = 0,
+    this.documentType = DocumentType.unknown,
+    this.documentTypeConfidence = 0,
+    required this.blurScore,
+    this.blurType = BlurType.none,
+    this.blurDirection = 0,
+    this.blurStrength = 0,
+    required this.brightnessScore,
+    required this.stabilityScore,
+    required this.overallScore,
+    required this.captureReady,
+    this.occludedEdges = 0,
+    this.occlusionScore = 0,
+    this.moireScore = 0,
+    this.codes = const [],
+    this.guidance = FramingGuidance.none,
+    this.fillRatio = 0,
+    this.targetFill = 0,
+    this.centerOffsetX = 0,
+    this.centerOffsetY = 0,
+    this.tiltX = 0,
+    this.tiltY = 0,
+    this.rotationAngle = 0,
+    this.textPx = 0,
+    this.focusX = 0.5,
+    this.focusY = 0.5,
+    this.focusOnTile = false,
+    this.exposureEv = 0,
+    this.recommendedFps = 0,
+    this.rateState = RateState.active,
+    this.error,
+    this.isTrapezoid = false,
+    this.skewRatio = 0,
+    this.topWidth = 0,
+    this.bottomWidth = 0,
+    this.leftHeight = 0,
+    this.rightHeight = 0,
+    this.verticalSkew = 0,
+    this.horizontalSkew = 0,
+    this.textRegionCount = 0,
+    this.coverageRatio = 0,
+    this.overallBounds = const [],
+    this.textRegions = const [],
+    this.scanState = ScanState.off,
+    this.scanTrigger = false,
+    this.scanChangeScore = 0,
+    this.scanMotionScore = 0,
+    this.imuActive = false,
+    this.imuMotionScore = 0,
+    this.analysisSkipped = false,
+  });
+
+  /// Returns true if either table or text region was found
+  bool get hasRegion => tableFound || textRegionFound;
+
+  /// Get overall bounds as Rect (or null if not available)
+  Rect? get overallRect {
+    if (overallBounds.length == 4) {
+      return Rect.fromLTWH(overallBounds[0], overallBounds[1], overallBounds[2], overallBounds[3]);
+    }
+    return null;
+  }
+
+  /// True if a finger/hand covers any document edge
+  bool get isOccluded => occludedEdges != 0;
+
+  /// Focus/metering point as an Offset in 0-1 coordinates
+  /// (pass to CameraController.setFocusPoint / setExposurePoint)
+  Offset get focusPoint => Offset(focusX, focusY);
+
+  /// Get skew percentage for display
+  int get skewPercent => (skewRatio * 100).round();
+
+  factory FrameAnalysisResult.fromJson(Map<String, dynamic> json) {
+    // Parse text regions
+    final regionsData = json['text_regions'] as List? ?? [];
+    final textRegions = regionsData.map((r) {
+      final bounds = (r as List).map((e) => (e as num).toDouble()).toList();
+      return TextRegionBounds(
+        x: bounds.isNotEmpty ? bounds[0] : 0,
+        y: bounds.length > 1 ? bounds[1] : 0,
+        width: bounds.length > 2 ? bounds[2] : 0,
+        height: bounds.length > 3 ? bounds[3] : 0,
+      );
+    }).toList();
+
+    final codesData = json['codes'] as List? ?? [];
+    final codes = codesData.map((c) {
+      final code = c as Map<String, dynamic>;
+      final bounds = (code['bounds'] as List? ?? []).map((e) => (e as num).toDouble()).toList();
+      return CodeRegion(
+        type: CodeType.values[((code['type'] as int?) ?? 0).clamp(0, CodeType.values.length - 1)],
+        x: bounds.isNotEmpty ? bounds[0] : 0,
+        y: bounds.length > 1 ? bounds[1] : 0,
+        width: bounds.length > 2 ? bounds[2] : 0,
+        height: bounds.length > 3 ? bounds[3] : 0,
+        score: (code['score'] as num?)?.toDouble() ?? 0.0,
+      );
+    }).toList();
+
+    final centerOffset = json['center_offset'] as List?;
+    final tilt = json['tilt'] as List?;
+    final focusPoint = json['focus_point'] as List?;
+
+    return FrameAnalysisResult(
       documentFound: json['document_found'] ?? false,
       tableFound: json['table_found'] ?? false,
       textRegionFound: json['text_region_found'] ?? false,
       corners: (json['corners'] as List?)?.map((e) => (e as num).toDouble()).toList() ?? [],
       cornerConfidence: (json['corner_confidence'] as num?)?.toDouble() ?? 0.0,
+      documentAspect: (json['document_aspect'] as num?)?.toDouble() ?? 0.0,
+      documentType: DocumentType.values[((json['document_type'] as int?) ?? 0).clamp(0, DocumentType.values.length - 1)],
+      documentTypeConfidence: (json['document_type_confidence'] as num?)?.toDouble() ?? 0.0,
       blurScore: (json['blur_score'] as num?)?.toDouble() ?? 0.0,
+      blurType: BlurType.values[((json['blur_type'] as int?) ?? 0).clamp(0, BlurType.values.length - 1)],
+      blurDirection: (json['blur_direction'] as num?)?.toDouble() ?? 0.0,
+      blurStrength: (json['blur_strength'] as num?)?.toDouble() ?? 0.0,
       brightnessScore: (json['brightness_score'] as num?)?.toDouble() ?? 0.0,
       stabilityScore: (json['stability_score'] as num?)?.toDouble() ?? 0.0,
       overallScore: (json['overall_score'] as num?)?.toDouble() ?? 0.0,
       captureReady: json['capture_ready'] ?? false,
+      occludedEdges: json['occluded_edges'] ?? 0,
+      occlusionScore: (json['occlusion_score'] as num?)?.toDouble() ?? 0.0,
+      moireScore: (json['moire_score'] as num?)?.toDouble() ?? 0.0,
+      codes: codes,
+      guidance: FramingGuidance.values[((json['guidance'] as int?) ?? 0).clamp(0, FramingGuidance.values.length - 1)],
+      fillRatio: (json['fill_ratio'] as num?)?.toDouble() ?? 0.0,
+      targetFill: (json['target_fill'] as num?)?.toDouble() ?? 0.0,
+      centerOffsetX: (centerOffset != null && centerOffset.length == 2) ? (centerOffset[0] as num).toDouble() : 0.0,
+      centerOffsetY: (centerOffset != null && centerOffset.length == 2) ? (centerOffset[1] as num).toDouble() : 0.0,
+      tiltX: (tilt != null && tilt.length == 2) ? (tilt[0] as num).toDouble() : 0.0,
+      tiltY: (tilt != null && tilt.length == 2) ? (tilt[1] as num).toDouble() : 0.0,
+      rotationAngle: (json['rotation_angle'] as num?)?.toDouble() ?? 0.0,
+      textPx: (json['text_px'] as num?)?.toDouble() ?? 0.0,
+      focusX: (focusPoint != null && focusPoint.length == 2) ? (focusPoint[0] as num).toDouble() : 0.5,
+      focusY: (focusPoint != null && focusPoint.length == 2) ? (focusPoint[1] as num).toDouble() : 0.5,
+      focusOnTile: json['focus_on_tile'] ?? false,
+      exposureEv: (json['exposure_ev'] as num?)?.toDouble() ?? 0.0,
+      recommendedFps: json['recommended_fps'] ?? 0,
+      rateState: RateState.values[((json['rate_state'] as int?) ?? 0).clamp(0, RateState.values.length - 1)],
       error: json['error'],
       isTrapezoid: json['is_trapezoid'] ?? false,
       skewRatio: (json['skew_ratio'] as num?)?.toDouble() ?? 0.0,
@@ -447,6 +1839,13 @@ class FrameAnalysisResult {
       coverageRatio: (json['coverage_ratio'] as num?)?.toDouble() ?? 0.0,
       overallBounds: (json['overall_bounds'] as List?)?.map((e) => (e as num).toDouble()).toList() ?? [],
       textRegions: textRegions,
+      scanState: ScanState.values[((json['scan_state'] as int?) ?? 0).clamp(0, ScanState.values.length - 1)],
+      scanTrigger: json['scan_trigger'] ?? false,
+      scanChangeScore: (json['scan_change_score'] as num?)?.toDouble() ?? 0.0,
+      scanMotionScore: (json['scan_motion_score'] as num?)?.toDouble() ?? 0.0,
+      imuActive: json['imu_active'] ?? false,
+      imuMotionScore: (json['imu_motion_score'] as num?)?.toDouble() ?? 0.0,
+      analysisSkipped: json['analysis_skipped'] ?? false,
     );
   }
 
@@ -475,6 +1874,8 @@ class EnhancementResult {
   final int height;
   final int channels;
   final String? error;
+  final int pageIndex;  // Index in the PageStore the page was written to (-1 = not stored)
+  final List<EnhancementLevel> levels;  // Downscaled outputs, in levelSizes order
 
   EnhancementResult({
     required this.success,
@@ -483,6 +1884,8 @@ class EnhancementResult {
     this.height = 0,
     this.channels = 0,
     this.error,
+    this.pageIndex = -1,
+    this.levels = const [],
   });
 
   factory EnhancementResult.error(String message) {
@@ -493,6 +1896,305 @@ class EnhancementResult {
   }
 }
 
+/// Downscaled copy of an enhanced page (display image, thumbnail)
+class EnhancementLevel {
+  final Uint8List imageData;
+  final int width;
+  final int height;
+  final int channels;
+
+  EnhancementLevel({
+    required this.imageData,
+    required this.width,
+    required this.height,
+    required this.channels,
+  });
+}
+
+/// A single table cell in rectified page coordinates
+class TableCell {
+  final Rect bounds;
+  final int row;
+  final int col;
+  final int rowSpan;
+  final int colSpan;
+
+  TableCell({
+    required this.bounds,
+    required this.row,
+    required this.col,
+    this.rowSpan = 1,
+    this.colSpan = 1,
+  });
+}
+
+/// Result of table grid extraction
+class TableAnalysisResult {
+  final bool found;
+  final int rows;
+  final int cols;
+  final int pageWidth;
+  final int pageHeight;
+  final List<int> rowLines;  // Y of horizontal ruling lines
+  final List<int> colLines;  // X of vertical ruling lines
+  final List<TableCell> cells;
+  final String? error;
+
+  TableAnalysisResult({
+    required this.found,
+    this.rows = 0,
+    this.cols = 0,
+    this.pageWidth = 0,
+    this.pageHeight = 0,
+    this.rowLines = const [],
+    this.colLines = const [],
+    this.cells = const [],
+    this.error,
+  });
+
+  factory TableAnalysisResult.fromJson(Map<String, dynamic> json) {
+    final cellsData = json['cells'] as List? ?? [];
+    final cells = cellsData.map((c) {
+      final v = (c as List).map((e) => (e as num).toInt()).toList();
+      return TableCell(
+        bounds: Rect.fromLTWH(v[0].toDouble(), v[1].toDouble(), v[2].toDouble(), v[3].toDouble()),
+        row: v[4],
+        col: v[5],
+        rowSpan: v[6],
+        colSpan: v[7],
+      );
+    }).toList();
+
+    return TableAnalysisResult(
+      found: json['found'] ?? false,
+      rows: json['rows'] ?? 0,
+      cols: json['cols'] ?? 0,
+      pageWidth: json['page_width'] ?? 0,
+      pageHeight: json['page_height'] ?? 0,
+      rowLines: (json['row_lines'] as List?)?.map((e) => (e as num).toInt()).toList() ?? [],
+      colLines: (json['col_lines'] as List?)?.map((e) => (e as num).toInt()).toList() ?? [],
+      cells: cells,
+      error: json['error'],
+    );
+  }
+
+  factory TableAnalysisResult.error(String message) {
+    return TableAnalysisResult(found: false, error: message);
+  }
+}
+
+/// Text-line crops packed in one gray buffer
+///
+/// Line i is [lineHeight] rows of [widths][i] bytes starting at [offsets][i].
+class TextLineBatch {
+  final bool success;
+  final Uint8List data;
+  final int lineHeight;
+  final List<int> offsets;
+  final List<int> widths;
+  final List<Rect> boxes;  // Line boxes in rectified page coordinates
+  final String? error;
+
+  TextLineBatch({
+    required this.success,
+    required this.data,
+    this.lineHeight = 0,
+    this.offsets = const [],
+    this.widths = const [],
+    this.boxes = const [],
+    this.error,
+  });
+
+  int get count => offsets.length;
+
+  /// Gray pixels of line [index] (view into [data], no copy)
+  Uint8List lineAt(int index) {
+    final start = offsets[index];
+    return Uint8List.sublistView(data, start, start + widths[index] * lineHeight);
+  }
+
+  factory TextLineBatch.error(String message) {
+    return TextLineBatch(success: false, data: Uint8List(0), error: message);
+  }
+}
+
+/// Near-duplicate page found in the session index
+class DuplicatePageMatch {
+  final int pageId;
+  final int distance;  // Hamming distance in bits (0 = identical hash)
+
+  DuplicatePageMatch({required this.pageId, required this.distance});
+}
+
+/// Status of one frame added to a stitching session
+class StitchStatus {
+  final StitchFrameStatus status;
+  final double shift;        // Registered shift vs last keyframe (output pixels)
+  final double response;     // Registration confidence (0-1)
+  final int stitchedHeight;  // Rows stitched so far
+  final String? error;
+
+  StitchStatus({
+    required this.status,
+    this.shift = 0,
+    this.response = 0,
+    this.stitchedHeight = 0,
+    this.error,
+  });
+
+  factory StitchStatus.fromJson(Map<String, dynamic> json) {
+    final index = (json['status'] as int?) ?? 0;
+    return StitchStatus(
+      status: StitchFrameStatus.values[index.clamp(0, StitchFrameStatus.values.length - 1)],
+      shift: (json['shift'] as num?)?.toDouble() ?? 0.0,
+      response: (json['response'] as num?)?.toDouble() ?? 0.0,
+      stitchedHeight: json['stitched_height'] ?? 0,
+      error: json['error'],
+    );
+  }
+
+  factory StitchStatus.error(String message) {
+    return StitchStatus(status: StitchFrameStatus.inactive, error: message);
+  }
+}
+
+/// Latency and accuracy of one detector backend
+class DetectorBenchmarkResult {
+  final DetectorBackend backend;
+  final bool available;       // False if the backend can't run (e.g. no model loaded)
+  final int frames;
+  final double meanMs;
+  final double p95Ms;
+  final double foundRate;     // Fraction of frames with a document
+  final double cornerError;   // Mean corner distance / frame diagonal vs reference
+  final double agreement;     // Fraction of frames matching the reference
+
+  DetectorBenchmarkResult({
+    required this.backend,
+    required this.available,
+    this.frames = 0,
+    this.meanMs = 0,
+    this.p95Ms = 0,
+    this.foundRate = 0,
+    this.cornerError = 0,
+    this.agreement = 0,
+  });
+
+  factory DetectorBenchmarkResult.fromJson(Map<String, dynamic> json) {
+    final index = (json['backend'] as int?) ?? 0;
+    return DetectorBenchmarkResult(
+      backend: DetectorBackend.values[index.clamp(0, DetectorBackend.values.length - 1)],
+      available: json['available'] ?? false,
+      frames: json['frames'] ?? 0,
+      meanMs: (json['mean_ms'] as num?)?.toDouble() ?? 0.0,
+      p95Ms: (json['p95_ms'] as num?)?.toDouble() ?? 0.0,
+      foundRate: (json['found_rate'] as num?)?.toDouble() ?? 0.0,
+      cornerError: (json['corner_error'] as num?)?.toDouble() ?? 0.0,
+      agreement: (json['agreement'] as num?)?.toDouble() ?? 0.0,
+    );
+  }
+}
+
+/// Result of a corner snap query
+class CornerSnapResult {
+  final bool isCorner;   // True if snapped to a corner, false if to an edge
+  final double x;
+  final double y;
+  final double strength; // 0.0 - 1.0
+  final double distance; // Distance from query point (pixels)
+
+  CornerSnapResult({
+    required this.isCorner,
+    required this.x,
+    required this.y,
+    required this.strength,
+    required this.distance,
+  });
+
+  Offset toOffset() => Offset(x, y);
+}
+
+/// Magnified image patch around a corner (BGR)
+class MagnifierPatch {
+  final Uint8List imageData;
+  final int size;
+  final int channels;
+
+  MagnifierPatch({
+    required this.imageData,
+    required this.size,
+    required this.channels,
+  });
+}
+
+/// SIMD kernel variant check (see [cpuKernelSelfTest])
+class KernelVariantCheck {
+  final String name;     // scalar, sse4.1, avx2, neon, neon+dotprod
+  final bool passed;     // Bit-exact with the scalar kernels
+  final int mismatches;
+
+  KernelVariantCheck({required this.name, required this.passed, this.mismatches = 0});
+}
+
+/// CPU features and the kernel variant selected for this device
+class CpuKernelReport {
+  final bool sse41;
+  final bool avx2;
+  final bool neon;
+  final bool dotprod;
+  final String activeVariant;
+  final List<KernelVariantCheck> variants;
+
+  CpuKernelReport({
+    this.sse41 = false,
+    this.avx2 = false,
+    this.neon = false,
+    this.dotprod = false,
+    this.activeVariant = 'scalar',
+    this.variants = const [],
+  });
+
+  bool get allPassed => variants.every((v) => v.passed);
+
+  factory CpuKernelReport.fromJson(Map<String, dynamic> json) {
+    final features = json['features'] as Map<String, dynamic>? ?? {};
+    final variants = (json['variants'] as List? ?? []).map((v) {
+      final variant = v as Map<String, dynamic>;
+      return KernelVariantCheck(
+        name: variant['name'] ?? '',
+        passed: variant['passed'] ?? false,
+        mismatches: variant['mismatches'] ?? 0,
+      );
+    }).toList();
+
+    return CpuKernelReport(
+      sse41: features['sse41'] ?? false,
+      avx2: features['avx2'] ?? false,
+      neon: features['neon'] ?? false,
+      dotprod: features['dotprod'] ?? false,
+      activeVariant: json['active'] ?? 'scalar',
+      variants: variants,
+    );
+  }
+}
+
+/// Detect CPU features and compare every SIMD kernel variant runnable on
+/// this device bit-for-bit against the scalar reference
+CpuKernelReport cpuKernelSelfTest() {
+  final resultPtr = _bindings.cpu_kernel_self_test();
+  try {
+    return CpuKernelReport.fromJson(jsonDecode(resultPtr.cast<Utf8>().toDartString()));
+  } finally {
+    _bindings.free_string(resultPtr);
+  }
+}
+
+/// Cap OpenCV worker threads for the whole process (0 = library default).
+/// Useful when several pooled engines already run in parallel.
+void configureThreads(int threads) {
+  _bindings.configure_threads(threads);
+}
+
 /// Get library version
 String getVersion() {
   final versionPtr = _bindings.get_version();
@@ -35,6 +35,52 @@ class DocumentCaptureBindings {
   late final _capture_engine_destroy = _capture_engine_destroyPtr
       .asFunction<void Function(ffi.Pointer<ffi.Void>)>();
 
+  /// Prime the engine for a stream size/format (returns ms, -1 on error)
+  double capture_engine_warm_up(
+    ffi.Pointer<ffi.Void> engine,
+    int width,
+    int height,
+    int format,
+    int rotation,
+  ) {
+    return _capture_engine_warm_up(
+      engine,
+      width,
+      height,
+      format,
+      rotation,
+    );
+  }
+
+  late final _capture_engine_warm_upPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Float Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+          )>>('capture_engine_warm_up');
+  late final _capture_engine_warm_up = _capture_engine_warm_upPtr.asFunction<
+      double Function(
+        ffi.Pointer<ffi.Void>,
+        int,
+        int,
+        int,
+        int,
+      )>();
+
+  /// Get startup latency stats (JSON)
+  ffi.Pointer<ffi.Char> capture_engine_get_startup_stats(ffi.Pointer<ffi.Void> engine) {
+    return _capture_engine_get_startup_stats(engine);
+  }
+
+  late final _capture_engine_get_startup_statsPtr =
+      _lookup<ffi.NativeFunction<ffi.Pointer<ffi.Char> Function(ffi.Pointer<ffi.Void>)>>(
+          'capture_engine_get_startup_stats');
+  late final _capture_engine_get_startup_stats = _capture_engine_get_startup_statsPtr
+      .asFunction<ffi.Pointer<ffi.Char> Function(ffi.Pointer<ffi.Void>)>();
+
   /// Reset engine state
   void capture_engine_reset(ffi.Pointer<ffi.Void> engine) {
     return _capture_engine_reset(engine);
@@ -46,6 +92,162 @@ class DocumentCaptureBindings {
   late final _capture_engine_reset = _capture_engine_resetPtr
       .asFunction<void Function(ffi.Pointer<ffi.Void>)>();
 
+  /// Enable/disable continuous scan mode
+  void capture_engine_set_continuous_scan(
+    ffi.Pointer<ffi.Void> engine,
+    int enabled,
+  ) {
+    return _capture_engine_set_continuous_scan(engine, enabled);
+  }
+
+  late final _capture_engine_set_continuous_scanPtr = _lookup<
+          ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Int32)>>(
+      'capture_engine_set_continuous_scan');
+  late final _capture_engine_set_continuous_scan = _capture_engine_set_continuous_scanPtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>, int)>();
+
+  /// Load a detector network for the DNN backend (1 on success)
+  int capture_engine_load_detector_model(
+    ffi.Pointer<ffi.Void> engine,
+    ffi.Pointer<ffi.Char> model_path,
+    int input_size,
+  ) {
+    return _capture_engine_load_detector_model(
+      engine,
+      model_path,
+      input_size,
+    );
+  }
+
+  late final _capture_engine_load_detector_modelPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<ffi.Char>,
+            ffi.Int32,
+          )>>('capture_engine_load_detector_model');
+  late final _capture_engine_load_detector_model = _capture_engine_load_detector_modelPtr.asFunction<
+      int Function(
+        ffi.Pointer<ffi.Void>,
+        ffi.Pointer<ffi.Char>,
+        int,
+      )>();
+
+  /// Set the detector backend (0 classical, 1 DNN); 1 if active
+  int capture_engine_set_detector_backend(
+    ffi.Pointer<ffi.Void> engine,
+    int backend,
+  ) {
+    return _capture_engine_set_detector_backend(
+      engine,
+      backend,
+    );
+  }
+
+  late final _capture_engine_set_detector_backendPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Int32,
+          )>>('capture_engine_set_detector_backend');
+  late final _capture_engine_set_detector_backend = _capture_engine_set_detector_backendPtr.asFunction<
+      int Function(
+        ffi.Pointer<ffi.Void>,
+        int,
+      )>();
+
+  /// Set the document profile (known aspect ratio)
+  void capture_engine_set_document_profile(
+    ffi.Pointer<ffi.Void> engine,
+    int profile,
+    double custom_aspect,
+  ) {
+    return _capture_engine_set_document_profile(engine, profile, custom_aspect);
+  }
+
+  late final _capture_engine_set_document_profilePtr = _lookup<
+          ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Int32, ffi.Float)>>(
+      'capture_engine_set_document_profile');
+  late final _capture_engine_set_document_profile = _capture_engine_set_document_profilePtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>, int, double)>();
+
+  /// Set bounds for the recommended analysis rate
+  void capture_engine_set_frame_rate_limits(
+    ffi.Pointer<ffi.Void> engine,
+    int min_fps,
+    int max_fps,
+  ) {
+    return _capture_engine_set_frame_rate_limits(engine, min_fps, max_fps);
+  }
+
+  late final _capture_engine_set_frame_rate_limitsPtr = _lookup<
+          ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Int32, ffi.Int32)>>(
+      'capture_engine_set_frame_rate_limits');
+  late final _capture_engine_set_frame_rate_limits = _capture_engine_set_frame_rate_limitsPtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>, int, int)>();
+
+  /// Set framing guidance targets
+  void capture_engine_set_framing_target(
+    ffi.Pointer<ffi.Void> engine,
+    double target_fill,
+    double min_text_px,
+  ) {
+    return _capture_engine_set_framing_target(engine, target_fill, min_text_px);
+  }
+
+  late final _capture_engine_set_framing_targetPtr = _lookup<
+          ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Float, ffi.Float)>>(
+      'capture_engine_set_framing_target');
+  late final _capture_engine_set_framing_target = _capture_engine_set_framing_targetPtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>, double, double)>();
+
+  /// Enable/disable QR/barcode region detection in analyze_frame
+  void capture_engine_set_barcode_detection(
+    ffi.Pointer<ffi.Void> engine,
+    int enabled,
+  ) {
+    return _capture_engine_set_barcode_detection(engine, enabled);
+  }
+
+  late final _capture_engine_set_barcode_detectionPtr = _lookup<
+          ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Int32)>>(
+      'capture_engine_set_barcode_detection');
+  late final _capture_engine_set_barcode_detection = _capture_engine_set_barcode_detectionPtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>, int)>();
+
+  /// Enable/disable the occlusion veto on capture_ready
+  void capture_engine_set_occlusion_veto(
+    ffi.Pointer<ffi.Void> engine,
+    int enabled,
+  ) {
+    return _capture_engine_set_occlusion_veto(engine, enabled);
+  }
+
+  late final _capture_engine_set_occlusion_vetoPtr = _lookup<
+          ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Int32)>>(
+      'capture_engine_set_occlusion_veto');
+  late final _capture_engine_set_occlusion_veto = _capture_engine_set_occlusion_vetoPtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>, int)>();
+
+  /// Push a gyroscope (type 0) or accelerometer (type 1) sample
+  void capture_engine_push_imu_sample(
+    ffi.Pointer<ffi.Void> engine,
+    int type,
+    double x,
+    double y,
+    double z,
+    int timestamp_ns,
+  ) {
+    return _capture_engine_push_imu_sample(engine, type, x, y, z, timestamp_ns);
+  }
+
+  late final _capture_engine_push_imu_samplePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Int32, ffi.Float,
+              ffi.Float, ffi.Float, ffi.Int64)>>('capture_engine_push_imu_sample');
+  late final _capture_engine_push_imu_sample = _capture_engine_push_imu_samplePtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>, int, double, double, double, int)>();
+
   /// Analyze a single frame
   ffi.Pointer<ffi.Char> analyze_frame(
     ffi.Pointer<ffi.Void> engine,
@@ -107,6 +309,9 @@ class DocumentCaptureBindings {
     int enhance_mode,
     int output_width,
     int output_height,
+    int apply_moire_removal,
+    ffi.Pointer<ffi.Int32> level_sizes,
+    int level_count,
   ) {
     return _enhance_image(
       engine,
@@ -123,6 +328,9 @@ class DocumentCaptureBindings {
       enhance_mode,
       output_width,
       output_height,
+      apply_moire_removal,
+      level_sizes,
+      level_count,
     );
   }
 
@@ -143,6 +351,9 @@ class DocumentCaptureBindings {
             ffi.Int32,
             ffi.Int32,
             ffi.Int32,
+            ffi.Int32,
+            ffi.Pointer<ffi.Int32>,
+            ffi.Int32,
           )>>('enhance_image');
   late final _enhance_image = _enhance_imagePtr.asFunction<
       ffi.Pointer<ffi.Void> Function(
@@ -160,6 +371,9 @@ class DocumentCaptureBindings {
         int,
         int,
         int,
+        int,
+        ffi.Pointer<ffi.Int32>,
+        int,
       )>();
 
   /// Enhance image with guide frame (auto-calculate virtual trapezoid)
@@ -177,6 +391,8 @@ class DocumentCaptureBindings {
     double sharpening_strength,
     int enhance_mode,
     int rotation,
+    ffi.Pointer<ffi.Int32> level_sizes,
+    int level_count,
   ) {
     return _enhance_image_with_guide_frame(
       engine,
@@ -192,6 +408,8 @@ class DocumentCaptureBindings {
       sharpening_strength,
       enhance_mode,
       rotation,
+      level_sizes,
+      level_count,
     );
   }
 
@@ -211,6 +429,8 @@ class DocumentCaptureBindings {
             ffi.Float,
             ffi.Int32,
             ffi.Int32,
+            ffi.Pointer<ffi.Int32>,
+            ffi.Int32,
           )>>('enhance_image_with_guide_frame');
   late final _enhance_image_with_guide_frame = _enhance_image_with_guide_framePtr.asFunction<
       ffi.Pointer<ffi.Void> Function(
@@ -227,6 +447,8 @@ class DocumentCaptureBindings {
         double,
         int,
         int,
+        ffi.Pointer<ffi.Int32>,
+        int,
       )>();
 
   /// Get enhancement success status
@@ -296,6 +518,109 @@ class DocumentCaptureBindings {
   late final _get_enhancement_stride = _get_enhancement_stridePtr
       .asFunction<int Function(ffi.Pointer<ffi.Void>)>();
 
+  /// Get number of downscaled output levels
+  int get_enhancement_level_count(ffi.Pointer<ffi.Void> result) {
+    return _get_enhancement_level_count(result);
+  }
+
+  late final _get_enhancement_level_countPtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<ffi.Void>)>>(
+          'get_enhancement_level_count');
+  late final _get_enhancement_level_count = _get_enhancement_level_countPtr
+      .asFunction<int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Get downscaled level image data
+  ffi.Pointer<ffi.Uint8> get_enhancement_level_data(
+    ffi.Pointer<ffi.Void> result,
+    int level,
+  ) {
+    return _get_enhancement_level_data(
+      result,
+      level,
+    );
+  }
+
+  late final _get_enhancement_level_dataPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Uint8> Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Int32,
+          )>>('get_enhancement_level_data');
+  late final _get_enhancement_level_data = _get_enhancement_level_dataPtr.asFunction<
+      ffi.Pointer<ffi.Uint8> Function(
+        ffi.Pointer<ffi.Void>,
+        int,
+      )>();
+
+  /// Get downscaled level width
+  int get_enhancement_level_width(
+    ffi.Pointer<ffi.Void> result,
+    int level,
+  ) {
+    return _get_enhancement_level_width(
+      result,
+      level,
+    );
+  }
+
+  late final _get_enhancement_level_widthPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Int32,
+          )>>('get_enhancement_level_width');
+  late final _get_enhancement_level_width = _get_enhancement_level_widthPtr.asFunction<
+      int Function(
+        ffi.Pointer<ffi.Void>,
+        int,
+      )>();
+
+  /// Get downscaled level height
+  int get_enhancement_level_height(
+    ffi.Pointer<ffi.Void> result,
+    int level,
+  ) {
+    return _get_enhancement_level_height(
+      result,
+      level,
+    );
+  }
+
+  late final _get_enhancement_level_heightPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Int32,
+          )>>('get_enhancement_level_height');
+  late final _get_enhancement_level_height = _get_enhancement_level_heightPtr.asFunction<
+      int Function(
+        ffi.Pointer<ffi.Void>,
+        int,
+      )>();
+
+  /// Get downscaled level row stride
+  int get_enhancement_level_stride(
+    ffi.Pointer<ffi.Void> result,
+    int level,
+  ) {
+    return _get_enhancement_level_stride(
+      result,
+      level,
+    );
+  }
+
+  late final _get_enhancement_level_stridePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Int32,
+          )>>('get_enhancement_level_stride');
+  late final _get_enhancement_level_stride = _get_enhancement_level_stridePtr.asFunction<
+      int Function(
+        ffi.Pointer<ffi.Void>,
+        int,
+      )>();
+
   /// Get enhancement error message
   ffi.Pointer<ffi.Char> get_enhancement_error(ffi.Pointer<ffi.Void> result) {
     return _get_enhancement_error(result);
@@ -319,6 +644,1074 @@ class DocumentCaptureBindings {
   late final _free_enhancement_result = _free_enhancement_resultPtr
       .asFunction<void Function(ffi.Pointer<ffi.Void>)>();
 
+  /// Prepare corner snapping maps for a captured image
+  int corner_snap_prepare(
+    ffi.Pointer<ffi.Void> engine,
+    ffi.Pointer<ffi.Uint8> image_data,
+    int width,
+    int height,
+    int format,
+  ) {
+    return _corner_snap_prepare(
+      engine,
+      image_data,
+      width,
+      height,
+      format,
+    );
+  }
+
+  late final _corner_snap_preparePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<ffi.Uint8>,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+          )>>('corner_snap_prepare');
+  late final _corner_snap_prepare = _corner_snap_preparePtr.asFunction<
+      int Function(
+        ffi.Pointer<ffi.Void>,
+        ffi.Pointer<ffi.Uint8>,
+        int,
+        int,
+        int,
+      )>();
+
+  /// Find nearest strong corner/edge to a point
+  int corner_snap_query(
+    ffi.Pointer<ffi.Void> engine,
+    double x,
+    double y,
+    double radius,
+    int mode,
+    ffi.Pointer<ffi.Float> out_result,
+  ) {
+    return _corner_snap_query(
+      engine,
+      x,
+      y,
+      radius,
+      mode,
+      out_result,
+    );
+  }
+
+  late final _corner_snap_queryPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Float,
+            ffi.Float,
+            ffi.Float,
+            ffi.Int32,
+            ffi.Pointer<ffi.Float>,
+          )>>('corner_snap_query');
+  late final _corner_snap_query = _corner_snap_queryPtr.asFunction<
+      int Function(
+        ffi.Pointer<ffi.Void>,
+        double,
+        double,
+        double,
+        int,
+        ffi.Pointer<ffi.Float>,
+      )>();
+
+  /// Copy magnifier patch around a point
+  int corner_snap_get_patch(
+    ffi.Pointer<ffi.Void> engine,
+    double x,
+    double y,
+    int radius,
+    int out_size,
+    ffi.Pointer<ffi.Uint8> out_buffer,
+    int out_capacity,
+  ) {
+    return _corner_snap_get_patch(
+      engine,
+      x,
+      y,
+      radius,
+      out_size,
+      out_buffer,
+      out_capacity,
+    );
+  }
+
+  late final _corner_snap_get_patchPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Float,
+            ffi.Float,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Pointer<ffi.Uint8>,
+            ffi.Int32,
+          )>>('corner_snap_get_patch');
+  late final _corner_snap_get_patch = _corner_snap_get_patchPtr.asFunction<
+      int Function(
+        ffi.Pointer<ffi.Void>,
+        double,
+        double,
+        int,
+        int,
+        ffi.Pointer<ffi.Uint8>,
+        int,
+      )>();
+
+  /// Release cached corner snapping maps
+  void corner_snap_release(ffi.Pointer<ffi.Void> engine) {
+    return _corner_snap_release(engine);
+  }
+
+  late final _corner_snap_releasePtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>(
+          'corner_snap_release');
+  late final _corner_snap_release = _corner_snap_releasePtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Extract table grid from a rectified page
+  ffi.Pointer<ffi.Char> analyze_table(
+    ffi.Pointer<ffi.Void> engine,
+    ffi.Pointer<ffi.Uint8> image_data,
+    int width,
+    int height,
+    int format,
+    ffi.Pointer<ffi.Float> corners,
+  ) {
+    return _analyze_table(
+      engine,
+      image_data,
+      width,
+      height,
+      format,
+      corners,
+    );
+  }
+
+  late final _analyze_tablePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Char> Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<ffi.Uint8>,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Pointer<ffi.Float>,
+          )>>('analyze_table');
+  late final _analyze_table = _analyze_tablePtr.asFunction<
+      ffi.Pointer<ffi.Char> Function(
+        ffi.Pointer<ffi.Void>,
+        ffi.Pointer<ffi.Uint8>,
+        int,
+        int,
+        int,
+        ffi.Pointer<ffi.Float>,
+      )>();
+
+  /// Export OCR-ready text-line crops packed into one buffer
+  ffi.Pointer<ffi.Void> extract_text_lines(
+    ffi.Pointer<ffi.Void> engine,
+    ffi.Pointer<ffi.Uint8> image_data,
+    int width,
+    int height,
+    int format,
+    ffi.Pointer<ffi.Float> corners,
+    int line_height,
+  ) {
+    return _extract_text_lines(
+      engine,
+      image_data,
+      width,
+      height,
+      format,
+      corners,
+      line_height,
+    );
+  }
+
+  late final _extract_text_linesPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<ffi.Uint8>,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Pointer<ffi.Float>,
+            ffi.Int32,
+          )>>('extract_text_lines');
+  late final _extract_text_lines = _extract_text_linesPtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(
+        ffi.Pointer<ffi.Void>,
+        ffi.Pointer<ffi.Uint8>,
+        int,
+        int,
+        int,
+        ffi.Pointer<ffi.Float>,
+        int,
+      )>();
+
+  /// Get text-line batch success status
+  int get_text_lines_success(ffi.Pointer<ffi.Void> batch) {
+    return _get_text_lines_success(batch);
+  }
+
+  late final _get_text_lines_successPtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<ffi.Void>)>>(
+          'get_text_lines_success');
+  late final _get_text_lines_success = _get_text_lines_successPtr
+      .asFunction<int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Get number of text lines
+  int get_text_lines_count(ffi.Pointer<ffi.Void> batch) {
+    return _get_text_lines_count(batch);
+  }
+
+  late final _get_text_lines_countPtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<ffi.Void>)>>(
+          'get_text_lines_count');
+  late final _get_text_lines_count = _get_text_lines_countPtr
+      .asFunction<int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Get normalized line height
+  int get_text_lines_height(ffi.Pointer<ffi.Void> batch) {
+    return _get_text_lines_height(batch);
+  }
+
+  late final _get_text_lines_heightPtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<ffi.Void>)>>(
+          'get_text_lines_height');
+  late final _get_text_lines_height = _get_text_lines_heightPtr
+      .asFunction<int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Get packed line pixel buffer
+  ffi.Pointer<ffi.Uint8> get_text_lines_data(ffi.Pointer<ffi.Void> batch) {
+    return _get_text_lines_data(batch);
+  }
+
+  late final _get_text_lines_dataPtr =
+      _lookup<ffi.NativeFunction<ffi.Pointer<ffi.Uint8> Function(ffi.Pointer<ffi.Void>)>>(
+          'get_text_lines_data');
+  late final _get_text_lines_data = _get_text_lines_dataPtr
+      .asFunction<ffi.Pointer<ffi.Uint8> Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Get packed buffer size in bytes
+  int get_text_lines_data_size(ffi.Pointer<ffi.Void> batch) {
+    return _get_text_lines_data_size(batch);
+  }
+
+  late final _get_text_lines_data_sizePtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<ffi.Void>)>>(
+          'get_text_lines_data_size');
+  late final _get_text_lines_data_size = _get_text_lines_data_sizePtr
+      .asFunction<int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Get byte offset of each line
+  ffi.Pointer<ffi.Int32> get_text_lines_offsets(ffi.Pointer<ffi.Void> batch) {
+    return _get_text_lines_offsets(batch);
+  }
+
+  late final _get_text_lines_offsetsPtr =
+      _lookup<ffi.NativeFunction<ffi.Pointer<ffi.Int32> Function(ffi.Pointer<ffi.Void>)>>(
+          'get_text_lines_offsets');
+  late final _get_text_lines_offsets = _get_text_lines_offsetsPtr
+      .asFunction<ffi.Pointer<ffi.Int32> Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Get width of each line
+  ffi.Pointer<ffi.Int32> get_text_lines_widths(ffi.Pointer<ffi.Void> batch) {
+    return _get_text_lines_widths(batch);
+  }
+
+  late final _get_text_lines_widthsPtr =
+      _lookup<ffi.NativeFunction<ffi.Pointer<ffi.Int32> Function(ffi.Pointer<ffi.Void>)>>(
+          'get_text_lines_widths');
+  late final _get_text_lines_widths = _get_text_lines_widthsPtr
+      .asFunction<ffi.Pointer<ffi.Int32> Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Get page-space box of each line
+  ffi.Pointer<ffi.Float> get_text_lines_boxes(ffi.Pointer<ffi.Void> batch) {
+    return _get_text_lines_boxes(batch);
+  }
+
+  late final _get_text_lines_boxesPtr =
+      _lookup<ffi.NativeFunction<ffi.Pointer<ffi.Float> Function(ffi.Pointer<ffi.Void>)>>(
+          'get_text_lines_boxes');
+  late final _get_text_lines_boxes = _get_text_lines_boxesPtr
+      .asFunction<ffi.Pointer<ffi.Float> Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Get text-line batch error message
+  ffi.Pointer<ffi.Char> get_text_lines_error(ffi.Pointer<ffi.Void> batch) {
+    return _get_text_lines_error(batch);
+  }
+
+  late final _get_text_lines_errorPtr =
+      _lookup<ffi.NativeFunction<ffi.Pointer<ffi.Char> Function(ffi.Pointer<ffi.Void>)>>(
+          'get_text_lines_error');
+  late final _get_text_lines_error = _get_text_lines_errorPtr
+      .asFunction<ffi.Pointer<ffi.Char> Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Free text-line batch
+  void free_text_lines(ffi.Pointer<ffi.Void> batch) {
+    return _free_text_lines(batch);
+  }
+
+  late final _free_text_linesPtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>(
+          'free_text_lines');
+  late final _free_text_lines = _free_text_linesPtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Compute perceptual hash of a captured page
+  int page_hash_compute(
+    ffi.Pointer<ffi.Void> engine,
+    ffi.Pointer<ffi.Uint8> image_data,
+    int width,
+    int height,
+    int format,
+    ffi.Pointer<ffi.Float> corners,
+  ) {
+    return _page_hash_compute(
+      engine,
+      image_data,
+      width,
+      height,
+      format,
+      corners,
+    );
+  }
+
+  late final _page_hash_computePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint64 Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<ffi.Uint8>,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Pointer<ffi.Float>,
+          )>>('page_hash_compute');
+  late final _page_hash_compute = _page_hash_computePtr.asFunction<
+      int Function(
+        ffi.Pointer<ffi.Void>,
+        ffi.Pointer<ffi.Uint8>,
+        int,
+        int,
+        int,
+        ffi.Pointer<ffi.Float>,
+      )>();
+
+  /// Find near-duplicate page in the session index
+  int page_index_find_duplicate(
+    ffi.Pointer<ffi.Void> engine,
+    int hash,
+    int max_distance,
+    ffi.Pointer<ffi.Int32> out_distance,
+  ) {
+    return _page_index_find_duplicate(
+      engine,
+      hash,
+      max_distance,
+      out_distance,
+    );
+  }
+
+  late final _page_index_find_duplicatePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Uint64,
+            ffi.Int32,
+            ffi.Pointer<ffi.Int32>,
+          )>>('page_index_find_duplicate');
+  late final _page_index_find_duplicate = _page_index_find_duplicatePtr.asFunction<
+      int Function(
+        ffi.Pointer<ffi.Void>,
+        int,
+        int,
+        ffi.Pointer<ffi.Int32>,
+      )>();
+
+  /// Add page hash to the session index
+  int page_index_add(
+    ffi.Pointer<ffi.Void> engine,
+    int hash,
+  ) {
+    return _page_index_add(
+      engine,
+      hash,
+    );
+  }
+
+  late final _page_index_addPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Uint64,
+          )>>('page_index_add');
+  late final _page_index_add = _page_index_addPtr.asFunction<
+      int Function(
+        ffi.Pointer<ffi.Void>,
+        int,
+      )>();
+
+  /// Remove page from the session index
+  int page_index_remove(
+    ffi.Pointer<ffi.Void> engine,
+    int page_id,
+  ) {
+    return _page_index_remove(
+      engine,
+      page_id,
+    );
+  }
+
+  late final _page_index_removePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Int32,
+          )>>('page_index_remove');
+  late final _page_index_remove = _page_index_removePtr.asFunction<
+      int Function(
+        ffi.Pointer<ffi.Void>,
+        int,
+      )>();
+
+  /// Clear the session page index
+  void page_index_clear(ffi.Pointer<ffi.Void> engine) {
+    return _page_index_clear(engine);
+  }
+
+  late final _page_index_clearPtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>(
+          'page_index_clear');
+  late final _page_index_clear = _page_index_clearPtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Start long receipt stitching session
+  int stitch_begin(
+    ffi.Pointer<ffi.Void> engine,
+    int output_width,
+    int max_height,
+  ) {
+    return _stitch_begin(
+      engine,
+      output_width,
+      max_height,
+    );
+  }
+
+  late final _stitch_beginPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Int32,
+            ffi.Int32,
+          )>>('stitch_begin');
+  late final _stitch_begin = _stitch_beginPtr.asFunction<
+      int Function(
+        ffi.Pointer<ffi.Void>,
+        int,
+        int,
+      )>();
+
+  /// Add a frame to the stitching session
+  ffi.Pointer<ffi.Char> stitch_add_frame(
+    ffi.Pointer<ffi.Void> engine,
+    ffi.Pointer<ffi.Uint8> image_data,
+    int width,
+    int height,
+    int format,
+    int rotation,
+    ffi.Pointer<ffi.Float> corners,
+  ) {
+    return _stitch_add_frame(
+      engine,
+      image_data,
+      width,
+      height,
+      format,
+      rotation,
+      corners,
+    );
+  }
+
+  late final _stitch_add_framePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Char> Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<ffi.Uint8>,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Pointer<ffi.Float>,
+          )>>('stitch_add_frame');
+  late final _stitch_add_frame = _stitch_add_framePtr.asFunction<
+      ffi.Pointer<ffi.Char> Function(
+        ffi.Pointer<ffi.Void>,
+        ffi.Pointer<ffi.Uint8>,
+        int,
+        int,
+        int,
+        int,
+        ffi.Pointer<ffi.Float>,
+      )>();
+
+  /// Finish stitching and return the long image
+  ffi.Pointer<ffi.Void> stitch_finish(ffi.Pointer<ffi.Void> engine) {
+    return _stitch_finish(engine);
+  }
+
+  late final _stitch_finishPtr =
+      _lookup<ffi.NativeFunction<ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Void>)>>(
+          'stitch_finish');
+  late final _stitch_finish = _stitch_finishPtr
+      .asFunction<ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Cancel stitching session
+  void stitch_cancel(ffi.Pointer<ffi.Void> engine) {
+    return _stitch_cancel(engine);
+  }
+
+  late final _stitch_cancelPtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>(
+          'stitch_cancel');
+  late final _stitch_cancel = _stitch_cancelPtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Remove glare by compositing several frames of the same page
+  ffi.Pointer<ffi.Void> remove_glare(
+    ffi.Pointer<ffi.Void> engine,
+    ffi.Pointer<ffi.Pointer<ffi.Uint8>> images,
+    int count,
+    int width,
+    int height,
+    int format,
+    ffi.Pointer<ffi.Float> corners,
+    int output_width,
+    int output_height,
+  ) {
+    return _remove_glare(
+      engine,
+      images,
+      count,
+      width,
+      height,
+      format,
+      corners,
+      output_width,
+      output_height,
+    );
+  }
+
+  late final _remove_glarePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<ffi.Pointer<ffi.Uint8>>,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Pointer<ffi.Float>,
+            ffi.Int32,
+            ffi.Int32,
+          )>>('remove_glare');
+  late final _remove_glare = _remove_glarePtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(
+        ffi.Pointer<ffi.Void>,
+        ffi.Pointer<ffi.Pointer<ffi.Uint8>>,
+        int,
+        int,
+        int,
+        int,
+        ffi.Pointer<ffi.Float>,
+        int,
+        int,
+      )>();
+
+  /// Compare detector backends on the same frames (JSON)
+  ffi.Pointer<ffi.Char> benchmark_detectors(
+    ffi.Pointer<ffi.Void> engine,
+    ffi.Pointer<ffi.Pointer<ffi.Uint8>> images,
+    int count,
+    int width,
+    int height,
+    int format,
+    ffi.Pointer<ffi.Float> ground_truth,
+    int iterations,
+  ) {
+    return _benchmark_detectors(
+      engine,
+      images,
+      count,
+      width,
+      height,
+      format,
+      ground_truth,
+      iterations,
+    );
+  }
+
+  late final _benchmark_detectorsPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Char> Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<ffi.Pointer<ffi.Uint8>>,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Pointer<ffi.Float>,
+            ffi.Int32,
+          )>>('benchmark_detectors');
+  late final _benchmark_detectors = _benchmark_detectorsPtr.asFunction<
+      ffi.Pointer<ffi.Char> Function(
+        ffi.Pointer<ffi.Void>,
+        ffi.Pointer<ffi.Pointer<ffi.Uint8>>,
+        int,
+        int,
+        int,
+        int,
+        ffi.Pointer<ffi.Float>,
+        int,
+      )>();
+
+  /// CPU features and SIMD kernel self-test (JSON)
+  ffi.Pointer<ffi.Char> cpu_kernel_self_test() {
+    return _cpu_kernel_self_test();
+  }
+
+  late final _cpu_kernel_self_testPtr =
+      _lookup<ffi.NativeFunction<ffi.Pointer<ffi.Char> Function()>>(
+          'cpu_kernel_self_test');
+  late final _cpu_kernel_self_test =
+      _cpu_kernel_self_testPtr.asFunction<ffi.Pointer<ffi.Char> Function()>();
+
+  /// Create an engine pool (max engines, memory budget in MB)
+  ffi.Pointer<ffi.Void> engine_pool_create(
+    int max_engines,
+    int memory_budget_mb,
+  ) {
+    return _engine_pool_create(
+      max_engines,
+      memory_budget_mb,
+    );
+  }
+
+  late final _engine_pool_createPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(
+            ffi.Int32,
+            ffi.Int32,
+          )>>('engine_pool_create');
+  late final _engine_pool_create = _engine_pool_createPtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(
+        int,
+        int,
+      )>();
+
+  /// Destroy an engine pool
+  void engine_pool_destroy(ffi.Pointer<ffi.Void> pool) {
+    return _engine_pool_destroy(pool);
+  }
+
+  late final _engine_pool_destroyPtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>(
+          'engine_pool_destroy');
+  late final _engine_pool_destroy = _engine_pool_destroyPtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Open a pool session
+  int engine_pool_open_session(ffi.Pointer<ffi.Void> pool) {
+    return _engine_pool_open_session(pool);
+  }
+
+  late final _engine_pool_open_sessionPtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<ffi.Void>)>>(
+          'engine_pool_open_session');
+  late final _engine_pool_open_session = _engine_pool_open_sessionPtr
+      .asFunction<int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Close a pool session
+  void engine_pool_close_session(
+    ffi.Pointer<ffi.Void> pool,
+    int session_id,
+  ) {
+    return _engine_pool_close_session(
+      pool,
+      session_id,
+    );
+  }
+
+  late final _engine_pool_close_sessionPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Int32,
+          )>>('engine_pool_close_session');
+  late final _engine_pool_close_session = _engine_pool_close_sessionPtr.asFunction<
+      void Function(
+        ffi.Pointer<ffi.Void>,
+        int,
+      )>();
+
+  /// Detect and enhance a photo on a pooled engine
+  ffi.Pointer<ffi.Void> engine_pool_process_photo(
+    ffi.Pointer<ffi.Void> pool,
+    int session_id,
+    ffi.Pointer<ffi.Uint8> image_data,
+    int width,
+    int height,
+    int format,
+    int apply_sharpening,
+    double sharpening_strength,
+    int enhance_mode,
+    int output_width,
+    int output_height,
+  ) {
+    return _engine_pool_process_photo(
+      pool,
+      session_id,
+      image_data,
+      width,
+      height,
+      format,
+      apply_sharpening,
+      sharpening_strength,
+      enhance_mode,
+      output_width,
+      output_height,
+    );
+  }
+
+  late final _engine_pool_process_photoPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Int32,
+            ffi.Pointer<ffi.Uint8>,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Float,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+          )>>('engine_pool_process_photo');
+  late final _engine_pool_process_photo = _engine_pool_process_photoPtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(
+        ffi.Pointer<ffi.Void>,
+        int,
+        ffi.Pointer<ffi.Uint8>,
+        int,
+        int,
+        int,
+        int,
+        double,
+        int,
+        int,
+        int,
+      )>();
+
+  /// Get engine pool stats (JSON)
+  ffi.Pointer<ffi.Char> engine_pool_get_stats(ffi.Pointer<ffi.Void> pool) {
+    return _engine_pool_get_stats(pool);
+  }
+
+  late final _engine_pool_get_statsPtr =
+      _lookup<ffi.NativeFunction<ffi.Pointer<ffi.Char> Function(ffi.Pointer<ffi.Void>)>>(
+          'engine_pool_get_stats');
+  late final _engine_pool_get_stats = _engine_pool_get_statsPtr
+      .asFunction<ffi.Pointer<ffi.Char> Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Cap OpenCV worker threads process-wide
+  void configure_threads(int threads) {
+    return _configure_threads(threads);
+  }
+
+  late final _configure_threadsPtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Int32)>>(
+          'configure_threads');
+  late final _configure_threads = _configure_threadsPtr
+      .asFunction<void Function(int)>();
+
+  /// Create a page store
+  ffi.Pointer<ffi.Void> page_store_create() {
+    return _page_store_create();
+  }
+
+  late final _page_store_createPtr =
+      _lookup<ffi.NativeFunction<ffi.Pointer<ffi.Void> Function()>>(
+          'page_store_create');
+  late final _page_store_create =
+      _page_store_createPtr.asFunction<ffi.Pointer<ffi.Void> Function()>();
+
+  /// Destroy a page store
+  void page_store_destroy(ffi.Pointer<ffi.Void> store) {
+    return _page_store_destroy(store);
+  }
+
+  late final _page_store_destroyPtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>(
+          'page_store_destroy');
+  late final _page_store_destroy = _page_store_destroyPtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Open a page store file (resume keeps existing pages)
+  int page_store_open(
+    ffi.Pointer<ffi.Void> store,
+    ffi.Pointer<ffi.Char> path,
+    int resume,
+  ) {
+    return _page_store_open(
+      store,
+      path,
+      resume,
+    );
+  }
+
+  late final _page_store_openPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<ffi.Char>,
+            ffi.Int32,
+          )>>('page_store_open');
+  late final _page_store_open = _page_store_openPtr.asFunction<
+      int Function(
+        ffi.Pointer<ffi.Void>,
+        ffi.Pointer<ffi.Char>,
+        int,
+      )>();
+
+  /// Close the page store file
+  void page_store_close(ffi.Pointer<ffi.Void> store) {
+    return _page_store_close(store);
+  }
+
+  late final _page_store_closePtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>(
+          'page_store_close');
+  late final _page_store_close = _page_store_closePtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Get the last page store error
+  ffi.Pointer<ffi.Char> page_store_get_error(ffi.Pointer<ffi.Void> store) {
+    return _page_store_get_error(store);
+  }
+
+  late final _page_store_get_errorPtr =
+      _lookup<ffi.NativeFunction<ffi.Pointer<ffi.Char> Function(ffi.Pointer<ffi.Void>)>>(
+          'page_store_get_error');
+  late final _page_store_get_error = _page_store_get_errorPtr
+      .asFunction<ffi.Pointer<ffi.Char> Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Append an enhancement result to the store
+  int page_store_append_result(
+    ffi.Pointer<ffi.Void> store,
+    ffi.Pointer<ffi.Void> result,
+    int enhance_mode,
+    ffi.Pointer<ffi.Float> corners,
+  ) {
+    return _page_store_append_result(
+      store,
+      result,
+      enhance_mode,
+      corners,
+    );
+  }
+
+  late final _page_store_append_resultPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<ffi.Void>,
+            ffi.Int32,
+            ffi.Pointer<ffi.Float>,
+          )>>('page_store_append_result');
+  late final _page_store_append_result = _page_store_append_resultPtr.asFunction<
+      int Function(
+        ffi.Pointer<ffi.Void>,
+        ffi.Pointer<ffi.Void>,
+        int,
+        ffi.Pointer<ffi.Float>,
+      )>();
+
+  /// Append raw page pixels to the store
+  int page_store_append_image(
+    ffi.Pointer<ffi.Void> store,
+    ffi.Pointer<ffi.Uint8> image_data,
+    int width,
+    int height,
+    int channels,
+    int enhance_mode,
+    ffi.Pointer<ffi.Float> corners,
+  ) {
+    return _page_store_append_image(
+      store,
+      image_data,
+      width,
+      height,
+      channels,
+      enhance_mode,
+      corners,
+    );
+  }
+
+  late final _page_store_append_imagePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<ffi.Uint8>,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Pointer<ffi.Float>,
+          )>>('page_store_append_image');
+  late final _page_store_append_image = _page_store_append_imagePtr.asFunction<
+      int Function(
+        ffi.Pointer<ffi.Void>,
+        ffi.Pointer<ffi.Uint8>,
+        int,
+        int,
+        int,
+        int,
+        ffi.Pointer<ffi.Float>,
+      )>();
+
+  /// Get the stored page count
+  int page_store_count(ffi.Pointer<ffi.Void> store) {
+    return _page_store_count(store);
+  }
+
+  late final _page_store_countPtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<ffi.Void>)>>(
+          'page_store_count');
+  late final _page_store_count = _page_store_countPtr
+      .asFunction<int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Get the page index (JSON)
+  ffi.Pointer<ffi.Char> page_store_get_index(ffi.Pointer<ffi.Void> store) {
+    return _page_store_get_index(store);
+  }
+
+  late final _page_store_get_indexPtr =
+      _lookup<ffi.NativeFunction<ffi.Pointer<ffi.Char> Function(ffi.Pointer<ffi.Void>)>>(
+          'page_store_get_index');
+  late final _page_store_get_index = _page_store_get_indexPtr
+      .asFunction<ffi.Pointer<ffi.Char> Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Map a stored page or thumbnail (zero-copy)
+  ffi.Pointer<ffi.Void> page_store_map_page(
+    ffi.Pointer<ffi.Void> store,
+    int index,
+    int thumbnail,
+  ) {
+    return _page_store_map_page(
+      store,
+      index,
+      thumbnail,
+    );
+  }
+
+  late final _page_store_map_pagePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Int32,
+            ffi.Int32,
+          )>>('page_store_map_page');
+  late final _page_store_map_page = _page_store_map_pagePtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(
+        ffi.Pointer<ffi.Void>,
+        int,
+        int,
+      )>();
+
+  /// Get mapped page pixels
+  ffi.Pointer<ffi.Uint8> page_view_data(ffi.Pointer<ffi.Void> view) {
+    return _page_view_data(view);
+  }
+
+  late final _page_view_dataPtr =
+      _lookup<ffi.NativeFunction<ffi.Pointer<ffi.Uint8> Function(ffi.Pointer<ffi.Void>)>>(
+          'page_view_data');
+  late final _page_view_data = _page_view_dataPtr
+      .asFunction<ffi.Pointer<ffi.Uint8> Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Get mapped page width
+  int page_view_width(ffi.Pointer<ffi.Void> view) {
+    return _page_view_width(view);
+  }
+
+  late final _page_view_widthPtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<ffi.Void>)>>(
+          'page_view_width');
+  late final _page_view_width = _page_view_widthPtr
+      .asFunction<int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Get mapped page height
+  int page_view_height(ffi.Pointer<ffi.Void> view) {
+    return _page_view_height(view);
+  }
+
+  late final _page_view_heightPtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<ffi.Void>)>>(
+          'page_view_height');
+  late final _page_view_height = _page_view_heightPtr
+      .asFunction<int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Get mapped page channels
+  int page_view_channels(ffi.Pointer<ffi.Void> view) {
+    return _page_view_channels(view);
+  }
+
+  late final _page_view_channelsPtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<ffi.Void>)>>(
+          'page_view_channels');
+  late final _page_view_channels = _page_view_channelsPtr
+      .asFunction<int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Get mapped page row stride
+  int page_view_stride(ffi.Pointer<ffi.Void> view) {
+    return _page_view_stride(view);
+  }
+
+  late final _page_view_stridePtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<ffi.Void>)>>(
+          'page_view_stride');
+  late final _page_view_stride = _page_view_stridePtr
+      .asFunction<int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Release a mapped page
+  void page_view_release(ffi.Pointer<ffi.Void> view) {
+    return _page_view_release(view);
+  }
+
+  late final _page_view_releasePtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>(
+          'page_view_release');
+  late final _page_view_release = _page_view_releasePtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Flush the page store to disk
+  int page_store_sync(ffi.Pointer<ffi.Void> store) {
+    return _page_store_sync(store);
+  }
+
+  late final _page_store_syncPtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<ffi.Void>)>>(
+          'page_store_sync');
+  late final _page_store_sync = _page_store_syncPtr
+      .asFunction<int Function(ffi.Pointer<ffi.Void>)>();
+
   /// Free string
   void free_string(ffi.Pointer<ffi.Char> str) {
     return _free_string(str);
@@ -0,0 +1,199 @@
+#include "barcode_locator.hpp"
+#include <algorithm>
+#include <cmath>
+
+BarcodeLocator::BarcodeLocator() {}
+
+BarcodeLocator::~BarcodeLocator() {}
+
+std::vector<BarcodeLocator::Finder> BarcodeLocator::findFinderPatterns(const cv::Mat& gray) {
+    std::vector<Finder> finders;
+
+    // Ink = 255; large block keeps the 3x3 finder center solid
+    cv::Mat binary;
+    cv::adaptiveThreshold(gray, binary, 255, cv::ADAPTIVE_THRESH_MEAN_C,
+                          cv::THRESH_BINARY_INV, 51, 5);
+
+    std::vector<std::vector<cv::Point>> contours;
+    std::vector<cv::Vec4i> hierarchy;
+    cv::findContours(binary, contours, hierarchy, cv::RETR_TREE, cv::CHAIN_APPROX_SIMPLE);
+
+    for (size_t i = 0; i < contours.size(); i++) {
+        // Finder pattern: dark square -> light ring (hole) -> dark center
+        int hole = hierarchy[i][2];
+        if (hole < 0) continue;
+        int center = hierarchy[hole][2];
+        if (center < 0) continue;
+
+        cv::Rect outer = cv::boundingRect(contours[i]);
+        if (outer.width < 6 || outer.height < 6) continue;
+        float squareness = static_cast<float>(outer.width) / outer.height;
+        if (squareness < 0.6f || squareness > 1.6f) continue;
+
+        double outerArea = cv::contourArea(contours[i]);
+        double centerArea = cv::contourArea(contours[center]);
+        if (centerArea <= 0) continue;
+
+        // 7x7 modules outside, 3x3 inside: ratio ~5.4 (perspective/blur widen it)
+        double ratio = outerArea / centerArea;
+        if (ratio < 2.5 || ratio > 12.0) continue;
+
+        std::vector<cv::Point> approx;
+        cv::approxPolyDP(contours[i], approx, cv::arcLength(contours[i], true) * 0.05, true);
+        if (approx.size() != 4) continue;
+
+        cv::Moments m = cv::moments(contours[center]);
+        if (m.m00 <= 0) continue;
+
+        Finder f;
+        f.center = cv::Point2f(static_cast<float>(m.m10 / m.m00), static_cast<float>(m.m01 / m.m00));
+        f.size = std::sqrt(static_cast<float>(outerArea));
+        finders.push_back(f);
+    }
+
+    return finders;
+}
+
+void BarcodeLocator::groupFinders(const std::vector<Finder>& finders, const cv::Size& imageSize,
+                                  std::vector<CodeRegion>& regions) {
+    const size_t n = std::min<size_t>(finders.size(), 24);  // Bound the O(n^3) search
+    std::vector<bool> used(n, false);
+
+    for (size_t a = 0; a < n; a++) {
+        for (size_t b = a + 1; b < n && !used[a]; b++) {
+            for (size_t c = b + 1; c < n && !used[a] && !used[b]; c++) {
+                if (used[c]) continue;
+
+                const Finder* f[3] = {&finders[a], &finders[b], &finders[c]};
+                float minSize = std::min({f[0]->size, f[1]->size, f[2]->size});
+                float maxSize = std::max({f[0]->size, f[1]->size, f[2]->size});
+                if (maxSize > minSize * 1.6f) continue;
+
+                // Find the right-angle corner with two similar legs
+                for (int k = 0; k < 3; k++) {
+                    cv::Point2f corner = f[k]->center;
+                    cv::Point2f p1 = f[(k + 1) % 3]->center;
+                    cv::Point2f p2 = f[(k + 2) % 3]->center;
+                    cv::Point2f l1 = p1 - corner;
+                    cv::Point2f l2 = p2 - corner;
+                    float n1 = std::sqrt(l1.dot(l1));
+                    float n2 = std::sqrt(l2.dot(l2));
+                    if (n1 <= 0 || n2 <= 0) continue;
+
+                    float legRatio = std::max(n1, n2) / std::min(n1, n2);
+                    float cosAngle = l1.dot(l2) / (n1 * n2);
+                    float size = (minSize + maxSize) * 0.5f;
+
+                    // Version 1 (21 modules) to 40 (177 modules)
+                    if (legRatio > 1.4f || std::abs(cosAngle) > 0.35f) continue;
+                    if (n1 < size * 1.5f || n1 > size * 26.0f) continue;
+
+                    // Fourth corner completes the square; pad by half a finder
+                    cv::Point2f p4 = p1 + p2 - corner;
+                    std::vector<cv::Point2f> pts = {corner, p1, p2, p4};
+                    cv::Rect bounds = cv::boundingRect(pts);
+                    int pad = static_cast<int>(std::ceil(size * 0.8f));
+                    bounds = cv::Rect(bounds.x - pad, bounds.y - pad,
+                                      bounds.width + pad * 2, bounds.height + pad * 2) &
+                             cv::Rect(0, 0, imageSize.width, imageSize.height);
+
+                    CodeRegion region;
+                    region.type = CODE_QR;
+                    region.bounds = bounds;
+                    region.score = std::max(0.0f, 1.0f - std::abs(cosAngle) - (legRatio - 1.0f));
+                    regions.push_back(region);
+
+                    used[a] = used[b] = used[c] = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+float BarcodeLocator::barConsistency(const cv::Mat& gray, const cv::Rect& r, int& transitions) {
+    // Bars run through the whole code: rows at 1/3 and 2/3 height agree,
+    // text lines do not
+    transitions = 0;
+    if (r.height < 6 || r.width < 16) {
+        return 0.0f;
+    }
+
+    cv::Mat roi = gray(r);
+    double threshold = cv::mean(roi)[0];
+    const uchar* a = roi.ptr<uchar>(r.height / 3);
+    const uchar* b = roi.ptr<uchar>(r.height * 2 / 3);
+
+    int agree = 0;
+    bool prev = a[0] < threshold;
+    for (int x = 0; x < r.width; x++) {
+        bool da = a[x] < threshold;
+        bool db = b[x] < threshold;
+        if (da == db) agree++;
+        if (da != prev) transitions++;
+        prev = da;
+    }
+    return static_cast<float>(agree) / r.width;
+}
+
+void BarcodeLocator::findLinear(const cv::Mat& gray, bool transposed, std::vector<CodeRegion>& regions) {
+    // Strong horizontal gradient without vertical gradient = vertical bars
+    cv::Mat gx, gy, absX, absY, grad;
+    cv::Sobel(gray, gx, CV_16S, 1, 0, 3);
+    cv::Sobel(gray, gy, CV_16S, 0, 1, 3);
+    cv::convertScaleAbs(gx, absX);
+    cv::convertScaleAbs(gy, absY);
+    cv::subtract(absX, absY, grad);
+
+    cv::blur(grad, grad, cv::Size(9, 9));
+    cv::Scalar mean, stddev;
+    cv::meanStdDev(grad, mean, stddev);
+    cv::threshold(grad, grad, std::max(40.0, mean[0] + 2.0 * stddev[0]), 255, cv::THRESH_BINARY);
+
+    // Merge bars into one blob, then drop thin text strokes
+    cv::morphologyEx(grad, grad, cv::MORPH_CLOSE,
+                     cv::getStructuringElement(cv::MORPH_RECT, cv::Size(15, 5)));
+    cv::erode(grad, grad, cv::Mat(), cv::Point(-1, -1), 3);
+    cv::dilate(grad, grad, cv::Mat(), cv::Point(-1, -1), 3);
+
+    std::vector<std::vector<cv::Point>> contours;
+    cv::findContours(grad, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+
+    const double minArea = gray.total() * 0.002;
+    for (const auto& contour : contours) {
+        cv::Rect r = cv::boundingRect(contour);
+        if (r.area() < minArea || r.width < r.height * 0.8f) continue;
+
+        int transitions = 0;
+        float consistency = barConsistency(gray, r, transitions);
+        if (consistency < 0.8f || transitions < 12) continue;
+
+        CodeRegion region;
+        region.type = CODE_LINEAR;
+        region.bounds = transposed ? cv::Rect(r.y, r.x, r.height, r.width) : r;
+        region.score = std::min(1.0f, (consistency - 0.8f) * 5.0f);
+        regions.push_back(region);
+    }
+}
+
+std::vector<CodeRegion> BarcodeLocator::locate(const cv::Mat& gray, int maxRegions) {
+    std::vector<CodeRegion> regions;
+
+    if (gray.empty() || gray.channels() != 1) {
+        return regions;
+    }
+
+    groupFinders(findFinderPatterns(gray), gray.size(), regions);
+
+    findLinear(gray, false, regions);
+    cv::Mat transposed = gray.t();
+    findLinear(transposed, true, regions);
+
+    std::sort(regions.begin(), regions.end(),
+              [](const CodeRegion& a, const CodeRegion& b) { return a.score > b.score; });
+    if (regions.size() > static_cast<size_t>(maxRegions)) {
+        regions.resize(maxRegions);
+    }
+
+    return regions;
+}
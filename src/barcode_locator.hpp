@@ -0,0 +1,44 @@
+#ifndef BARCODE_LOCATOR_HPP
+#define BARCODE_LOCATOR_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+enum CodeType {
+    CODE_QR = 1,      // Three finder patterns
+    CODE_LINEAR = 2   // 1-D barcode (EAN/Code128/...)
+};
+
+struct CodeRegion {
+    CodeType type;
+    cv::Rect bounds;   // In the coordinates of the searched image
+    float score;       // 0-1
+
+    CodeRegion() : type(CODE_QR), score(0) {}
+};
+
+// Cheap QR/barcode region locator for OCR bypass. Only finds candidate
+// regions (no decoding) so the host can hand them to a decoder at full
+// resolution. Designed for the detector's ~480 px gray image.
+class BarcodeLocator {
+public:
+    BarcodeLocator();
+    ~BarcodeLocator();
+
+    std::vector<CodeRegion> locate(const cv::Mat& gray, int maxRegions = 4);
+
+private:
+    struct Finder {
+        cv::Point2f center;
+        float size;
+    };
+
+    std::vector<Finder> findFinderPatterns(const cv::Mat& gray);
+    void groupFinders(const std::vector<Finder>& finders, const cv::Size& imageSize,
+                      std::vector<CodeRegion>& regions);
+    // Bars along the image y axis; call on the transposed image for the other orientation
+    void findLinear(const cv::Mat& gray, bool transposed, std::vector<CodeRegion>& regions);
+    static float barConsistency(const cv::Mat& gray, const cv::Rect& r, int& transitions);
+};
+
+#endif // BARCODE_LOCATOR_HPP
@@ -0,0 +1,117 @@
+#include "camera_advisor.hpp"
+#include <algorithm>
+#include <cmath>
+
+CameraAdvisor::CameraAdvisor() {}
+
+CameraAdvisor::~CameraAdvisor() {}
+
+CameraHints CameraAdvisor::advise(const cv::Mat& gray, const std::vector<cv::Point2f>& quad) {
+    CameraHints hints;
+
+    if (gray.empty()) {
+        return hints;
+    }
+
+    const cv::Rect frameRect(0, 0, gray.cols, gray.rows);
+    cv::Mat mask;
+    cv::Rect bounds = frameRect;
+    if (quad.size() == 4) {
+        std::vector<cv::Point> poly;
+        for (const auto& pt : quad) {
+            poly.push_back(cv::Point(cvRound(pt.x), cvRound(pt.y)));
+        }
+        mask = cv::Mat::zeros(gray.size(), CV_8UC1);
+        cv::fillConvexPoly(mask, poly, cv::Scalar(255));
+        bounds = cv::boundingRect(poly) & frameRect;
+    }
+    if (bounds.area() < 64) {
+        return hints;
+    }
+
+    // Exposure: bring paper white (90th percentile) to the target level
+    int histSize = 256;
+    float range[] = {0, 256};
+    const float* ranges = range;
+    cv::Mat hist;
+    cv::Mat roi = gray(bounds);
+    cv::Mat roiMask = mask.empty() ? cv::Mat() : mask(bounds);
+    cv::calcHist(&roi, 1, 0, roiMask, hist, 1, &histSize, &ranges);
+
+    float total = static_cast<float>(cv::sum(hist)[0]);
+    if (total <= 0) {
+        return hints;
+    }
+
+    float cumulative = 0;
+    int p90 = 255;
+    for (int i = 0; i < histSize; i++) {
+        cumulative += hist.at<float>(i);
+        if (cumulative >= total * 0.9f) {
+            p90 = i;
+            break;
+        }
+    }
+    float clipped = 0;
+    for (int i = 250; i < histSize; i++) {
+        clipped += hist.at<float>(i);
+    }
+
+    hints.paper_level = static_cast<float>(p90);
+    hints.clipped_ratio = clipped / total;
+
+    float ev = std::log2(target_paper_level_ / std::max(1.0f, hints.paper_level));
+    if (hints.clipped_ratio > 0.02f) {
+        // Clipped highlights hide the true level; step down proportionally
+        ev = std::min(ev, -0.33f - hints.clipped_ratio * 4.0f);
+    }
+    ev = std::max(-MAX_EV, std::min(MAX_EV, ev));
+    hints.exposure_ev = std::round(ev * 3.0f) / 3.0f;
+
+    // Focus: page center, unless one textured tile is clearly softer than the rest
+    cv::Point2f center(bounds.x + bounds.width * 0.5f, bounds.y + bounds.height * 0.5f);
+    if (quad.size() == 4) {
+        center = (quad[0] + quad[1] + quad[2] + quad[3]) * 0.25f;
+    }
+
+    const int tw = bounds.width / TILE_GRID;
+    const int th = bounds.height / TILE_GRID;
+    if (tw >= 16 && th >= 16) {
+        float minSharp = -1, maxSharp = 0;
+        cv::Point2f softest = center;
+        cv::Mat lap;
+        for (int ty = 0; ty < TILE_GRID; ty++) {
+            for (int tx = 0; tx < TILE_GRID; tx++) {
+                cv::Rect tile(bounds.x + tx * tw, bounds.y + ty * th, tw, th);
+
+                // Only tiles fully inside the page
+                if (!mask.empty() && cv::countNonZero(mask(tile)) < tile.area() * 9 / 10) continue;
+
+                cv::Scalar mean, contrast, lapMean, lapStd;
+                cv::meanStdDev(gray(tile), mean, contrast);
+                if (contrast[0] < 12) continue;  // Blank paper has nothing to focus on
+
+                cv::Laplacian(gray(tile), lap, CV_16S);
+                cv::meanStdDev(lap, lapMean, lapStd);
+                // Normalize by contrast so dense vs sparse text compares fairly
+                float sharp = static_cast<float>(lapStd[0] / contrast[0]);
+
+                if (minSharp < 0 || sharp < minSharp) {
+                    minSharp = sharp;
+                    softest = cv::Point2f(tile.x + tw * 0.5f, tile.y + th * 0.5f);
+                }
+                maxSharp = std::max(maxSharp, sharp);
+            }
+        }
+
+        // Depth varies across a tilted page: focus where detail is lost
+        if (minSharp >= 0 && minSharp < maxSharp * 0.6f) {
+            center = softest;
+            hints.focus_on_tile = true;
+        }
+    }
+
+    hints.focus_x = std::min(1.0f, std::max(0.0f, center.x / gray.cols));
+    hints.focus_y = std::min(1.0f, std::max(0.0f, center.y / gray.rows));
+    return hints;
+}
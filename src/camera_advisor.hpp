@@ -0,0 +1,40 @@
+#ifndef CAMERA_ADVISOR_HPP
+#define CAMERA_ADVISOR_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+struct CameraHints {
+    float focus_x;        // 0-1, recommended focus/metering point (frame-normalized)
+    float focus_y;
+    bool focus_on_tile;   // True if pointing at the blurriest text tile, false = page center
+    float exposure_ev;    // Suggested exposure compensation in EV (1/3 stop steps)
+    float paper_level;    // 0-255, bright-percentile of the ROI (paper white)
+    float clipped_ratio;  // Fraction of ROI pixels at/near 255
+
+    CameraHints()
+        : focus_x(0.5f), focus_y(0.5f), focus_on_tile(false),
+          exposure_ev(0), paper_level(0), clipped_ratio(0) {}
+};
+
+// Focus/metering point and exposure compensation from the document ROI,
+// so the camera layer stops metering/focusing on the background.
+class CameraAdvisor {
+public:
+    CameraAdvisor();
+    ~CameraAdvisor();
+
+    // gray: detection-resolution gray frame; quad: ROI in the same coordinates
+    // (empty = whole frame)
+    CameraHints advise(const cv::Mat& gray, const std::vector<cv::Point2f>& quad);
+
+    void setTargetPaperLevel(float level) { target_paper_level_ = level; }
+
+private:
+    float target_paper_level_ = 210.0f;
+
+    static const int TILE_GRID = 3;
+    static constexpr float MAX_EV = 2.0f;
+};
+
+#endif // CAMERA_ADVISOR_HPP
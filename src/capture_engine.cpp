@@ -1,15 +1,41 @@
 #include "capture_engine.hpp"
+#include "shared_resources.hpp"
 #include <cstring>
+#include <numeric>
 
 #ifdef __ANDROID__
 #include <android/log.h>
 #endif
 
 CaptureEngine::CaptureEngine() {
+    created_tick_ = cv::getTickCount();
+
+    // Kernels and thread pool are process-wide; first engine initializes them
+    SharedResources::instance();
+
     detector_ = std::make_unique<DocumentDetector>();
+    dnn_detector_ = std::make_unique<DnnDetector>();
     corrector_ = std::make_unique<PerspectiveCorrector>();
     assessor_ = std::make_unique<QualityAssessor>();
     enhancer_ = std::make_unique<ImageEnhancer>();
+    snapper_ = std::make_unique<EdgeSnapper>();
+    table_analyzer_ = std::make_unique<TableAnalyzer>();
+    line_extractor_ = std::make_unique<TextLineExtractor>();
+    page_index_ = std::make_unique<PageHashIndex>();
+    page_turn_ = std::make_unique<PageTurnDetector>();
+    stitcher_ = std::make_unique<ReceiptStitcher>();
+    glare_compositor_ = std::make_unique<GlareCompositor>();
+    motion_tracker_ = std::make_unique<MotionTracker>();
+    occlusion_detector_ = std::make_unique<OcclusionDetector>();
+    moire_detector_ = std::make_unique<MoireDetector>();
+    framing_guide_ = std::make_unique<FramingGuide>();
+    camera_advisor_ = std::make_unique<CameraAdvisor>();
+    rate_governor_ = std::make_unique<FrameRateGovernor>();
+    classifier_ = std::make_unique<DocumentClassifier>();
+    barcode_locator_ = std::make_unique<BarcodeLocator>();
+
+    startup_.construct_ms = static_cast<float>(
+        (cv::getTickCount() - created_tick_) * 1000.0 / cv::getTickFrequency());
 }
 
 CaptureEngine::~CaptureEngine() {}
@@ -18,6 +44,245 @@ void CaptureEngine::reset() {
     if (assessor_) {
         assessor_->reset();
     }
+    if (page_turn_) {
+        page_turn_->reset();
+    }
+    if (rate_governor_) {
+        rate_governor_->reset();
+    }
+    if (classifier_) {
+        classifier_->reset();
+    }
+}
+
+void CaptureEngine::resetSession() {
+    reset();
+
+    last_analysis_ = FrameAnalysisResult();
+    page_index_->clear();
+    stitcher_->cancel();
+    motion_tracker_->reset();
+    snapper_->clear();
+
+    // Settings back to construction defaults (a loaded model stays loaded)
+    setDocumentProfile(PROFILE_ANY);
+    detector_backend_ = DETECTOR_CLASSICAL;
+    continuous_scan_ = false;
+    occlusion_veto_ = true;
+    barcode_detection_ = false;
+    framing_guide_ = std::make_unique<FramingGuide>();
+    rate_governor_ = std::make_unique<FrameRateGovernor>();
+}
+
+void CaptureEngine::pushImuSample(ImuSampleType type, float x, float y, float z, int64_t timestamp_ns) {
+    motion_tracker_->addSample(type, x, y, z, timestamp_ns);
+}
+
+float CaptureEngine::combineStability(float image_stability, const MotionState& motion) {
+    if (!motion.active) {
+        return image_stability;
+    }
+
+    // A moving device is never stable; a still one needs less image evidence
+    return std::min(motion.stability, image_stability * 0.4f + motion.stability * 0.6f);
+}
+
+EnhanceMode CaptureEngine::autoEnhanceMode(DocumentType type) {
+    switch (type) {
+        case DOC_TYPE_RECEIPT:
+            return ENHANCE_ADAPTIVE_BINARIZE;  // Faded thermal print
+        case DOC_TYPE_A4:
+        case DOC_TYPE_LETTER:
+        case DOC_TYPE_PAGE:
+        case DOC_TYPE_WHITEBOARD:
+            return ENHANCE_WHITEN_BG;
+        case DOC_TYPE_ID_CARD:
+        case DOC_TYPE_UNKNOWN:
+        default:
+            return ENHANCE_NONE;  // Keep photo and security print colors
+    }
+}
+
+cv::Mat CaptureEngine::applyEnhanceMode(const cv::Mat& image, EnhanceMode mode, bool autoBrightness) {
+    if (!enhancer_) {
+        return image;
+    }
+
+    ToneCurveConfig tone;
+    tone.auto_brightness = autoBrightness;
+    if (mode == ENHANCE_WHITEN_BG) {
+        tone.whiten_threshold = 200;
+    } else if (mode == ENHANCE_CONTRAST_STRETCH) {
+        tone.percentile_stretch = true;
+    }
+    cv::Mat toned = tone.isIdentity() ? image : enhancer_->applyToneCurve(image, tone);
+
+    switch (mode) {
+        case ENHANCE_ADAPTIVE_BINARIZE:
+            return enhancer_->adaptiveBinarize(toned, 11, 2);
+        case ENHANCE_SAUVOLA:
+            return enhancer_->sauvolaBinarize(toned, 15, 0.2, 128);
+        case ENHANCE_WHITEN_BG:
+        case ENHANCE_CONTRAST_STRETCH:
+        case ENHANCE_NONE:
+        default:
+            return toned;
+    }
+}
+
+void CaptureEngine::setDocumentProfile(DocumentProfile profile, float custom_aspect) {
+    float aspect = profile == PROFILE_CUSTOM ? custom_aspect : DocumentDetector::profileAspect(profile);
+    detector_->setAspectConstraint(aspect);
+    dnn_detector_->setAspectConstraint(aspect);
+    corrector_->setAspectRatio(detector_->aspectConstraint());
+    if (assessor_) {
+        assessor_->reset();  // Corner history is from a different candidate set
+    }
+}
+
+DetectorBackend& CaptureEngine::activeDetector() {
+    if (detector_backend_ == DETECTOR_DNN && dnn_detector_->isLoaded()) {
+        return *dnn_detector_;
+    }
+    return *detector_;
+}
+
+bool CaptureEngine::loadDetectorModel(const std::string& model_path, int input_size) {
+    bool loaded = dnn_detector_->load(model_path, input_size);
+    if (!loaded && detector_backend_ == DETECTOR_DNN) {
+        detector_backend_ = DETECTOR_CLASSICAL;
+    }
+    return loaded;
+}
+
+bool CaptureEngine::setDetectorBackend(DetectorBackendType backend) {
+    if (backend == DETECTOR_DNN && !dnn_detector_->isLoaded()) {
+        return false;
+    }
+    if (backend != detector_backend_ && assessor_) {
+        assessor_->reset();  // Corner history from the other backend
+    }
+    detector_backend_ = backend;
+    return true;
+}
+
+std::vector<DetectorBenchmark> CaptureEngine::benchmarkDetectors(
+    const uint8_t* const* images,
+    int count,
+    int width,
+    int height,
+    int format,
+    const float* ground_truth,
+    int iterations
+) {
+    std::vector<DetectorBenchmark> results;
+
+    if (!images || count <= 0 || width <= 0 || height <= 0) {
+        return results;
+    }
+    iterations = std::max(1, iterations);
+
+    std::vector<cv::Mat> frames;
+    std::vector<std::vector<cv::Point2f>> reference;
+    for (int i = 0; i < count; i++) {
+        if (!images[i]) continue;
+        frames.push_back(bufferToMat(images[i], width, height, format));
+
+        std::vector<cv::Point2f> quad;
+        if (ground_truth) {
+            const float* c = ground_truth + i * 8;
+            for (int k = 0; k < 4; k++) {
+                quad.push_back(cv::Point2f(c[k * 2], c[k * 2 + 1]));
+            }
+        }
+        reference.push_back(quad);
+    }
+
+    const float diagonal = std::sqrt(static_cast<float>(width * width + height * height));
+
+    // Classical first: without ground truth its corners are the reference
+    DetectorBackend* backends[] = {
+        detector_.get(),
+        dnn_detector_->isLoaded() ? dnn_detector_.get() : nullptr
+    };
+
+    for (int b = 0; b < 2; b++) {
+        DetectorBenchmark bench;
+        bench.backend = b;
+        bench.frames = static_cast<int>(frames.size());
+        if (!backends[b] || frames.empty()) {
+            results.push_back(bench);
+            continue;
+        }
+        bench.available = true;
+
+        // Untimed warm-up (lazy allocations, first dnn forward)
+        backends[b]->detect(frames[0]);
+
+        std::vector<double> times;
+        int found = 0, compared = 0, agree = 0;
+        double errorSum = 0;
+        for (size_t i = 0; i < frames.size(); i++) {
+            DetectionResult detection;
+            for (int it = 0; it < iterations; it++) {
+                int64 start = cv::getTickCount();
+                detection = backends[b]->detect(frames[i]);
+                times.push_back((cv::getTickCount() - start) * 1000.0 / cv::getTickFrequency());
+            }
+
+            if (!ground_truth && b == DETECTOR_CLASSICAL && detection.found) {
+                reference[i] = detection.corners;
+            }
+
+            if (detection.found) {
+                found++;
+            }
+            if (detection.found && reference[i].size() == 4) {
+                double err = 0;
+                for (int k = 0; k < 4; k++) {
+                    err += cv::norm(detection.corners[k] - reference[i][k]);
+                }
+                err /= 4.0 * diagonal;
+                errorSum += err;
+                compared++;
+                if (err < 0.02) agree++;
+            } else if (!detection.found && reference[i].empty()) {
+                agree++;  // Both report no document
+            }
+        }
+
+        std::sort(times.begin(), times.end());
+        double total = 0;
+        for (double t : times) total += t;
+        bench.mean_ms = static_cast<float>(total / times.size());
+        bench.p95_ms = static_cast<float>(times[std::min(times.size() - 1, times.size() * 95 / 100)]);
+        bench.found_rate = static_cast<float>(found) / frames.size();
+        bench.corner_error = compared > 0 ? static_cast<float>(errorSum / compared) : 0.0f;
+        bench.agreement = static_cast<float>(agree) / frames.size();
+        results.push_back(bench);
+    }
+
+    return results;
+}
+
+void CaptureEngine::setFrameRateLimits(int min_fps, int max_fps) {
+    rate_governor_->setLimits(min_fps, max_fps);
+}
+
+void CaptureEngine::setFramingTarget(float target_fill, float min_text_px) {
+    if (target_fill > 0) {
+        framing_guide_->setTargetFill(target_fill);
+    }
+    if (min_text_px > 0) {
+        framing_guide_->setMinTextPx(min_text_px);
+    }
+}
+
+void CaptureEngine::setContinuousScan(bool enabled) {
+    if (enabled != continuous_scan_) {
+        page_turn_->reset();
+    }
+    continuous_scan_ = enabled;
 }
 
 cv::Mat CaptureEngine::bufferToMat(const uint8_t* data, int width, int height, int format) {
@@ -45,6 +310,143 @@ cv::Mat CaptureEngine::bufferToMat(const uint8_t* data, int width, int height, i
     return result;
 }
 
+void CaptureEngine::ingestFrame(const uint8_t* data, int width, int height, int format, cv::Mat& dst) {
+    switch (format) {
+        case 0:  // BGRA
+            cv::Mat(height, width, CV_8UC4, const_cast<uint8_t*>(data)).copyTo(dst);
+            break;
+        case 2:  // RGB
+            cv::cvtColor(cv::Mat(height, width, CV_8UC3, const_cast<uint8_t*>(data)), dst, cv::COLOR_RGB2BGR);
+            break;
+        case 1:  // BGR
+        default:
+            cv::Mat(height, width, CV_8UC3, const_cast<uint8_t*>(data)).copyTo(dst);
+            break;
+    }
+}
+
+float CaptureEngine::warmUp(int width, int height, int format, int rotation) {
+    if (width <= 0 || height <= 0) {
+        return -1.0f;
+    }
+
+    int64_t start = cv::getTickCount();
+    warming_up_ = true;
+
+    // Synthetic scene: light page with text-like strokes on a dark desk
+    cv::Mat scene(height, width, CV_8UC3, cv::Scalar(60, 60, 60));
+    std::vector<cv::Point> page = {
+        cv::Point(width / 5, height / 6), cv::Point(width * 4 / 5, height / 6),
+        cv::Point(width * 4 / 5, height * 5 / 6), cv::Point(width / 5, height * 5 / 6)
+    };
+    cv::fillConvexPoly(scene, page, cv::Scalar(235, 235, 235));
+    for (int y = height / 6 + height / 20; y < height * 5 / 6 - height / 20; y += std::max(4, height / 40)) {
+        cv::line(scene, cv::Point(width / 4, y), cv::Point(width * 3 / 4, y), cv::Scalar(30, 30, 30), 1);
+    }
+
+    cv::Mat input;
+    if (format == 0) {
+        cv::cvtColor(scene, input, cv::COLOR_BGR2BGRA);
+    } else if (format == 2) {
+        cv::cvtColor(scene, input, cv::COLOR_BGR2RGB);
+    } else {
+        input = scene;
+    }
+
+    // Two passes: the first allocates, the second runs on warm buffers
+    for (int pass = 0; pass < 2; pass++) {
+        analyzeFrame(input.data, width, height, format, rotation);
+    }
+
+    // Enhancement path (CLAHE tables, tone stage) on a page-sized crop
+    cv::Mat pageCrop = scene(cv::boundingRect(page));
+    enhancer_->applyCLAHE(pageCrop, 2.0f, 8);
+    applyEnhanceMode(pageCrop, ENHANCE_WHITEN_BG, true);
+
+    // Warm-up must not leave tracking state behind
+    reset();
+    last_analysis_ = FrameAnalysisResult();
+    warming_up_ = false;
+
+    startup_.warmup_ms = static_cast<float>((cv::getTickCount() - start) * 1000.0 / cv::getTickFrequency());
+    startup_.warmed_up = true;
+    return startup_.warmup_ms;
+}
+
+void CaptureEngine::releaseStreamBuffers() {
+    ingest_buffer_.release();
+    rotated_buffer_.release();
+    crop_buffer_.release();
+}
+
+void CaptureEngine::applyRotation(cv::Mat& frame, int rotation) {
+    if (rotation == 90) {
+        cv::rotate(frame, frame, cv::ROTATE_90_CLOCKWISE);
+    } else if (rotation == 180) {
+        cv::rotate(frame, frame, cv::ROTATE_180);
+    } else if (rotation == 270) {
+        cv::rotate(frame, frame, cv::ROTATE_90_COUNTERCLOCKWISE);
+    }
+}
+
+void CaptureEngine::fillResult(EnhancementResult& result, const cv::Mat& image) {
+    cv::Mat continuous = image.isContinuous() ? image : image.clone();
+
+    result.width = continuous.cols;
+    result.height = continuous.rows;
+    result.channels = continuous.channels();
+    result.stride = static_cast<int>(continuous.step);
+
+    size_t dataSize = continuous.total() * continuous.elemSize();
+    result.image_data = new uint8_t[dataSize];
+    memcpy(result.image_data, continuous.data, dataSize);
+
+    result.success = true;
+}
+
+void CaptureEngine::fillLevels(EnhancementResult& result, const cv::Mat& image, const int* sizes) {
+    std::vector<int> requested;
+    for (int i = 0; i < MAX_OUTPUT_LEVELS; i++) {
+        if (sizes[i] > 0) requested.push_back(sizes[i]);
+    }
+    if (requested.empty() || image.empty()) {
+        return;
+    }
+
+    // Largest first, each level resized from the previous one (pyramid),
+    // so small levels don't re-read the full-resolution page
+    std::vector<int> order(requested.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&requested](int a, int b) { return requested[a] > requested[b]; });
+
+    const int longSide = std::max(image.cols, image.rows);
+    cv::Mat source = image;
+    for (int k : order) {
+        cv::Mat level = source;
+        if (requested[k] < longSide) {
+            double scale = static_cast<double>(requested[k]) / longSide;
+            cv::Size size(std::max(1, static_cast<int>(std::lround(image.cols * scale))),
+                          std::max(1, static_cast<int>(std::lround(image.rows * scale))));
+            if (size != source.size()) {
+                cv::resize(source, level, size, 0, 0, cv::INTER_AREA);
+            }
+        }
+
+        cv::Mat continuous = level.isContinuous() ? level : level.clone();
+        size_t dataSize = continuous.total() * continuous.elemSize();
+        result.level_data[k] = new uint8_t[dataSize];
+        memcpy(result.level_data[k], continuous.data, dataSize);
+        result.level_width[k] = continuous.cols;
+        result.level_height[k] = continuous.rows;
+        result.level_stride[k] = static_cast<int>(continuous.step);
+
+        source = level;
+    }
+
+    result.level_count = static_cast<int>(requested.size());
+}
+
 FrameAnalysisResult CaptureEngine::analyzeFrame(
     const uint8_t* image_data,
     int width,
@@ -55,6 +457,39 @@ FrameAnalysisResult CaptureEngine::analyzeFrame(
     int crop_y,
     int crop_w,
     int crop_h
+) {
+    int64_t start = cv::getTickCount();
+    FrameAnalysisResult result = analyzeFrameImpl(
+        image_data, width, height, format, rotation, crop_x, crop_y, crop_w, crop_h);
+
+    if (!warming_up_) {
+        int64_t now = cv::getTickCount();
+        const double toMs = 1000.0 / cv::getTickFrequency();
+        float ms = static_cast<float>((now - start) * toMs);
+        if (startup_.analyzed_frames == 0) {
+            startup_.first_analysis_ms = ms;
+            startup_.create_to_first_result_ms = static_cast<float>((now - created_tick_) * toMs);
+        } else if (startup_.analyzed_frames == 1) {
+            startup_.steady_analysis_ms = ms;
+        } else {
+            startup_.steady_analysis_ms = startup_.steady_analysis_ms * 0.9f + ms * 0.1f;
+        }
+        startup_.analyzed_frames++;
+    }
+
+    return result;
+}
+
+FrameAnalysisResult CaptureEngine::analyzeFrameImpl(
+    const uint8_t* image_data,
+    int width,
+    int height,
+    int format,
+    int rotation,
+    int crop_x,
+    int crop_y,
+    int crop_w,
+    int crop_h
 ) {
     FrameAnalysisResult result;
 
@@ -62,20 +497,44 @@ FrameAnalysisResult CaptureEngine::analyzeFrame(
         return result;
     }
 
-    // Convert buffer to cv::Mat
-    cv::Mat frame = bufferToMat(image_data, width, height, format);
+    // Fast device motion: the frame is motion-blurred, skip all image work
+    MotionState motion = motion_tracker_->state();
+    if (motion.fast_motion) {
+        result = last_analysis_;
+        result.blur_score = 0;
+        result.blur_type = BLUR_MOTION;
+        result.blur_direction = 0;
+        result.blur_strength = motion.motion_score;
+        result.stability_score = 0;
+        result.overall_score = 0;
+        result.capture_ready = false;
+        result.scan_trigger = false;
+        result.imu_active = true;
+        result.imu_motion_score = motion.motion_score;
+        result.analysis_skipped = true;
+
+        RateAdvice rate = rate_governor_->updateSkipped();
+        result.recommended_fps = rate.fps;
+        result.rate_state = rate.state;
+        return result;
+    }
+    result.imu_active = motion.active;
+    result.imu_motion_score = motion.motion_score;
+
+    // Convert buffer into the reused stream buffer
+    ingestFrame(image_data, width, height, format, ingest_buffer_);
+    cv::Mat frame = ingest_buffer_;
 
     if (frame.empty()) {
         return result;
     }
 
     // Apply rotation if needed (SIMD optimized via OpenCV)
-    if (rotation == 90) {
-        cv::rotate(frame, frame, cv::ROTATE_90_CLOCKWISE);
-    } else if (rotation == 180) {
-        cv::rotate(frame, frame, cv::ROTATE_180);
-    } else if (rotation == 270) {
-        cv::rotate(frame, frame, cv::ROTATE_90_COUNTERCLOCKWISE);
+    if (rotation == 90 || rotation == 180 || rotation == 270) {
+        int code = rotation == 90 ? cv::ROTATE_90_CLOCKWISE
+                 : rotation == 180 ? cv::ROTATE_180 : cv::ROTATE_90_COUNTERCLOCKWISE;
+        cv::rotate(ingest_buffer_, rotated_buffer_, code);
+        frame = rotated_buffer_;
     }
 
     // Apply crop after rotation if specified
@@ -85,15 +544,17 @@ FrameAnalysisResult CaptureEngine::analyzeFrame(
         int w = std::min(crop_w, frame.cols - x);
         int h = std::min(crop_h, frame.rows - y);
         if (w > 0 && h > 0) {
-            frame = frame(cv::Rect(x, y, w, h)).clone();
+            frame(cv::Rect(x, y, w, h)).copyTo(crop_buffer_);
+            frame = crop_buffer_;
         }
     }
 
     // Detect document corners
-    DetectionResult detection = detector_->detect(frame);
+    DetectionResult detection = activeDetector().detect(frame);
 
     result.document_found = detection.found;
     result.corner_confidence = detection.confidence;
+    result.document_aspect = detection.aspect;
 
     // Debug: log detection result
     #ifdef __ANDROID__
@@ -164,18 +625,47 @@ FrameAnalysisResult CaptureEngine::analyzeFrame(
         // Is trapezoid if either skew > 5%
         result.is_trapezoid = result.skew_ratio > 0.05f;
 
+        // Distance/centering/tilt guidance from the quad
+        FramingGuidance framing = framing_guide_->evaluate(detection.corners, frame.size());
+        result.guidance = framing.code;
+        result.fill_ratio = framing.fill_ratio;
+        result.target_fill = framing.target_fill;
+        result.center_offset_x = framing.center_offset_x;
+        result.center_offset_y = framing.center_offset_y;
+        result.tilt_x = framing.tilt_x;
+        result.tilt_y = framing.tilt_y;
+        result.rotation_angle = framing.rotation;
+        result.text_px = framing.text_px;
+
+        // Document type from true aspect + rectified thumbnail (voted over frames)
+        ClassificationResult docClass = classifier_->update(frame, detection.corners, detection.aspect);
+        result.document_type = docClass.type;
+        result.document_type_confidence = docClass.confidence;
+
         // Assess quality using table corners
         QualityScore quality = assessor_->assess(frame, detection.corners, detection.confidence);
 
         result.blur_score = quality.blur_score;
+        result.blur_type = quality.blur.type;
+        result.blur_direction = quality.blur.direction;
+        result.blur_strength = quality.blur.strength;
         result.brightness_score = quality.brightness_score;
-        result.stability_score = quality.stability_score;
+        result.stability_score = combineStability(quality.stability_score, motion);
+        quality.stability_score = result.stability_score;
         result.overall_score = quality.overall();
 
         // Capture ready: need stability AND good quality
         result.capture_ready = quality.blur_score > 0.6f &&
                                quality.brightness_score > 0.5f &&
-                               quality.stability_score > 0.8f;
+                               result.stability_score > 0.8f;
+
+        // Fingers over the page edges: the quad is likely wrong and the page cut
+        OcclusionResult occlusion = occlusion_detector_->detect(frame, detection.corners);
+        result.occluded_edges = occlusion.edges;
+        result.occlusion_score = occlusion.score;
+        if (occlusion.occluded && occlusion_veto_) {
+            result.capture_ready = false;
+        }
     } else {
         // Document not found - use text regions detection as fallback
         TextRegionsResult textRegions = assessor_->detectTextRegions(frame);
@@ -218,7 +708,11 @@ FrameAnalysisResult CaptureEngine::analyzeFrame(
                 gray = frame;
             }
 
-            result.blur_score = assessor_->detectBlurInRegion(gray, textRegions.overallBounds);
+            BlurAnalysis blur = assessor_->analyzeBlurInRegion(gray, textRegions.overallBounds);
+            result.blur_score = blur.sharpness;
+            result.blur_type = blur.type;
+            result.blur_direction = blur.direction;
+            result.blur_strength = blur.strength;
             result.brightness_score = assessor_->checkBrightnessInRegion(gray, textRegions.overallBounds);
 
             // Track stability using overall corners
@@ -226,6 +720,7 @@ FrameAnalysisResult CaptureEngine::analyzeFrame(
                 QualityScore tempScore = assessor_->assess(frame, textRegions.overallCorners, textRegions.coverageRatio);
                 result.stability_score = tempScore.stability_score;
             }
+            result.stability_score = combineStability(result.stability_score, motion);
 
             result.corner_confidence = textRegions.coverageRatio;
             result.overall_score = result.blur_score * 0.4f + result.brightness_score * 0.2f +
@@ -238,7 +733,11 @@ FrameAnalysisResult CaptureEngine::analyzeFrame(
             } else {
                 gray = frame;
             }
-            result.blur_score = assessor_->detectBlur(gray);
+            BlurAnalysis blur = assessor_->analyzeBlur(gray);
+            result.blur_score = blur.sharpness;
+            result.blur_type = blur.type;
+            result.blur_direction = blur.direction;
+            result.blur_strength = blur.strength;
             result.brightness_score = assessor_->checkBrightness(gray);
         }
 
@@ -248,6 +747,62 @@ FrameAnalysisResult CaptureEngine::analyzeFrame(
                                result.stability_score > 0.9f;
     }
 
+    // Focus/metering point and exposure compensation from the page region
+    std::vector<cv::Point2f> hintRoi;
+    if (result.document_found || result.text_region_found) {
+        for (int i = 0; i < 4; i++) {
+            hintRoi.push_back(cv::Point2f(result.corners[i * 2], result.corners[i * 2 + 1]) * detection.scale);
+        }
+    }
+    CameraHints hints = camera_advisor_->advise(detection.gray, hintRoi);
+    result.focus_x = hints.focus_x;
+    result.focus_y = hints.focus_y;
+    result.focus_on_tile = hints.focus_on_tile;
+    result.exposure_ev = hints.exposure_ev;
+
+    // Screen capture check on one full-resolution patch of the document
+    result.moire_score = moire_detector_->score(
+        frame, detection.found ? detection.corners : std::vector<cv::Point2f>());
+
+    // QR/barcode candidates on the detection gray (decoded by the host at full resolution)
+    if (barcode_detection_) {
+        std::vector<CodeRegion> codes = barcode_locator_->locate(detection.gray, 4);
+        const float inv = 1.0f / detection.scale;
+        result.code_count = static_cast<int>(codes.size());
+        for (size_t i = 0; i < codes.size(); i++) {
+            result.code_types[i] = codes[i].type;
+            result.code_regions[i * 4 + 0] = codes[i].bounds.x * inv;
+            result.code_regions[i * 4 + 1] = codes[i].bounds.y * inv;
+            result.code_regions[i * 4 + 2] = codes[i].bounds.width * inv;
+            result.code_regions[i * 4 + 3] = codes[i].bounds.height * inv;
+            result.code_scores[i] = codes[i].score;
+        }
+    }
+
+    // Continuous scan: track content change on the document ROI thumbnail
+    if (continuous_scan_) {
+        std::vector<cv::Point2f> roi;
+        if (detection.found && detection.corners.size() == 4) {
+            for (const auto& pt : detection.corners) {
+                roi.push_back(pt * detection.scale);
+            }
+        }
+
+        cv::Mat thumb = PageTurnDetector::makeThumbnail(detection.gray, roi);
+        bool qualityOk = result.blur_score > 0.6f && result.brightness_score > 0.5f;
+        ScanEvent scan = page_turn_->update(thumb, qualityOk);
+
+        result.scan_state = scan.state;
+        result.scan_trigger = scan.capture_trigger;
+        result.scan_change_score = scan.change_score;
+        result.scan_motion_score = scan.motion_score;
+    }
+
+    // Throttle hint for the host capture loop
+    RateAdvice rate = rate_governor_->update(detection.gray, result.document_found, result.capture_ready);
+    result.recommended_fps = rate.fps;
+    result.rate_state = rate.state;
+
     // Store result for use in enhanceImageWithGuideFrame
     last_analysis_ = result;
 
@@ -282,6 +837,25 @@ EnhancementResult CaptureEngine::enhanceImage(
         return result;
     }
 
+    std::vector<cv::Point2f> quad = {
+        cv::Point2f(corners[0], corners[1]),
+        cv::Point2f(corners[2], corners[3]),
+        cv::Point2f(corners[4], corners[5]),
+        cv::Point2f(corners[6], corners[7])
+    };
+
+    // AUTO: route by document type (preview classification, else this image)
+    DocumentType docType = DOC_TYPE_UNKNOWN;
+    cv::Size autoSize(0, 0);
+    if (options.enhance_mode == ENHANCE_AUTO) {
+        float aspect = DocumentDetector::estimateAspect(quad, frame.size());
+        docType = static_cast<DocumentType>(last_analysis_.document_type);
+        if (docType == DOC_TYPE_UNKNOWN) {
+            docType = classifier_->classify(frame, quad, aspect).type;
+        }
+        autoSize = DocumentClassifier::outputSize(docType, aspect > 1.0f);
+    }
+
     cv::Mat processed = frame;
 
     // Apply simple rectangular crop
@@ -314,6 +888,9 @@ EnhancementResult CaptureEngine::enhanceImage(
         };
 
         cv::Size outputSize(options.output_width, options.output_height);
+        if (outputSize.width == 0 || outputSize.height == 0) {
+            outputSize = autoSize;  // Type's scan resolution (exact aspect)
+        }
         CorrectionResult correction = corrector_->correct(processed, cornerPoints, outputSize);
 
         if (correction.success) {
@@ -329,11 +906,20 @@ EnhancementResult CaptureEngine::enhanceImage(
         cv::cvtColor(processed, processed, cv::COLOR_BGRA2BGR);
     }
 
-    // Apply auto enhancement (CLAHE + brightness)
+    // Remove screen moire before any contrast step amplifies it
+    if (options.apply_moire_removal && enhancer_) {
+        processed = enhancer_->removeMoire(processed);
+    }
+
+    // Brightness joins the tone stage only when nothing runs in between:
+    // the offset stops commuting with the unsharp mask once values clip
+    const bool fuseBrightness = options.apply_auto_enhance && !options.apply_sharpening;
+
+    // Apply auto enhancement (CLAHE + brightness unless fused)
     if (options.apply_auto_enhance && enhancer_) {
         EnhanceConfig enhanceConfig;
         enhanceConfig.apply_clahe = true;
-        enhanceConfig.apply_brightness_adjust = true;
+        enhanceConfig.apply_brightness_adjust = !fuseBrightness;
         enhanceConfig.apply_sharpening = false;
         enhanceConfig.clahe_clip_limit = 2.0f;
         enhanceConfig.clahe_tile_size = 8;
@@ -347,46 +933,243 @@ EnhancementResult CaptureEngine::enhanceImage(
         processed = enhancer_->sharpen(processed, options.sharpening_strength);
     }
 
-    // Apply OCR enhancement mode
-    if (enhancer_) {
-        switch (options.enhance_mode) {
-            case ENHANCE_WHITEN_BG:
-                processed = enhancer_->whitenBackground(processed, 200);
-                break;
-            case ENHANCE_CONTRAST_STRETCH:
-                processed = enhancer_->stretchContrast(processed);
-                break;
-            case ENHANCE_ADAPTIVE_BINARIZE:
-                processed = enhancer_->adaptiveBinarize(processed, 11, 2);
-                break;
-            case ENHANCE_SAUVOLA:
-                processed = enhancer_->sauvolaBinarize(processed, 15, 0.2, 128);
-                break;
-            case ENHANCE_NONE:
-            default:
-                break;
+    // Apply OCR enhancement mode (AUTO: chain chosen by document type)
+    processed = applyEnhanceMode(processed,
+                                 options.enhance_mode == ENHANCE_AUTO ? autoEnhanceMode(docType)
+                                                                      : options.enhance_mode,
+                                 fuseBrightness);
+
+    // Allocate output buffer
+    fillResult(result, processed);
+    fillLevels(result, processed, options.level_sizes);
+    return result;
+}
+
+TableAnalysisResult CaptureEngine::analyzeTable(
+    const uint8_t* image_data,
+    int width,
+    int height,
+    int format,
+    const float* corners
+) {
+    if (!image_data || width <= 0 || height <= 0) {
+        return TableAnalysisResult();
+    }
+
+    // Rectify first so ruling lines are axis-aligned
+    cv::Mat page = rectifyPage(bufferToMat(image_data, width, height, format), corners);
+
+    if (page.empty()) {
+        return TableAnalysisResult();
+    }
+
+    return table_analyzer_->analyze(page);
+}
+
+TextLineBatch CaptureEngine::exportTextLines(
+    const uint8_t* image_data,
+    int width,
+    int height,
+    int format,
+    const float* corners,
+    int line_height
+) {
+    TextLineBatch batch;
+
+    if (!image_data || width <= 0 || height <= 0) {
+        strncpy(batch.error_message, "Invalid image data", sizeof(batch.error_message) - 1);
+        return batch;
+    }
+
+    cv::Mat page = rectifyPage(bufferToMat(image_data, width, height, format), corners);
+
+    if (page.empty()) {
+        strncpy(batch.error_message, "Perspective correction failed", sizeof(batch.error_message) - 1);
+        return batch;
+    }
+
+    return line_extractor_->extract(page, line_height);
+}
+
+bool CaptureEngine::beginStitching(int output_width, int max_height) {
+    return stitcher_->begin(output_width, max_height);
+}
+
+StitchStatus CaptureEngine::addStitchFrame(
+    const uint8_t* image_data,
+    int width,
+    int height,
+    int format,
+    int rotation,
+    const float* corners
+) {
+    if (!image_data || width <= 0 || height <= 0 || !stitcher_->isActive()) {
+        return StitchStatus();
+    }
+
+    cv::Mat frame = bufferToMat(image_data, width, height, format);
+    applyRotation(frame, rotation);
+
+    std::vector<cv::Point2f> cornerPoints;
+    if (corners) {
+        for (int i = 0; i < 4; i++) {
+            cornerPoints.push_back(cv::Point2f(corners[i * 2], corners[i * 2 + 1]));
+        }
+    } else {
+        // Track the receipt edges; fall back to the whole frame
+        DetectionResult detection = activeDetector().detect(frame);
+        if (detection.found && detection.corners.size() == 4) {
+            cornerPoints = detection.corners;
         }
     }
 
-    // Allocate output buffer
-    result.width = processed.cols;
-    result.height = processed.rows;
-    result.channels = processed.channels();
-    result.stride = static_cast<int>(processed.step);
+    return stitcher_->addFrame(frame, cornerPoints);
+}
 
-    size_t dataSize = processed.total() * processed.elemSize();
-    result.image_data = new uint8_t[dataSize];
-    memcpy(result.image_data, processed.data, dataSize);
+EnhancementResult CaptureEngine::finishStitching() {
+    EnhancementResult result;
 
-    result.success = true;
+    cv::Mat stitched = stitcher_->finish();
+    if (stitched.empty()) {
+        strncpy(result.error_message, "No stitched content", sizeof(result.error_message) - 1);
+        return result;
+    }
+
+    fillResult(result, stitched);
     return result;
 }
 
+void CaptureEngine::cancelStitching() {
+    stitcher_->cancel();
+}
+
+EnhancementResult CaptureEngine::removeGlare(
+    const uint8_t* const* images,
+    int count,
+    int width,
+    int height,
+    int format,
+    const float* corners,
+    int output_width,
+    int output_height
+) {
+    EnhancementResult result;
+
+    if (!images || !corners || count <= 0 || width <= 0 || height <= 0) {
+        strncpy(result.error_message, "Invalid image data", sizeof(result.error_message) - 1);
+        return result;
+    }
+
+    count = std::min(count, GlareCompositor::MAX_FRAMES);
+
+    std::vector<cv::Mat> frames;
+    std::vector<std::vector<cv::Point2f>> quads;
+    for (int i = 0; i < count; i++) {
+        if (!images[i]) continue;
+
+        // Frames are only read by remap; wrap without copying (RGB is swapped once at the end)
+        int type = (format == 0) ? CV_8UC4 : CV_8UC3;
+        frames.push_back(cv::Mat(height, width, type, const_cast<uint8_t*>(images[i])));
+
+        const float* c = corners + i * 8;
+        quads.push_back({
+            cv::Point2f(c[0], c[1]),
+            cv::Point2f(c[2], c[3]),
+            cv::Point2f(c[4], c[5]),
+            cv::Point2f(c[6], c[7])
+        });
+    }
+
+    cv::Mat composite = glare_compositor_->composite(frames, quads, cv::Size(output_width, output_height));
+
+    if (composite.empty()) {
+        strncpy(result.error_message, "Glare compositing failed", sizeof(result.error_message) - 1);
+        return result;
+    }
+
+    if (format == 2) {
+        cv::cvtColor(composite, composite, cv::COLOR_RGB2BGR);
+    }
+
+    fillResult(result, composite);
+    return result;
+}
+
+uint64_t CaptureEngine::computePageHash(
+    const uint8_t* image_data,
+    int width,
+    int height,
+    int format,
+    const float* corners
+) {
+    if (!image_data || width <= 0 || height <= 0) {
+        return 0;
+    }
+
+    // Wrap without copying; the hasher only reads a downscaled version
+    cv::Mat frame;
+    if (format == 0) {
+        frame = cv::Mat(height, width, CV_8UC4, const_cast<uint8_t*>(image_data));
+    } else {
+        // RGB vs BGR order only shifts gray weights; hashes stay comparable
+        frame = cv::Mat(height, width, CV_8UC3, const_cast<uint8_t*>(image_data));
+    }
+
+    std::vector<cv::Point2f> cornerPoints;
+    if (corners) {
+        for (int i = 0; i < 4; i++) {
+            cornerPoints.push_back(cv::Point2f(corners[i * 2], corners[i * 2 + 1]));
+        }
+    }
+
+    return PageHasher::computeHash(frame, cornerPoints);
+}
+
+DuplicateMatch CaptureEngine::findDuplicatePage(uint64_t hash, int max_distance) const {
+    return page_index_->findDuplicate(hash, max_distance);
+}
+
+int CaptureEngine::registerPage(uint64_t hash) {
+    return page_index_->add(hash);
+}
+
+bool CaptureEngine::removePage(int page_id) {
+    return page_index_->remove(page_id);
+}
+
+void CaptureEngine::clearPages() {
+    page_index_->clear();
+}
+
+cv::Mat CaptureEngine::rectifyPage(const cv::Mat& frame, const float* corners) {
+    if (frame.empty() || !corners) {
+        return frame;
+    }
+
+    std::vector<cv::Point2f> cornerPoints = {
+        cv::Point2f(corners[0], corners[1]),
+        cv::Point2f(corners[2], corners[3]),
+        cv::Point2f(corners[4], corners[5]),
+        cv::Point2f(corners[6], corners[7])
+    };
+
+    CorrectionResult correction = corrector_->correct(frame, cornerPoints);
+    return correction.success ? correction.image : cv::Mat();
+}
+
 void CaptureEngine::freeEnhancementResult(EnhancementResult* result) {
-    if (result && result->image_data) {
-        delete[] result->image_data;
-        result->image_data = nullptr;
+    if (!result) {
+        return;
+    }
+
+    delete[] result->image_data;
+    result->image_data = nullptr;
+
+    for (int i = 0; i < MAX_OUTPUT_LEVELS; i++) {
+        delete[] result->level_data[i];
+        result->level_data[i] = nullptr;
     }
+    result->level_count = 0;
 }
 
 void CaptureEngine::calculateVirtualTrapezoid(
@@ -484,13 +1267,7 @@ EnhancementResult CaptureEngine::enhanceImageWithGuideFrame(
     }
 
     // Apply rotation if needed (SIMD optimized via OpenCV)
-    if (rotation == 90) {
-        cv::rotate(frame, frame, cv::ROTATE_90_CLOCKWISE);
-    } else if (rotation == 180) {
-        cv::rotate(frame, frame, cv::ROTATE_180);
-    } else if (rotation == 270) {
-        cv::rotate(frame, frame, cv::ROTATE_90_COUNTERCLOCKWISE);
-    }
+    applyRotation(frame, rotation);
 
     // Calculate virtual trapezoid corners from guide frame
     float corners[8];
@@ -546,42 +1323,48 @@ EnhancementResult CaptureEngine::enhanceImageWithGuideFrame(
         cv::cvtColor(processed, processed, cv::COLOR_BGRA2BGR);
     }
 
+    if (adjusted_options.apply_moire_removal && enhancer_) {
+        processed = enhancer_->removeMoire(processed);
+    }
+
     // Apply sharpening
     if (adjusted_options.apply_sharpening && enhancer_) {
         processed = enhancer_->sharpen(processed, adjusted_options.sharpening_strength);
     }
 
     // Apply OCR enhancement mode
-    if (enhancer_) {
-        switch (adjusted_options.enhance_mode) {
-            case ENHANCE_WHITEN_BG:
-                processed = enhancer_->whitenBackground(processed, 200);
-                break;
-            case ENHANCE_CONTRAST_STRETCH:
-                processed = enhancer_->stretchContrast(processed);
-                break;
-            case ENHANCE_ADAPTIVE_BINARIZE:
-                processed = enhancer_->adaptiveBinarize(processed, 11, 2);
-                break;
-            case ENHANCE_SAUVOLA:
-                processed = enhancer_->sauvolaBinarize(processed, 15, 0.2, 128);
-                break;
-            case ENHANCE_NONE:
-            default:
-                break;
-        }
+    EnhanceMode mode = adjusted_options.enhance_mode;
+    if (mode == ENHANCE_AUTO) {
+        mode = autoEnhanceMode(static_cast<DocumentType>(last_analysis_.document_type));
     }
+    processed = applyEnhanceMode(processed, mode);
 
     // Allocate output buffer
-    result.width = processed.cols;
-    result.height = processed.rows;
-    result.channels = processed.channels();
-    result.stride = static_cast<int>(processed.step);
+    fillResult(result, processed);
+    fillLevels(result, processed, adjusted_options.level_sizes);
+    return result;
+}
 
-    size_t dataSize = processed.total() * processed.elemSize();
-    result.image_data = new uint8_t[dataSize];
-    memcpy(result.image_data, processed.data, dataSize);
+bool CaptureEngine::prepareCornerSnapping(const uint8_t* image_data, int width, int height, int format) {
+    if (!image_data || width <= 0 || height <= 0) {
+        snapper_->clear();
+        return false;
+    }
 
-    result.success = true;
-    return result;
+    // bufferToMat already owns a copy; snapper keeps it for magnifier patches
+    cv::Mat frame = bufferToMat(image_data, width, height, format);
+    return snapper_->prepare(frame);
+}
+
+SnapResult CaptureEngine::snapCorner(float x, float y, float radius, SnapMode mode) const {
+    return snapper_->snap(x, y, radius, mode);
+}
+
+int CaptureEngine::getMagnifierPatch(float x, float y, int radius, int out_size,
+                                     uint8_t* out, int out_capacity) const {
+    return snapper_->extractPatch(x, y, radius, out_size, out, out_capacity);
+}
+
+void CaptureEngine::releaseCornerSnapping() {
+    snapper_->clear();
 }
@@ -4,24 +4,80 @@
 #include <opencv2/opencv.hpp>
 #include <vector>
 #include <memory>
+#include <string>
 
 #include "document_detector.hpp"
+#include "dnn_detector.hpp"
 #include "perspective_corrector.hpp"
 #include "quality_assessor.hpp"
 #include "image_enhancer.hpp"
+#include "edge_snapper.hpp"
+#include "table_analyzer.hpp"
+#include "text_line_extractor.hpp"
+#include "page_hasher.hpp"
+#include "page_turn_detector.hpp"
+#include "receipt_stitcher.hpp"
+#include "glare_compositor.hpp"
+#include "motion_tracker.hpp"
+#include "occlusion_detector.hpp"
+#include "moire_detector.hpp"
+#include "framing_guide.hpp"
+#include "camera_advisor.hpp"
+#include "frame_rate_governor.hpp"
+#include "document_classifier.hpp"
+#include "barcode_locator.hpp"
 
 struct FrameAnalysisResult {
     bool document_found;
-    bool table_found;        // True if table detected (clear rectangular border)
+    bool table_found;        // True if clear rectangular border detected (see analyzeTable for grid)
     bool text_region_found;  // True if text region detected (fallback when no document)
     float corners[8];  // x0,y0,x1,y1,x2,y2,x3,y3 (TL,TR,BR,BL)
     float corner_confidence;
+    float document_aspect;   // Estimated true width/height of the page (perspective removed)
+    int document_type;       // DocumentType (voted over recent frames)
+    float document_type_confidence;
     float blur_score;
+    int blur_type;           // BlurType: 0 sharp, 1 defocus, 2 motion
+    float blur_direction;    // Motion direction in degrees [0,180), 0 = horizontal
+    float blur_strength;     // 0-1
     float brightness_score;
     float stability_score;
     float overall_score;
     bool capture_ready;
 
+    // Finger/hand occlusion of the document edges
+    int occluded_edges;      // OccludedEdge bitmask (1 top, 2 right, 4 bottom, 8 left)
+    float occlusion_score;   // 0-1, max skin coverage along an edge
+
+    float moire_score;       // 0-1, periodic screen pattern (photographed display)
+
+    // QR/barcode candidate regions (barcode detection enabled only)
+    int code_count;
+    int code_types[4];       // CodeType
+    float code_regions[16];  // x,y,w,h per region in frame coordinates
+    float code_scores[4];
+
+    // Framing guidance (document found only)
+    int guidance;            // GuidanceCode
+    float fill_ratio;        // Quad area / frame area
+    float target_fill;
+    float center_offset_x;   // -1..1
+    float center_offset_y;
+    float tilt_x;            // Degrees (top/bottom keystone)
+    float tilt_y;            // Degrees (left/right keystone)
+    float rotation_angle;    // Degrees, in-plane
+    float text_px;           // Estimated body text height in frame pixels
+
+    // Camera control hints (coordinates normalized to the analyzed frame)
+    float focus_x;           // Recommended focus/metering point, 0-1
+    float focus_y;
+    bool focus_on_tile;      // Point is the softest text tile rather than the page center
+    float exposure_ev;       // Suggested exposure compensation (EV)
+
+    // Power saving: analysis rate the host should run at
+    int recommended_fps;
+    int rate_state;          // RateState
+
     // Table/Trapezoid detection
     bool is_trapezoid;       // True if shape is trapezoid (needs perspective correction)
     float skew_ratio;        // Overall skew ratio (max of vertical and horizontal)
@@ -38,17 +94,56 @@ struct FrameAnalysisResult {
     float overall_bounds[4];        // x,y,w,h of all regions combined
     float coverage_ratio;           // Total text area / frame area
 
+    // Continuous (book) scan mode
+    int scan_state;                 // ScanState (0 when mode is off)
+    bool scan_trigger;              // True when a new settled page should be captured
+    float scan_change_score;        // 0-1, difference from last captured page
+    float scan_motion_score;        // 0-1, frame-to-frame content change
+
+    // IMU motion (see pushImuSample)
+    bool imu_active;                // Recent gyro/accel samples were pushed
+    float imu_motion_score;         // 0-1, device motion (0 = still)
+    bool analysis_skipped;          // Fast motion: frame not analyzed, geometry is from last frame
+
     FrameAnalysisResult() {
         document_found = false;
         table_found = false;
         text_region_found = false;
         memset(corners, 0, sizeof(corners));
         corner_confidence = 0;
+        document_aspect = 0;
+        document_type = DOC_TYPE_UNKNOWN;
+        document_type_confidence = 0;
         blur_score = 0;
+        blur_type = BLUR_NONE;
+        blur_direction = 0;
+        blur_strength = 0;
         brightness_score = 0;
         stability_score = 0;
         overall_score = 0;
         capture_ready = false;
+        occluded_edges = 0;
+        occlusion_score = 0;
+        moire_score = 0;
+        code_count = 0;
+        memset(code_types, 0, sizeof(code_types));
+        memset(code_regions, 0, sizeof(code_regions));
+        memset(code_scores, 0, sizeof(code_scores));
+        guidance = GUIDE_NONE;
+        fill_ratio = 0;
+        target_fill = 0;
+        center_offset_x = 0;
+        center_offset_y = 0;
+        tilt_x = 0;
+        tilt_y = 0;
+        rotation_angle = 0;
+        text_px = 0;
+        focus_x = 0.5f;
+        focus_y = 0.5f;
+        focus_on_tile = false;
+        exposure_ev = 0;
+        recommended_fps = 0;
+        rate_state = RATE_ACTIVE;
         is_trapezoid = false;
         skew_ratio = 0;
         top_width = 0;
@@ -61,6 +156,13 @@ struct FrameAnalysisResult {
         memset(text_regions_bounds, 0, sizeof(text_regions_bounds));
         memset(overall_bounds, 0, sizeof(overall_bounds));
         coverage_ratio = 0;
+        scan_state = SCAN_OFF;
+        scan_trigger = false;
+        scan_change_score = 0;
+        scan_motion_score = 0;
+        imu_active = false;
+        imu_motion_score = 0;
+        analysis_skipped = false;
     }
 };
 
@@ -70,19 +172,25 @@ enum EnhanceMode {
     ENHANCE_WHITEN_BG = 1,        // Background whitening
     ENHANCE_CONTRAST_STRETCH = 2,  // Contrast stretching
     ENHANCE_ADAPTIVE_BINARIZE = 3, // Adaptive binarization
-    ENHANCE_SAUVOLA = 4            // Sauvola binarization
+    ENHANCE_SAUVOLA = 4,           // Sauvola binarization
+    ENHANCE_AUTO = 5               // Chain and output size chosen by document type
 };
 
+// Extra downscaled outputs per enhancement call (display image, thumbnail)
+const int MAX_OUTPUT_LEVELS = 3;
+
 struct EnhancementOptions {
     bool apply_crop;                    // Simple rectangular crop
     bool apply_perspective_correction;  // Perspective transform (for trapezoid -> rectangle)
     bool apply_deskew;
     bool apply_auto_enhance;            // CLAHE + brightness
     bool apply_sharpening;              // Sharpening (independent)
+    bool apply_moire_removal;           // Notch filter for photographed screens
     float sharpening_strength;          // Sharpening strength 0.0 - 1.0+
     EnhanceMode enhance_mode;           // OCR enhancement mode
     int output_width;   // 0 = auto
     int output_height;  // 0 = auto
+    int level_sizes[MAX_OUTPUT_LEVELS];  // Long side of extra outputs in px (0 = unused)
 
     EnhancementOptions() {
         apply_crop = false;
@@ -90,10 +198,12 @@ struct EnhancementOptions {
         apply_deskew = false;
         apply_auto_enhance = false;
         apply_sharpening = false;
+        apply_moire_removal = false;
         sharpening_strength = 0.5f;
         enhance_mode = ENHANCE_NONE;
         output_width = 0;
         output_height = 0;
+        memset(level_sizes, 0, sizeof(level_sizes));
     }
 };
 
@@ -106,6 +216,13 @@ struct EnhancementResult {
     bool success;
     char error_message[256];
 
+    // Downscaled copies of the page, in level_sizes order (unused sizes skipped)
+    int level_count;
+    uint8_t* level_data[MAX_OUTPUT_LEVELS];
+    int level_width[MAX_OUTPUT_LEVELS];
+    int level_height[MAX_OUTPUT_LEVELS];
+    int level_stride[MAX_OUTPUT_LEVELS];
+
     EnhancementResult() {
         image_data = nullptr;
         width = 0;
@@ -114,9 +231,29 @@ struct EnhancementResult {
         stride = 0;
         success = false;
         error_message[0] = '\0';
+        level_count = 0;
+        memset(level_data, 0, sizeof(level_data));
+        memset(level_width, 0, sizeof(level_width));
+        memset(level_height, 0, sizeof(level_height));
+        memset(level_stride, 0, sizeof(level_stride));
     }
 };
 
+// Startup latency instrumentation (warm-up frames are not counted)
+struct StartupStats {
+    float construct_ms;               // Engine constructor
+    float warmup_ms;                  // Last warmUp call (0 if never called)
+    float create_to_first_result_ms;  // Constructor start to first analyzeFrame result
+    float first_analysis_ms;          // Duration of the first analyzeFrame
+    float steady_analysis_ms;         // Running average of later frames
+    int analyzed_frames;
+    bool warmed_up;
+
+    StartupStats()
+        : construct_ms(0), warmup_ms(0), create_to_first_result_ms(0), first_analysis_ms(0),
+          steady_analysis_ms(0), analyzed_frames(0), warmed_up(false) {}
+};
+
 class CaptureEngine {
 public:
     CaptureEngine();
@@ -135,6 +272,18 @@ public:
         int crop_h = 0
     );
 
+    // Prime the engine for a camera stream of the declared size/format:
+    // sizes the ingest buffers and runs the analysis and enhancement
+    // paths on a synthetic page (the shared thread pool is started on
+    // first engine creation). Tracking
+    // state is reset afterwards. Call before streaming, not concurrently
+    // with analyzeFrame. Returns the warm-up duration in ms (-1 on bad input).
+    float warmUp(int width, int height, int format, int rotation = 0);
+    const StartupStats& startupStats() const { return startup_; }
+
+    // Free the reused stream buffers (pooled engines between jobs)
+    void releaseStreamBuffers();
+
     // Stage 2: Post-capture enhancement (legacy - corners provided by caller)
     EnhancementResult enhanceImage(
         const uint8_t* image_data,
@@ -160,17 +309,160 @@ public:
         int rotation = 0  // 0: none, 90: clockwise, 180, 270: counter-clockwise
     );
 
+    // Table grid extraction on the rectified page
+    // corners: 8 floats (TL,TR,BR,BL) to rectify first, or nullptr if already rectified
+    TableAnalysisResult analyzeTable(
+        const uint8_t* image_data,
+        int width,
+        int height,
+        int format,
+        const float* corners
+    );
+
+    // OCR-ready text-line crops (gray, normalized height) packed in one buffer
+    // corners: 8 floats (TL,TR,BR,BL) to rectify first, or nullptr if already rectified
+    TextLineBatch exportTextLines(
+        const uint8_t* image_data,
+        int width,
+        int height,
+        int format,
+        const float* corners,
+        int line_height = 48
+    );
+
+    // Duplicate page detection (multi-page sessions)
+    // Perceptual hash of the page thumbnail; corners may be nullptr for whole image
+    uint64_t computePageHash(const uint8_t* image_data, int width, int height, int format,
+                             const float* corners);
+    DuplicateMatch findDuplicatePage(uint64_t hash, int max_distance = 10) const;
+    int registerPage(uint64_t hash);
+    bool removePage(int page_id);
+    void clearPages();
+
+    // Long receipt stitching (pan top-to-bottom along the receipt)
+    bool beginStitching(int output_width, int max_height);
+    // corners: receipt quad (8 floats) or nullptr to track it with the detector
+    StitchStatus addStitchFrame(
+        const uint8_t* image_data,
+        int width,
+        int height,
+        int format,
+        int rotation,
+        const float* corners
+    );
+    EnhancementResult finishStitching();
+    void cancelStitching();
+
+    // Multi-frame glare removal: composite frames in the rectified domain
+    // images: count frames of equal size/format; corners: count * 8 floats
+    EnhancementResult removeGlare(
+        const uint8_t* const* images,
+        int count,
+        int width,
+        int height,
+        int format,
+        const float* corners,
+        int output_width = 0,
+        int output_height = 0
+    );
+
     // Get last analysis result
     const FrameAnalysisResult& getLastAnalysis() const { return last_analysis_; }
 
-    // Free enhancement result memory
-    void freeEnhancementResult(EnhancementResult* result);
+    // Free enhancement result memory (image and levels)
+    static void freeEnhancementResult(EnhancementResult* result);
+
+    // Manual corner editor: cache gradient/corner maps once per captured image
+    bool prepareCornerSnapping(const uint8_t* image_data, int width, int height, int format);
+    SnapResult snapCorner(float x, float y, float radius, SnapMode mode = SNAP_MODE_AUTO) const;
+    int getMagnifierPatch(float x, float y, int radius, int out_size,
+                          uint8_t* out, int out_capacity) const;
+    void releaseCornerSnapping();
 
     // Reset state (e.g., stability history)
     void reset();
 
+    // Reset everything a caller can leave behind: tracking state, last
+    // analysis, page index, stitching session, IMU samples and all settings.
+    // Used when an engine passes to another session.
+    void resetSession();
+
+    // Continuous scan: emit scan_trigger each time a new page settles
+    void setContinuousScan(bool enabled);
+    bool isContinuousScan() const { return continuous_scan_; }
+
+    // Known document format: constrains detection to the aspect (perspective-aware)
+    // and makes auto-sized perspective output exactly that aspect
+    // custom_aspect: long/short for PROFILE_CUSTOM
+    void setDocumentProfile(DocumentProfile profile, float custom_aspect = 0.0f);
+
+    // Document detector backend (classical by default)
+    // The DNN backend needs a model file loaded first; returns false otherwise
+    bool loadDetectorModel(const std::string& model_path, int input_size = 256);
+    bool setDetectorBackend(DetectorBackendType backend);
+    DetectorBackendType detectorBackend() const { return detector_backend_; }
+
+    // Latency and accuracy of every backend on the same frames
+    // ground_truth: count * 8 floats (TL,TR,BR,BL per frame), or nullptr to
+    // use the classical backend's corners as the reference
+    std::vector<DetectorBenchmark> benchmarkDetectors(
+        const uint8_t* const* images,
+        int count,
+        int width,
+        int height,
+        int format,
+        const float* ground_truth,
+        int iterations = 3
+    );
+
+    // Bounds for recommended_fps (values <= 0 keep the current setting)
+    void setFrameRateLimits(int min_fps, int max_fps);
+
+    // Framing guidance targets (fill ratio of the frame, minimum text height in frame px)
+    void setFramingTarget(float target_fill, float min_text_px);
+
+    // Locate QR/barcode regions in analyzeFrame so hosts can decode instead of OCR (default off)
+    void setBarcodeDetection(bool enabled) { barcode_detection_ = enabled; }
+
+    // Occluded document edges block capture_ready (default on)
+    void setOcclusionVeto(bool enabled) { occlusion_veto_ = enabled; }
+
+    // IMU samples (may be called from a sensor thread)
+    // Stability combines device motion with corner tracking; during fast
+    // motion analyzeFrame skips image analysis entirely.
+    void pushImuSample(ImuSampleType type, float x, float y, float z, int64_t timestamp_ns);
+
 private:
     cv::Mat bufferToMat(const uint8_t* data, int width, int height, int format);
+    // Same conversion into a reused buffer (no allocation at a steady stream size)
+    static void ingestFrame(const uint8_t* data, int width, int height, int format, cv::Mat& dst);
+    FrameAnalysisResult analyzeFrameImpl(
+        const uint8_t* image_data,
+        int width,
+        int height,
+        int format,
+        int rotation,
+        int crop_x,
+        int crop_y,
+        int crop_w,
+        int crop_h
+    );
+    static void applyRotation(cv::Mat& frame, int rotation);
+    static void fillResult(EnhancementResult& result, const cv::Mat& image);
+    static void fillLevels(EnhancementResult& result, const cv::Mat& image, const int* sizes);
+    DetectorBackend& activeDetector();
+
+    // Stability from corner tracking, tightened/relaxed by IMU motion
+    static float combineStability(float image_stability, const MotionState& motion);
+
+    // Enhancement routing by document type
+    static EnhanceMode autoEnhanceMode(DocumentType type);
+    // Point-wise steps (auto-enhance brightness, whitening, stretch) run as
+    // one fused tone curve; binarization modes run on its output
+    cv::Mat applyEnhanceMode(const cv::Mat& image, EnhanceMode mode, bool autoBrightness = false);
+
+    // Rectify page from 8 corner floats (returns input if corners is nullptr)
+    cv::Mat rectifyPage(const cv::Mat& frame, const float* corners);
 
     // Calculate virtual trapezoid corners from guide frame using last analysis
     void calculateVirtualTrapezoid(
@@ -179,11 +471,41 @@ private:
     );
 
     std::unique_ptr<DocumentDetector> detector_;
+    std::unique_ptr<DnnDetector> dnn_detector_;
     std::unique_ptr<PerspectiveCorrector> corrector_;
     std::unique_ptr<QualityAssessor> assessor_;
     std::unique_ptr<ImageEnhancer> enhancer_;
+    std::unique_ptr<EdgeSnapper> snapper_;
+    std::unique_ptr<TableAnalyzer> table_analyzer_;
+    std::unique_ptr<TextLineExtractor> line_extractor_;
+    std::unique_ptr<PageHashIndex> page_index_;
+    std::unique_ptr<PageTurnDetector> page_turn_;
+    std::unique_ptr<ReceiptStitcher> stitcher_;
+    std::unique_ptr<GlareCompositor> glare_compositor_;
+    std::unique_ptr<MotionTracker> motion_tracker_;
+    std::unique_ptr<OcclusionDetector> occlusion_detector_;
+    std::unique_ptr<MoireDetector> moire_detector_;
+    std::unique_ptr<FramingGuide> framing_guide_;
+    std::unique_ptr<CameraAdvisor> camera_advisor_;
+    std::unique_ptr<FrameRateGovernor> rate_governor_;
+    std::unique_ptr<DocumentClassifier> classifier_;
+    std::unique_ptr<BarcodeLocator> barcode_locator_;
+
+    DetectorBackendType detector_backend_ = DETECTOR_CLASSICAL;
+    bool continuous_scan_ = false;
+    bool occlusion_veto_ = true;
+    bool barcode_detection_ = false;
 
     FrameAnalysisResult last_analysis_;  // Store last analysis for enhance
+
+    // Stream buffers reused across analyzeFrame calls
+    cv::Mat ingest_buffer_;
+    cv::Mat rotated_buffer_;
+    cv::Mat crop_buffer_;
+
+    int64_t created_tick_ = 0;
+    bool warming_up_ = false;
+    StartupStats startup_;
 };
 
 #endif // CAPTURE_ENGINE_HPP
@@ -0,0 +1,324 @@
+// Desktop batch processor: runs every photo under a directory through the
+// same detection, correction and enhancement code as the app.
+//
+//   document_capture_cli <input_dir> <output_dir> [options]
+//
+// Outputs mirror the input tree; each image gets a <name>.json report.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "capture_engine.hpp"
+#include "engine_pool.hpp"
+#include "shared_resources.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct CliOptions {
+    fs::path input_dir;
+    fs::path output_dir;
+    EnhanceMode mode = ENHANCE_AUTO;
+    int jobs = 0;                  // 0 = hardware threads
+    float sharpen = 0.5f;          // 0 disables sharpening
+    int output_width = 0;
+    int output_height = 0;
+    std::string extension = ".png";
+    int memory_mb = 1024;
+};
+
+struct FileOutcome {
+    bool success = false;
+    double megapixels = 0;
+};
+
+void printUsage(const char* argv0) {
+    fprintf(stderr,
+            "Usage: %s <input_dir> <output_dir> [options]\n"
+            "  --mode M        none|whiten|contrast|binarize|sauvola|auto (default auto)\n"
+            "  --jobs N        Parallel workers (default: CPU cores)\n"
+            "  --sharpen S     Sharpening strength, 0 = off (default 0.5)\n"
+            "  --size WxH      Output size (default: from page geometry)\n"
+            "  --ext png|jpg   Output image format (default png)\n"
+            "  --memory-mb M   Memory budget for in-flight photos (default 1024)\n",
+            argv0);
+}
+
+bool parseMode(const std::string& name, EnhanceMode& mode) {
+    static const struct { const char* name; EnhanceMode mode; } MODES[] = {
+        {"none", ENHANCE_NONE},
+        {"whiten", ENHANCE_WHITEN_BG},
+        {"contrast", ENHANCE_CONTRAST_STRETCH},
+        {"binarize", ENHANCE_ADAPTIVE_BINARIZE},
+        {"sauvola", ENHANCE_SAUVOLA},
+        {"auto", ENHANCE_AUTO},
+    };
+    for (const auto& m : MODES) {
+        if (name == m.name) {
+            mode = m.mode;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseArgs(int argc, char** argv, CliOptions& opts) {
+    std::vector<std::string> positional;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--mode" && hasValue) {
+            if (!parseMode(argv[++i], opts.mode)) return false;
+        } else if (arg == "--jobs" && hasValue) {
+            opts.jobs = std::max(0, atoi(argv[++i]));
+        } else if (arg == "--sharpen" && hasValue) {
+            opts.sharpen = std::max(0.0f, static_cast<float>(atof(argv[++i])));
+        } else if (arg == "--size" && hasValue) {
+            if (sscanf(argv[++i], "%dx%d", &opts.output_width, &opts.output_height) != 2) return false;
+        } else if (arg == "--ext" && hasValue) {
+            std::string ext = argv[++i];
+            if (ext != "png" && ext != "jpg") return false;
+            opts.extension = "." + ext;
+        } else if (arg == "--memory-mb" && hasValue) {
+            opts.memory_mb = std::max(1, atoi(argv[++i]));
+        } else if (arg.rfind("--", 0) == 0) {
+            return false;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.size() != 2) {
+        return false;
+    }
+
+    opts.input_dir = positional[0];
+    opts.output_dir = positional[1];
+    return true;
+}
+
+bool isImageFile(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(tolower(c)); });
+    return ext == ".jpg" || ext == ".jpeg" || ext == ".png" || ext == ".bmp" ||
+           ext == ".tif" || ext == ".tiff" || ext == ".webp";
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string out;
+    out.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out;
+}
+
+void appendFmt(std::string& out, const char* fmt, ...) {
+    char buf[256];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    out += buf;
+}
+
+void writeReport(
+    const fs::path& reportPath,
+    const fs::path& input,
+    const fs::path& output,
+    const cv::Mat& image,
+    const FrameAnalysisResult& analysis,
+    const EnhancementResult& result,
+    double ms
+) {
+    std::string json = "{";
+    json += "\"input\":\"" + jsonEscape(input.string()) + "\",";
+    json += "\"output\":\"" + jsonEscape(result.success ? output.string() : "") + "\",";
+    json += result.success ? "\"success\":true," : "\"success\":false,";
+    json += "\"error\":\"" + jsonEscape(result.error_message) + "\",";
+    appendFmt(json, "\"width\":%d,\"height\":%d,", image.cols, image.rows);
+    appendFmt(json, "\"output_width\":%d,\"output_height\":%d,", result.width, result.height);
+    json += analysis.document_found ? "\"document_found\":true," : "\"document_found\":false,";
+    json += analysis.text_region_found ? "\"text_region_found\":true," : "\"text_region_found\":false,";
+    json += "\"corners\":[";
+    for (int i = 0; i < 8; i++) {
+        appendFmt(json, i ? ",%.1f" : "%.1f", analysis.corners[i]);
+    }
+    json += "],";
+    appendFmt(json, "\"corner_confidence\":%.3f,", analysis.corner_confidence);
+    appendFmt(json, "\"document_type\":%d,", analysis.document_type);
+    appendFmt(json, "\"blur_score\":%.3f,", analysis.blur_score);
+    appendFmt(json, "\"overall_score\":%.3f,", analysis.overall_score);
+    appendFmt(json, "\"ms\":%.1f", ms);
+    json += "}\n";
+
+    FILE* file = fopen(reportPath.string().c_str(), "wb");
+    if (file) {
+        fwrite(json.data(), 1, json.size(), file);
+        fclose(file);
+    }
+}
+
+FileOutcome processFile(
+    EnginePool& pool,
+    int session,
+    const CliOptions& opts,
+    const EnhancementOptions& enhance,
+    const fs::path& input
+) {
+    auto start = std::chrono::steady_clock::now();
+    FileOutcome outcome;
+
+    fs::path relative = input.lexically_relative(opts.input_dir);
+    fs::path output = opts.output_dir / relative;
+    output.replace_extension(opts.extension);
+    fs::path report = opts.output_dir / relative;
+    report.replace_extension(".json");
+
+    std::error_code ec;
+    fs::create_directories(output.parent_path(), ec);
+
+    FrameAnalysisResult analysis;
+    EnhancementResult result;
+
+    cv::Mat image = cv::imread(input.string(), cv::IMREAD_COLOR);
+    if (image.empty()) {
+        strncpy(result.error_message, "Could not read image", sizeof(result.error_message) - 1);
+    } else {
+        outcome.megapixels = image.total() / 1e6;
+        result = pool.processPhoto(session, image.data, image.cols, image.rows, 1, enhance, &analysis);
+
+        if (result.success) {
+            cv::Mat page(result.height, result.width, CV_8UC(result.channels),
+                         result.image_data, static_cast<size_t>(result.stride));
+            if (!cv::imwrite(output.string(), page)) {
+                result.success = false;
+                strncpy(result.error_message, "Could not write output", sizeof(result.error_message) - 1);
+            }
+        }
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    writeReport(report, input, output, image, analysis, result, ms);
+
+    outcome.success = result.success;
+    CaptureEngine::freeEnhancementResult(&result);
+    return outcome;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    CliOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::error_code ec;
+    if (!fs::is_directory(opts.input_dir, ec)) {
+        fprintf(stderr, "Not a directory: %s\n", opts.input_dir.string().c_str());
+        return 1;
+    }
+
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::recursive_directory_iterator(opts.input_dir, ec)) {
+        if (entry.is_regular_file() && isImageFile(entry.path())) {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    if (files.empty()) {
+        fprintf(stderr, "No images found in %s\n", opts.input_dir.string().c_str());
+        return 1;
+    }
+
+    int jobs = opts.jobs > 0 ? opts.jobs : static_cast<int>(std::thread::hardware_concurrency());
+    jobs = std::max(1, std::min(jobs, static_cast<int>(files.size())));
+
+    // Parallelism is across files; keep OpenCV from oversubscribing the cores
+    if (jobs > 1) {
+        SharedResources::configureThreads(1);
+    }
+
+    EnginePool pool(jobs, static_cast<size_t>(opts.memory_mb) * 1024 * 1024);
+    const int session = pool.openSession();
+
+    EnhancementOptions enhance;
+    enhance.apply_perspective_correction = true;
+    enhance.apply_deskew = true;
+    enhance.apply_auto_enhance = opts.mode != ENHANCE_NONE;
+    enhance.enhance_mode = opts.mode;
+    enhance.apply_sharpening = opts.sharpen > 0;
+    enhance.sharpening_strength = opts.sharpen;
+    enhance.output_width = opts.output_width;
+    enhance.output_height = opts.output_height;
+
+    std::atomic<size_t> next(0);
+    std::atomic<int> succeeded(0);
+    std::atomic<int> failed(0);
+    std::vector<double> megapixels(jobs, 0.0);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (int w = 0; w < jobs; w++) {
+        workers.emplace_back([&, w]() {
+            for (size_t i = next++; i < files.size(); i = next++) {
+                FileOutcome outcome = processFile(pool, session, opts, enhance, files[i]);
+                megapixels[w] += outcome.megapixels;
+                if (outcome.success) {
+                    succeeded++;
+                } else {
+                    failed++;
+                    fprintf(stderr, "Failed: %s\n", files[i].string().c_str());
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double totalMp = 0;
+    for (double mp : megapixels) totalMp += mp;
+
+    printf("Processed %zu files (%d ok, %d failed) in %.2f s with %d workers\n",
+           files.size(), succeeded.load(), failed.load(), seconds, jobs);
+    printf("Throughput: %.2f files/s, %.1f MP/s (%s kernels, %d OpenCV threads)\n",
+           files.size() / std::max(seconds, 1e-9), totalMp / std::max(seconds, 1e-9),
+           SharedResources::instance().kernels().name, SharedResources::instance().threadCount());
+
+    pool.closeSession(session);
+    return failed.load() > 0 ? 2 : 0;
+}
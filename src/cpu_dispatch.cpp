@@ -0,0 +1,380 @@
+#include "cpu_dispatch.hpp"
+#include <cstring>
+#include <mutex>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define DISPATCH_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define DISPATCH_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(DISPATCH_NEON) && defined(__aarch64__) && (defined(__clang__) || __GNUC__ >= 8)
+#define DISPATCH_DOTPROD 1
+#if defined(__clang__)
+#define DOTPROD_TARGET __attribute__((target("dotprod")))
+#else
+#define DOTPROD_TARGET __attribute__((target("+dotprod")))
+#endif
+#endif
+
+#if defined(__linux__) || defined(__ANDROID__)
+#include <sys/auxv.h>
+#endif
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// Scalar reference
+
+static void whitenGrayScalar(const uint8_t* gray, uint8_t* dst, size_t n, uint8_t threshold) {
+    for (size_t i = 0; i < n; i++) {
+        if (gray[i] > threshold) dst[i] = 255;
+    }
+}
+
+static void whitenBgrScalar(const uint8_t* gray, uint8_t* dst, size_t n, uint8_t threshold) {
+    for (size_t i = 0; i < n; i++) {
+        if (gray[i] > threshold) {
+            dst[i * 3 + 0] = 255;
+            dst[i * 3 + 1] = 255;
+            dst[i * 3 + 2] = 255;
+        }
+    }
+}
+
+static uint64_t sadScalar(const uint8_t* a, const uint8_t* b, size_t n) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+    }
+    return sum;
+}
+
+// ---------------------------------------------------------------------------
+// x86: SSE4.1 / AVX2
+
+#ifdef DISPATCH_X86
+__attribute__((target("sse4.1")))
+static void whitenGraySse41(const uint8_t* gray, uint8_t* dst, size_t n, uint8_t threshold) {
+    const __m128i t = _mm_set1_epi8(static_cast<char>(threshold));
+    const __m128i ones = _mm_set1_epi8(-1);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(gray + i));
+        // Unsigned g <= t  <=>  min(g, t) == g
+        __m128i le = _mm_cmpeq_epi8(_mm_min_epu8(g, t), g);
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        d = _mm_or_si128(d, _mm_andnot_si128(le, ones));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), d);
+    }
+    whitenGrayScalar(gray + i, dst + i, n - i, threshold);
+}
+
+__attribute__((target("sse4.1")))
+static void whitenBgrSse41(const uint8_t* gray, uint8_t* dst, size_t n, uint8_t threshold) {
+    const __m128i t = _mm_set1_epi8(static_cast<char>(threshold));
+    const __m128i ones = _mm_set1_epi8(-1);
+    // Spread 16 pixel masks over 48 interleaved bytes
+    const __m128i s0 = _mm_setr_epi8(0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5);
+    const __m128i s1 = _mm_setr_epi8(5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10);
+    const __m128i s2 = _mm_setr_epi8(10, 11, 11, 11, 12, 12, 12, 13, 13, 13, 14, 14, 14, 15, 15, 15);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(gray + i));
+        __m128i gt = _mm_andnot_si128(_mm_cmpeq_epi8(_mm_min_epu8(g, t), g), ones);
+
+        uint8_t* d = dst + i * 3;
+        __m128i d0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d));
+        __m128i d1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + 16));
+        __m128i d2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + 32));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d), _mm_or_si128(d0, _mm_shuffle_epi8(gt, s0)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 16), _mm_or_si128(d1, _mm_shuffle_epi8(gt, s1)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 32), _mm_or_si128(d2, _mm_shuffle_epi8(gt, s2)));
+    }
+    whitenBgrScalar(gray + i, dst + i * 3, n - i, threshold);
+}
+
+__attribute__((target("sse4.1")))
+static uint64_t sadSse41(const uint8_t* a, const uint8_t* b, size_t n) {
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return lanes[0] + lanes[1] + sadScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void whitenGrayAvx2(const uint8_t* gray, uint8_t* dst, size_t n, uint8_t threshold) {
+    const __m256i t = _mm256_set1_epi8(static_cast<char>(threshold));
+    const __m256i ones = _mm256_set1_epi8(-1);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i g = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(gray + i));
+        __m256i le = _mm256_cmpeq_epi8(_mm256_min_epu8(g, t), g);
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        d = _mm256_or_si256(d, _mm256_andnot_si256(le, ones));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), d);
+    }
+    whitenGrayScalar(gray + i, dst + i, n - i, threshold);
+}
+
+__attribute__((target("avx2")))
+static uint64_t sadAvx2(const uint8_t* a, const uint8_t* b, size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(va, vb));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sadScalar(a + i, b + i, n - i);
+}
+#endif  // DISPATCH_X86
+
+// ---------------------------------------------------------------------------
+// ARM: NEON / NEON + dotprod
+
+#ifdef DISPATCH_NEON
+// u32 lanes grow by at most 1020 per step; flush to u64 well before overflow
+static const size_t NEON_FLUSH_STEPS = 1 << 16;
+
+static void whitenGrayNeon(const uint8_t* gray, uint8_t* dst, size_t n, uint8_t threshold) {
+    const uint8x16_t t = vdupq_n_u8(threshold);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t gt = vcgtq_u8(vld1q_u8(gray + i), t);
+        vst1q_u8(dst + i, vorrq_u8(vld1q_u8(dst + i), gt));
+    }
+    whitenGrayScalar(gray + i, dst + i, n - i, threshold);
+}
+
+static void whitenBgrNeon(const uint8_t* gray, uint8_t* dst, size_t n, uint8_t threshold) {
+    const uint8x16_t t = vdupq_n_u8(threshold);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t gt = vcgtq_u8(vld1q_u8(gray + i), t);
+        uint8x16x3_t d = vld3q_u8(dst + i * 3);
+        d.val[0] = vorrq_u8(d.val[0], gt);
+        d.val[1] = vorrq_u8(d.val[1], gt);
+        d.val[2] = vorrq_u8(d.val[2], gt);
+        vst3q_u8(dst + i * 3, d);
+    }
+    whitenBgrScalar(gray + i, dst + i * 3, n - i, threshold);
+}
+
+static inline uint64_t sumLanes(uint32x4_t v) {
+    uint64x2_t wide = vpaddlq_u32(v);
+    return vgetq_lane_u64(wide, 0) + vgetq_lane_u64(wide, 1);
+}
+
+static uint64_t sadNeon(const uint8_t* a, const uint8_t* b, size_t n) {
+    uint64_t sum = 0;
+    uint32x4_t acc = vdupq_n_u32(0);
+    size_t steps = 0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t diff = vabdq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+        acc = vpadalq_u16(acc, vpaddlq_u8(diff));
+        if (++steps == NEON_FLUSH_STEPS) {
+            sum += sumLanes(acc);
+            acc = vdupq_n_u32(0);
+            steps = 0;
+        }
+    }
+    return sum + sumLanes(acc) + sadScalar(a + i, b + i, n - i);
+}
+
+#ifdef DISPATCH_DOTPROD
+DOTPROD_TARGET
+static uint64_t sadDotprod(const uint8_t* a, const uint8_t* b, size_t n) {
+    // UDOT against ones: 16 byte sums per instruction
+    const uint8x16_t ones = vdupq_n_u8(1);
+    uint64_t sum = 0;
+    uint32x4_t acc = vdupq_n_u32(0);
+    size_t steps = 0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t diff = vabdq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+        acc = vdotq_u32(acc, diff, ones);
+        if (++steps == NEON_FLUSH_STEPS) {
+            sum += sumLanes(acc);
+            acc = vdupq_n_u32(0);
+            steps = 0;
+        }
+    }
+    return sum + sumLanes(acc) + sadScalar(a + i, b + i, n - i);
+}
+#endif  // DISPATCH_DOTPROD
+#endif  // DISPATCH_NEON
+
+// ---------------------------------------------------------------------------
+// Tables and selection
+
+static const KernelTable SCALAR_TABLE = {
+    ISA_SCALAR, "scalar", whitenGrayScalar, whitenBgrScalar, sadScalar
+};
+
+#ifdef DISPATCH_X86
+static const KernelTable SSE41_TABLE = {
+    ISA_SSE41, "sse4.1", whitenGraySse41, whitenBgrSse41, sadSse41
+};
+// 3-channel whitening stays on the 128-bit shuffle (AVX2 shuffles are per lane)
+static const KernelTable AVX2_TABLE = {
+    ISA_AVX2, "avx2", whitenGrayAvx2, whitenBgrSse41, sadAvx2
+};
+#endif
+
+#ifdef DISPATCH_NEON
+static const KernelTable NEON_TABLE = {
+    ISA_NEON, "neon", whitenGrayNeon, whitenBgrNeon, sadNeon
+};
+#ifdef DISPATCH_DOTPROD
+static const KernelTable DOTPROD_TABLE = {
+    ISA_NEON_DOTPROD, "neon+dotprod", whitenGrayNeon, whitenBgrNeon, sadDotprod
+};
+#endif
+#endif
+
+static const KernelTable* g_active = &SCALAR_TABLE;
+static std::once_flag g_select_once;
+
+CpuFeatureSet CpuDispatch::features() {
+    CpuFeatureSet f;
+
+#ifdef DISPATCH_X86
+    __builtin_cpu_init();
+    f.sse41 = __builtin_cpu_supports("sse4.1");
+    f.avx2 = __builtin_cpu_supports("avx2");  // Also checks OS AVX state support
+#endif
+
+#ifdef DISPATCH_NEON
+#if defined(__aarch64__)
+    f.neon = true;
+#if defined(__linux__) || defined(__ANDROID__)
+    f.dotprod = (getauxval(AT_HWCAP) & (1UL << 20)) != 0;  // HWCAP_ASIMDDP
+#elif defined(__APPLE__)
+    int value = 0;
+    size_t size = sizeof(value);
+    if (sysctlbyname("hw.optional.arm.FEAT_DotProd", &value, &size, nullptr, 0) == 0) {
+        f.dotprod = value != 0;
+    }
+#endif
+#elif defined(__linux__) || defined(__ANDROID__)
+    f.neon = (getauxval(AT_HWCAP) & (1UL << 12)) != 0;  // HWCAP_NEON (armv7)
+#else
+    f.neon = true;
+#endif
+#endif
+
+    return f;
+}
+
+std::vector<const KernelTable*> CpuDispatch::available() {
+    std::vector<const KernelTable*> tables = {&SCALAR_TABLE};
+    CpuFeatureSet f = features();
+    (void)f;
+
+#ifdef DISPATCH_X86
+    if (f.sse41) tables.push_back(&SSE41_TABLE);
+    if (f.avx2 && f.sse41) tables.push_back(&AVX2_TABLE);
+#endif
+#ifdef DISPATCH_NEON
+    if (f.neon) tables.push_back(&NEON_TABLE);
+#ifdef DISPATCH_DOTPROD
+    if (f.neon && f.dotprod) tables.push_back(&DOTPROD_TABLE);
+#endif
+#endif
+
+    return tables;
+}
+
+void CpuDispatch::select() {
+    std::call_once(g_select_once, []() {
+        // Last entry is the widest supported variant
+        g_active = available().back();
+    });
+}
+
+const KernelTable& CpuDispatch::kernels() {
+    select();
+    return *g_active;
+}
+
+const KernelTable& CpuDispatch::scalar() {
+    return SCALAR_TABLE;
+}
+
+std::vector<KernelCheck> CpuDispatch::selfTest() {
+    static const size_t SIZES[] = {0, 1, 3, 15, 16, 17, 31, 32, 33, 47, 48, 49, 63, 64, 65, 127, 255, 1000, 4099};
+    static const size_t OFFSETS[] = {0, 1, 3};
+    static const uint8_t THRESHOLDS[] = {0, 1, 127, 128, 200, 254, 255};
+    const size_t MAX_N = 4099 + 3;
+
+    // Deterministic pseudo-random data with saturated runs mixed in
+    std::vector<uint8_t> a(MAX_N), b(MAX_N), base(MAX_N * 3);
+    uint32_t state = 0x12345678u;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<uint8_t>(state >> 24);
+    };
+    for (size_t i = 0; i < MAX_N; i++) {
+        a[i] = (i % 37 < 3) ? 255 : next();
+        b[i] = (i % 41 < 3) ? 0 : next();
+    }
+    for (auto& v : base) v = next();
+
+    const KernelTable& ref = SCALAR_TABLE;
+    std::vector<KernelCheck> checks;
+
+    for (const KernelTable* table : available()) {
+        KernelCheck check;
+        check.name = table->name;
+
+        std::vector<uint8_t> expected(MAX_N * 3), actual(MAX_N * 3);
+        for (size_t n : SIZES) {
+            for (size_t off : OFFSETS) {
+                for (uint8_t t : THRESHOLDS) {
+                    expected = base;
+                    actual = base;
+                    ref.whiten_gray(a.data() + off, expected.data() + off, n, t);
+                    table->whiten_gray(a.data() + off, actual.data() + off, n, t);
+                    if (expected != actual) check.mismatches++;
+
+                    expected = base;
+                    actual = base;
+                    ref.whiten_bgr(a.data() + off, expected.data() + off, n, t);
+                    table->whiten_bgr(a.data() + off, actual.data() + off, n, t);
+                    if (expected != actual) check.mismatches++;
+                }
+
+                if (ref.sad_u8(a.data() + off, b.data(), n) != table->sad_u8(a.data() + off, b.data(), n)) {
+                    check.mismatches++;
+                }
+            }
+        }
+
+        // Long run of maximal differences: exercises accumulator flushing
+        const size_t LONG_N = (size_t(1) << 21) + 5;
+        std::vector<uint8_t> hi(LONG_N, 255), lo(LONG_N, 0);
+        if (ref.sad_u8(hi.data(), lo.data(), LONG_N) != table->sad_u8(hi.data(), lo.data(), LONG_N)) {
+            check.mismatches++;
+        }
+
+        check.passed = check.mismatches == 0;
+        checks.push_back(check);
+    }
+
+    return checks;
+}
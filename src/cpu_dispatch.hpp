@@ -0,0 +1,71 @@
+#ifndef CPU_DISPATCH_HPP
+#define CPU_DISPATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct CpuFeatureSet {
+    bool sse41;
+    bool avx2;
+    bool neon;
+    bool dotprod;   // ARMv8.2 UDOT/SDOT
+
+    CpuFeatureSet() : sse41(false), avx2(false), neon(false), dotprod(false) {}
+};
+
+enum KernelIsa {
+    ISA_SCALAR = 0,
+    ISA_SSE41 = 1,
+    ISA_AVX2 = 2,
+    ISA_NEON = 3,
+    ISA_NEON_DOTPROD = 4
+};
+
+// Hand-written kernels for the enhancer and scan paths. Every variant must
+// produce exactly the scalar result (checked by CpuDispatch::selfTest).
+struct KernelTable {
+    KernelIsa isa;
+    const char* name;
+
+    // dst[i] = 255 where gray[i] > threshold (background whitening)
+    void (*whiten_gray)(const uint8_t* gray, uint8_t* dst, size_t n, uint8_t threshold);
+    // Same for interleaved 3-channel dst (n pixels)
+    void (*whiten_bgr)(const uint8_t* gray, uint8_t* dst, size_t n, uint8_t threshold);
+    // Sum of absolute differences
+    uint64_t (*sad_u8)(const uint8_t* a, const uint8_t* b, size_t n);
+};
+
+struct KernelCheck {
+    std::string name;
+    bool passed;
+    int mismatches;   // Failed cases (size/offset/threshold combinations)
+
+    KernelCheck() : passed(false), mismatches(0) {}
+};
+
+// Selects the fastest kernel variant the CPU supports. Variants are
+// compiled with per-function target attributes, so the library itself
+// needs no -mavx2/-march flags and runs on baseline CPUs.
+class CpuDispatch {
+public:
+    static CpuFeatureSet features();
+
+    // Detect and select once (CaptureEngine calls this on creation)
+    static void select();
+
+    // Selected table (selects on first use)
+    static const KernelTable& kernels();
+
+    static const KernelTable& scalar();
+
+    // All variants runnable on this CPU, scalar first
+    static std::vector<const KernelTable*> available();
+
+    // Compare every available variant bit-for-bit against scalar on
+    // pseudo-random data with odd sizes and unaligned offsets
+    static std::vector<KernelCheck> selfTest();
+};
+
+#endif // CPU_DISPATCH_HPP
@@ -0,0 +1,64 @@
+#ifndef DETECTOR_BACKEND_HPP
+#define DETECTOR_BACKEND_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// Known document formats (aspect = long side / short side)
+enum DocumentProfile {
+    PROFILE_ANY = 0,       // Any convex quad
+    PROFILE_ID_CARD = 1,   // ISO/IEC 7810 ID-1, 85.60 x 53.98 mm
+    PROFILE_PASSPORT = 2,  // ID-3 passport page, 125 x 88 mm
+    PROFILE_A4 = 3,        // 297 x 210 mm
+    PROFILE_LETTER = 4,    // 11 x 8.5 in
+    PROFILE_CUSTOM = 5     // Caller-provided aspect
+};
+
+struct DetectionResult {
+    bool found;
+    std::vector<cv::Point2f> corners;  // TL, TR, BR, BL
+    float confidence;
+    float aspect;   // Estimated true width/height of the page (perspective removed)
+    cv::Mat gray;   // Detection-resolution gray frame (shared with later stages)
+    float scale;    // gray size / frame size
+
+    DetectionResult() : found(false), confidence(0.0f), aspect(0.0f), scale(1.0f) {}
+};
+
+enum DetectorBackendType {
+    DETECTOR_CLASSICAL = 0,  // DocumentDetector (Canny + contours)
+    DETECTOR_DNN = 1         // DnnDetector (edge/corner heatmap network)
+};
+
+// Document quad detector used by CaptureEngine. Backends must fill
+// gray/scale (DocumentDetector::detectionGray) even when nothing is found,
+// since later analysis stages run on it.
+class DetectorBackend {
+public:
+    virtual ~DetectorBackend() {}
+
+    virtual DetectionResult detect(const cv::Mat& frame) = 0;
+
+    // Long/short aspect to accept (0 = any)
+    virtual void setAspectConstraint(float aspect, float tolerance = 0.08f) = 0;
+
+    virtual const char* name() const = 0;
+};
+
+// Per-backend benchmark over a set of frames
+struct DetectorBenchmark {
+    int backend;            // DetectorBackendType
+    bool available;         // Backend usable (DNN: built with dnn and model loaded)
+    int frames;
+    float mean_ms;
+    float p95_ms;
+    float found_rate;       // Fraction of frames with a document
+    float corner_error;     // Mean corner distance / frame diagonal (vs reference)
+    float agreement;        // Fraction of frames matching the reference (error < 2%)
+
+    DetectorBenchmark()
+        : backend(DETECTOR_CLASSICAL), available(false), frames(0), mean_ms(0), p95_ms(0),
+          found_rate(0), corner_error(0), agreement(0) {}
+};
+
+#endif // DETECTOR_BACKEND_HPP
@@ -0,0 +1,198 @@
+#include "dnn_detector.hpp"
+#include <algorithm>
+#include <cmath>
+
+DnnDetector::DnnDetector() {}
+
+DnnDetector::~DnnDetector() {}
+
+bool DnnDetector::isAvailable() {
+#ifdef HAVE_OPENCV_DNN
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool DnnDetector::load(const std::string& model_path, int input_size) {
+    loaded_ = false;
+
+#ifdef HAVE_OPENCV_DNN
+    if (model_path.empty() || input_size < 32) {
+        return false;
+    }
+
+    try {
+        net_ = cv::dnn::readNet(model_path);
+    } catch (const cv::Exception&) {
+        return false;
+    }
+    if (net_.empty()) {
+        return false;
+    }
+
+    net_.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+    net_.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+    input_size_ = input_size;
+    loaded_ = true;
+#else
+    (void)model_path;
+    (void)input_size;
+#endif
+
+    return loaded_;
+}
+
+void DnnDetector::setAspectConstraint(float aspect, float tolerance) {
+    if (aspect > 0 && aspect < 1.0f) {
+        aspect = 1.0f / aspect;
+    }
+    target_aspect_ = std::max(0.0f, aspect);
+    aspect_tolerance_ = tolerance;
+    quad_finder_.setAspectConstraint(aspect, tolerance);
+}
+
+static inline float toProbability(float v) {
+    return (v < 0.0f || v > 1.0f) ? 1.0f / (1.0f + std::exp(-v)) : v;
+}
+
+std::vector<cv::Point2f> DnnDetector::cornersFromHeatmaps(const cv::Mat& output, const cv::Size& frameSize,
+                                                          float& confidence) {
+    const int h = output.size[2];
+    const int w = output.size[3];
+    std::vector<cv::Point2f> corners;
+    confidence = 1.0f;
+
+    for (int c = 0; c < 4; c++) {
+        cv::Mat heat(h, w, CV_32F, const_cast<float*>(output.ptr<float>(0, c)));
+
+        double peak;
+        cv::Point loc;
+        cv::minMaxLoc(heat, nullptr, &peak, nullptr, &loc);
+        confidence = std::min(confidence, toProbability(static_cast<float>(peak)));
+
+        // Sub-cell peak: weighted centroid of the 3x3 neighborhood
+        float sx = 0, sy = 0, sw = 0;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int x = loc.x + dx, y = loc.y + dy;
+                if (x < 0 || y < 0 || x >= w || y >= h) continue;
+                float wgt = toProbability(heat.at<float>(y, x));
+                sx += wgt * x;
+                sy += wgt * y;
+                sw += wgt;
+            }
+        }
+        float px = sw > 0 ? sx / sw : static_cast<float>(loc.x);
+        float py = sw > 0 ? sy / sw : static_cast<float>(loc.y);
+
+        corners.push_back(cv::Point2f((px + 0.5f) / w * frameSize.width,
+                                      (py + 0.5f) / h * frameSize.height));
+    }
+
+    return corners;
+}
+
+std::vector<cv::Point2f> DnnDetector::cornersFromEdges(const cv::Mat& output, const cv::Size& detectionSize,
+                                                       float& confidence) {
+    const int h = output.size[2];
+    const int w = output.size[3];
+    cv::Mat prob(h, w, CV_32F, const_cast<float*>(output.ptr<float>(0, 0)));
+
+    double minV, maxV;
+    cv::minMaxLoc(prob, &minV, &maxV);
+    double threshold = (minV < 0.0 || maxV > 1.0) ? 0.0 : EDGE_THRESHOLD;  // Logit 0 = p 0.5
+
+    cv::Mat edges;
+    cv::threshold(prob, edges, threshold, 255, cv::THRESH_BINARY);
+    edges.convertTo(edges, CV_8U);
+    cv::resize(edges, edges, detectionSize, 0, 0, cv::INTER_NEAREST);
+    cv::dilate(edges, edges, cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3)));
+
+    std::vector<cv::Point2f> quad = quad_finder_.findQuad(edges);
+    confidence = quad.size() == 4 ? quad_finder_.calculateConfidence(quad, detectionSize) : 0.0f;
+    return quad;
+}
+
+bool DnnDetector::aspectMatches(const std::vector<cv::Point2f>& corners, const cv::Size& frameSize) const {
+    if (target_aspect_ <= 0) {
+        return true;
+    }
+
+    float aspect = DocumentDetector::estimateAspect(corners, frameSize);
+    if (aspect <= 0) {
+        return false;
+    }
+    if (aspect < 1.0f) {
+        aspect = 1.0f / aspect;
+    }
+    return std::abs(std::log(aspect / target_aspect_)) <= std::log(1.0f + aspect_tolerance_);
+}
+
+DetectionResult DnnDetector::detect(const cv::Mat& frame) {
+    DetectionResult result;
+
+    if (frame.empty()) {
+        return result;
+    }
+
+    result.gray = DocumentDetector::detectionGray(frame, result.scale);
+
+#ifdef HAVE_OPENCV_DNN
+    if (!loaded_) {
+        return result;
+    }
+
+    cv::Mat bgr;
+    if (frame.channels() == 4) {
+        cv::cvtColor(frame, bgr, cv::COLOR_BGRA2BGR);
+    } else if (frame.channels() == 1) {
+        cv::cvtColor(frame, bgr, cv::COLOR_GRAY2BGR);
+    } else {
+        bgr = frame;
+    }
+
+    cv::Mat output;
+    try {
+        cv::Mat blob = cv::dnn::blobFromImage(bgr, 1.0 / 255.0, cv::Size(input_size_, input_size_),
+                                              cv::Scalar(), true, false);
+        net_.setInput(blob);
+        output = net_.forward();
+    } catch (const cv::Exception&) {
+        return result;
+    }
+
+    if (output.dims != 4 || output.type() != CV_32F) {
+        return result;
+    }
+
+    std::vector<cv::Point2f> corners;
+    float confidence = 0;
+    if (output.size[1] >= 4) {
+        corners = cornersFromHeatmaps(output, frame.size(), confidence);
+        if (confidence < MIN_PEAK || !cv::isContourConvex(corners) ||
+            cv::contourArea(corners) < frame.total() * 0.05) {
+            return result;
+        }
+    } else {
+        corners = cornersFromEdges(output, result.gray.size(), confidence);
+        if (corners.size() != 4) {
+            return result;
+        }
+        for (auto& pt : corners) {
+            pt /= result.scale;
+        }
+    }
+
+    if (!aspectMatches(corners, frame.size())) {
+        return result;
+    }
+
+    result.corners = corners;
+    result.found = true;
+    result.confidence = confidence;
+    result.aspect = DocumentDetector::estimateAspect(corners, frame.size());
+#endif
+
+    return result;
+}
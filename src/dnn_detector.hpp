@@ -0,0 +1,51 @@
+#ifndef DNN_DETECTOR_HPP
+#define DNN_DETECTOR_HPP
+
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+#include "detector_backend.hpp"
+#include "document_detector.hpp"
+
+// CPU network backend via OpenCV dnn (ONNX/TFLite/... as supported by readNet).
+// Model contract:
+//   input  1x3xSxS RGB, 0-1 (S = input_size, frame squashed to square)
+//   output 1x4xHxW corner heatmaps (TL, TR, BR, BL), or
+//          1x1xHxW edge probability map (quad found with the classical contour stage)
+// Logits are accepted; values outside 0-1 are passed through a sigmoid.
+// Without the dnn module (HAVE_OPENCV_DNN) load() always fails.
+class DnnDetector : public DetectorBackend {
+public:
+    DnnDetector();
+    ~DnnDetector();
+
+    bool load(const std::string& model_path, int input_size = 256);
+    bool isLoaded() const { return loaded_; }
+    static bool isAvailable();
+
+    DetectionResult detect(const cv::Mat& frame) override;
+    void setAspectConstraint(float aspect, float tolerance = 0.08f) override;
+    const char* name() const override { return "dnn"; }
+
+private:
+    std::vector<cv::Point2f> cornersFromHeatmaps(const cv::Mat& output, const cv::Size& frameSize,
+                                                 float& confidence);
+    std::vector<cv::Point2f> cornersFromEdges(const cv::Mat& output, const cv::Size& grayDetectionSize,
+                                              float& confidence);
+    bool aspectMatches(const std::vector<cv::Point2f>& corners, const cv::Size& frameSize) const;
+
+#ifdef HAVE_OPENCV_DNN
+    cv::dnn::Net net_;
+#endif
+    bool loaded_ = false;
+    int input_size_ = 256;
+    float target_aspect_ = 0.0f;
+    float aspect_tolerance_ = 0.08f;
+    DocumentDetector quad_finder_;  // Contour stage for edge-map models
+
+    static constexpr float MIN_PEAK = 0.3f;        // Weakest corner heatmap peak accepted
+    static constexpr float EDGE_THRESHOLD = 0.5f;
+};
+
+#endif // DNN_DETECTOR_HPP
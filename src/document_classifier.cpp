@@ -0,0 +1,107 @@
+#include "document_classifier.hpp"
+#include <algorithm>
+#include <cmath>
+
+DocumentClassifier::DocumentClassifier() {}
+
+DocumentClassifier::~DocumentClassifier() {}
+
+void DocumentClassifier::reset() {
+    history_.clear();
+}
+
+static bool nearAspect(float aspect, float target, float tolerance) {
+    return std::abs(aspect / target - 1.0f) < tolerance;
+}
+
+ClassificationResult DocumentClassifier::classify(const cv::Mat& frame,
+                                                  const std::vector<cv::Point2f>& corners,
+                                                  float aspect) {
+    ClassificationResult result;
+
+    if (frame.empty() || corners.size() != 4 || aspect <= 0) {
+        return result;
+    }
+
+    const bool landscape = aspect > 1.0f;
+    result.aspect = landscape ? aspect : 1.0f / aspect;
+    result.confidence = 1.0f;
+
+    // Rectified thumbnail; warpPerspective only computes the output pixels
+    std::vector<cv::Point2f> dst = {
+        cv::Point2f(0, 0), cv::Point2f(THUMB_SIZE - 1, 0),
+        cv::Point2f(THUMB_SIZE - 1, THUMB_SIZE - 1), cv::Point2f(0, THUMB_SIZE - 1)
+    };
+    cv::Mat M = cv::getPerspectiveTransform(corners, dst);
+    cv::Mat thumb;
+    cv::warpPerspective(frame, thumb, M, cv::Size(THUMB_SIZE, THUMB_SIZE), cv::INTER_LINEAR);
+    if (thumb.channels() == 4) {
+        cv::cvtColor(thumb, thumb, cv::COLOR_BGRA2BGR);
+    }
+
+    cv::Mat hsv;
+    cv::cvtColor(thumb, hsv, cv::COLOR_BGR2HSV);
+    cv::Mat colored;
+    cv::inRange(hsv, cv::Scalar(0, 80, 50), cv::Scalar(180, 255, 255), colored);
+    result.saturation = static_cast<float>(cv::countNonZero(colored)) / colored.total();
+
+    cv::Mat gray, ink;
+    cv::cvtColor(thumb, gray, cv::COLOR_BGR2GRAY);
+    cv::adaptiveThreshold(gray, ink, 255, cv::ADAPTIVE_THRESH_MEAN_C,
+                          cv::THRESH_BINARY_INV, 15, 12);
+    result.ink_ratio = static_cast<float>(cv::countNonZero(ink)) / ink.total();
+    float background = static_cast<float>(cv::mean(gray)[0]);
+
+    // Geometry first: it separates most formats; appearance breaks ties
+    if (result.aspect > 2.0f) {
+        result.type = DOC_TYPE_RECEIPT;
+    } else if (nearAspect(result.aspect, 85.60f / 53.98f, 0.07f) && result.saturation > 0.12f) {
+        result.type = DOC_TYPE_ID_CARD;  // Printed cards are colorful; plain paper is not
+    } else if (landscape && result.aspect > 1.2f && result.ink_ratio < 0.05f &&
+               background > 150.0f && result.saturation < 0.1f) {
+        result.type = DOC_TYPE_WHITEBOARD;  // Wide, bright, sparse strokes
+    } else if (nearAspect(result.aspect, 297.0f / 210.0f, 0.05f)) {
+        result.type = DOC_TYPE_A4;
+    } else if (nearAspect(result.aspect, 11.0f / 8.5f, 0.04f)) {
+        result.type = DOC_TYPE_LETTER;
+    } else {
+        result.type = DOC_TYPE_PAGE;
+    }
+
+    return result;
+}
+
+ClassificationResult DocumentClassifier::update(const cv::Mat& frame,
+                                                const std::vector<cv::Point2f>& corners,
+                                                float aspect) {
+    ClassificationResult result = classify(frame, corners, aspect);
+
+    history_.push_back(result.type);
+    if (history_.size() > VOTE_FRAMES) {
+        history_.pop_front();
+    }
+
+    int votes[DOC_TYPE_PAGE + 1] = {0};
+    for (DocumentType t : history_) {
+        votes[t]++;
+    }
+    int best = static_cast<int>(std::max_element(votes, votes + DOC_TYPE_PAGE + 1) - votes);
+
+    result.type = static_cast<DocumentType>(best);
+    result.confidence = static_cast<float>(votes[best]) / history_.size();
+    return result;
+}
+
+cv::Size DocumentClassifier::outputSize(DocumentType type, bool landscape) {
+    cv::Size size;
+    switch (type) {
+        case DOC_TYPE_A4:      size = cv::Size(1654, 2339); break;  // 200 dpi
+        case DOC_TYPE_LETTER:  size = cv::Size(1700, 2200); break;  // 200 dpi
+        case DOC_TYPE_ID_CARD: size = cv::Size(638, 1011); break;   // 300 dpi
+        default:               return cv::Size(0, 0);
+    }
+    if (landscape) {
+        std::swap(size.width, size.height);
+    }
+    return size;
+}
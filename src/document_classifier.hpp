@@ -0,0 +1,56 @@
+#ifndef DOCUMENT_CLASSIFIER_HPP
+#define DOCUMENT_CLASSIFIER_HPP
+
+#include <opencv2/opencv.hpp>
+#include <deque>
+#include <vector>
+
+enum DocumentType {
+    DOC_TYPE_UNKNOWN = 0,
+    DOC_TYPE_RECEIPT = 1,
+    DOC_TYPE_A4 = 2,
+    DOC_TYPE_LETTER = 3,
+    DOC_TYPE_ID_CARD = 4,
+    DOC_TYPE_WHITEBOARD = 5,
+    DOC_TYPE_PAGE = 6        // Other paper page
+};
+
+struct ClassificationResult {
+    DocumentType type;
+    float confidence;   // 0-1, share of recent frames agreeing (1 for single images)
+    float aspect;       // Long/short, perspective removed
+    float saturation;   // Fraction of strongly colored thumbnail pixels
+    float ink_ratio;    // Fraction of dark (ink) thumbnail pixels
+
+    ClassificationResult()
+        : type(DOC_TYPE_UNKNOWN), confidence(0), aspect(0), saturation(0), ink_ratio(0) {}
+};
+
+// Lightweight document type classifier: quad geometry (true aspect) plus
+// color/ink statistics of a small rectified thumbnail.
+class DocumentClassifier {
+public:
+    DocumentClassifier();
+    ~DocumentClassifier();
+
+    void reset();
+
+    // Single image. frame: BGR/BGRA; aspect: true width/height of the quad
+    ClassificationResult classify(const cv::Mat& frame, const std::vector<cv::Point2f>& corners,
+                                  float aspect);
+
+    // Per-frame, with a majority vote over recent frames for a stable label
+    ClassificationResult update(const cv::Mat& frame, const std::vector<cv::Point2f>& corners,
+                                float aspect);
+
+    // Output size at the type's scan resolution (0,0 = measured from the quad)
+    static cv::Size outputSize(DocumentType type, bool landscape);
+
+private:
+    std::deque<DocumentType> history_;
+
+    static const int THUMB_SIZE = 64;
+    static const size_t VOTE_FRAMES = 8;
+};
+
+#endif // DOCUMENT_CLASSIFIER_HPP
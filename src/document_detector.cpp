@@ -2,7 +2,9 @@
 #include <algorithm>
 #include <cmath>
 
-DocumentDetector::DocumentDetector() {}
+DocumentDetector::DocumentDetector() {
+    clahe_ = cv::createCLAHE(2.0, cv::Size(8, 8));
+}
 
 DocumentDetector::~DocumentDetector() {}
 
@@ -15,33 +17,152 @@ void DocumentDetector::setMinAreaRatio(float ratio) {
     min_area_ratio_ = ratio;
 }
 
-DetectionResult DocumentDetector::detect(const cv::Mat& frame) {
-    DetectionResult result;
+void DocumentDetector::setAspectConstraint(float aspect, float tolerance) {
+    if (aspect > 0 && aspect < 1.0f) {
+        aspect = 1.0f / aspect;
+    }
+    target_aspect_ = std::max(0.0f, aspect);
+    aspect_tolerance_ = tolerance;
+}
 
-    if (frame.empty()) {
-        return result;
+float DocumentDetector::profileAspect(DocumentProfile profile) {
+    switch (profile) {
+        case PROFILE_ID_CARD:  return 85.60f / 53.98f;
+        case PROFILE_PASSPORT: return 125.0f / 88.0f;
+        case PROFILE_A4:       return 297.0f / 210.0f;
+        case PROFILE_LETTER:   return 11.0f / 8.5f;
+        default:               return 0.0f;
+    }
+}
+
+float DocumentDetector::estimateAspect(const std::vector<cv::Point2f>& quad, const cv::Size& imageSize) {
+    if (quad.size() != 4) {
+        return 0.0f;
+    }
+
+    // Image-space side ratio: exact for fronto-parallel views, fallback otherwise
+    float w = (cv::norm(quad[1] - quad[0]) + cv::norm(quad[2] - quad[3])) * 0.5f;
+    float h = (cv::norm(quad[3] - quad[0]) + cv::norm(quad[2] - quad[1])) * 0.5f;
+    if (h <= 0) {
+        return 0.0f;
+    }
+    const float sideRatio = w / h;
+
+    // Homogeneous corners relative to the principal point
+    const double u0 = imageSize.width * 0.5;
+    const double v0 = imageSize.height * 0.5;
+    cv::Vec3d m1(quad[0].x - u0, quad[0].y - v0, 1.0);  // TL
+    cv::Vec3d m2(quad[1].x - u0, quad[1].y - v0, 1.0);  // TR
+    cv::Vec3d m3(quad[3].x - u0, quad[3].y - v0, 1.0);  // BL
+    cv::Vec3d m4(quad[2].x - u0, quad[2].y - v0, 1.0);  // BR
+
+    double d2 = m2.cross(m4).dot(m3);
+    double d3 = m3.cross(m4).dot(m2);
+    if (std::abs(d2) < 1e-9 || std::abs(d3) < 1e-9) {
+        return sideRatio;
+    }
+    double k2 = m1.cross(m4).dot(m3) / d2;
+    double k3 = m1.cross(m4).dot(m2) / d3;
+    cv::Vec3d n2 = k2 * m2 - m1;  // Along the width
+    cv::Vec3d n3 = k3 * m3 - m1;  // Along the height
+
+    // Focal length from the orthogonality of the two page axes; when an
+    // edge pair is (nearly) parallel it is undetermined, use a nominal one
+    double f2 = 0;
+    if (std::abs(n2[2] * n3[2]) > 1e-9) {
+        f2 = -(n2[0] * n3[0] + n2[1] * n3[1]) / (n2[2] * n3[2]);
+    }
+    const double nominal = 0.75 * std::max(imageSize.width, imageSize.height);
+    if (f2 < nominal * nominal * 0.25 || f2 > nominal * nominal * 16.0) {
+        f2 = nominal * nominal;
+    }
+
+    double lw = (n2[0] * n2[0] + n2[1] * n2[1]) / f2 + n2[2] * n2[2];
+    double lh = (n3[0] * n3[0] + n3[1] * n3[1]) / f2 + n3[2] * n3[2];
+    if (lw <= 0 || lh <= 0) {
+        return sideRatio;
+    }
+
+    return static_cast<float>(std::sqrt(lw / lh));
+}
+
+float DocumentDetector::aspectScore(const std::vector<cv::Point2f>& quad, const cv::Size& imageSize) {
+    if (target_aspect_ <= 0) {
+        return 1.0f;
+    }
+
+    std::vector<cv::Point2f> ordered = orderCorners(quad);
+
+    // Cheap prune: perspective rarely distorts the side ratio by more than 2x
+    float w = cv::norm(ordered[1] - ordered[0]) + cv::norm(ordered[2] - ordered[3]);
+    float h = cv::norm(ordered[3] - ordered[0]) + cv::norm(ordered[2] - ordered[1]);
+    if (w <= 0 || h <= 0) {
+        return 0.0f;
+    }
+    float side = std::max(w, h) / std::min(w, h);
+    if (side > target_aspect_ * 2.0f || side * 2.0f < target_aspect_) {
+        return 0.0f;
+    }
+
+    float aspect = estimateAspect(ordered, imageSize);
+    if (aspect <= 0) {
+        return 0.0f;
+    }
+    if (aspect < 1.0f) {
+        aspect = 1.0f / aspect;  // Portrait or landscape
     }
 
+    float err = std::abs(std::log(aspect / target_aspect_));
+    float tol = std::log(1.0f + aspect_tolerance_);
+    if (err > tol) {
+        return 0.0f;
+    }
+    return 1.0f - err / tol * 0.5f;
+}
+
+cv::Mat DocumentDetector::detectionGray(const cv::Mat& frame, float& scale) {
     // Resize for faster processing
     cv::Mat resized;
-    float scale = 1.0f;
+    scale = 1.0f;
     const int TARGET_WIDTH = 480;
 
     if (frame.cols > TARGET_WIDTH) {
         scale = static_cast<float>(TARGET_WIDTH) / frame.cols;
         cv::resize(frame, resized, cv::Size(), scale, scale);
     } else {
-        resized = frame.clone();
+        resized = frame;
+    }
+
+    return toGray(resized);
+}
+
+std::vector<cv::Point2f> DocumentDetector::findQuad(const cv::Mat& edges) {
+    std::vector<cv::Point2f> quad = findLargestQuadrilateral(findContours(edges), edges.size());
+    if (quad.size() != 4) {
+        return std::vector<cv::Point2f>();
+    }
+    return orderCorners(quad);
+}
+
+DetectionResult DocumentDetector::detect(const cv::Mat& frame) {
+    DetectionResult result;
+
+    if (frame.empty()) {
+        return result;
     }
 
+    // Keep detection-resolution gray for downstream stages
+    result.gray = detectionGray(frame, result.scale);
+    const float scale = result.scale;
+
     // Preprocess
-    cv::Mat edges = preprocess(resized);
+    cv::Mat edges = preprocess(result.gray);
 
     // Find contours
     std::vector<std::vector<cv::Point>> contours = findContours(edges);
 
     // Find largest quadrilateral
-    std::vector<cv::Point2f> quad = findLargestQuadrilateral(contours, resized.size());
+    std::vector<cv::Point2f> quad = findLargestQuadrilateral(contours, result.gray.size());
 
     if (quad.size() == 4) {
         // Scale corners back to original size
@@ -54,13 +175,14 @@ DetectionResult DocumentDetector::detect(const cv::Mat& frame) {
         result.corners = orderCorners(quad);
         result.found = true;
         result.confidence = calculateConfidence(result.corners, frame.size());
+        result.aspect = estimateAspect(result.corners, frame.size());
     }
 
     return result;
 }
 
-cv::Mat DocumentDetector::preprocess(const cv::Mat& input) {
-    cv::Mat gray, blurred, edges;
+cv::Mat DocumentDetector::toGray(const cv::Mat& input) {
+    cv::Mat gray;
 
     // Convert to grayscale
     if (input.channels() == 3) {
@@ -71,13 +193,18 @@ cv::Mat DocumentDetector::preprocess(const cv::Mat& input) {
         gray = input.clone();
     }
 
+    return gray;
+}
+
+cv::Mat DocumentDetector::preprocess(const cv::Mat& gray) {
+    cv::Mat equalized, blurred, edges;
+
     // Apply CLAHE (Contrast Limited Adaptive Histogram Equalization)
     // This helps detect edges on low-contrast backgrounds
-    cv::Ptr<cv::CLAHE> clahe = cv::createCLAHE(2.0, cv::Size(8, 8));
-    clahe->apply(gray, gray);
+    clahe_->apply(gray, equalized);
 
     // Gaussian blur
-    cv::GaussianBlur(gray, blurred, cv::Size(5, 5), 0);
+    cv::GaussianBlur(equalized, blurred, cv::Size(5, 5), 0);
 
     // Canny edge detection
     cv::Canny(blurred, edges, canny_low_, canny_high_);
@@ -112,6 +239,38 @@ std::vector<cv::Point2f> DocumentDetector::findLargestQuadrilateral(
 ) {
     float minArea = imageSize.width * imageSize.height * min_area_ratio_;
 
+    // Known aspect: keep searching smaller contours and pick the best
+    // area x aspect-match candidate instead of the first quad
+    if (target_aspect_ > 0) {
+        std::vector<cv::Point2f> best;
+        double bestScore = 0;
+        for (const auto& contour : contours) {
+            double area = cv::contourArea(contour);
+            if (area < minArea || area < bestScore) {
+                break;  // Sorted by area: nothing later can win
+            }
+
+            double perimeter = cv::arcLength(contour, true);
+            for (double epsFactor = 0.02; epsFactor <= 0.1; epsFactor += 0.02) {
+                std::vector<cv::Point> approx;
+                cv::approxPolyDP(contour, approx, epsFactor * perimeter, true);
+                if (approx.size() != 4 || !cv::isContourConvex(approx)) continue;
+
+                std::vector<cv::Point2f> quad;
+                for (const auto& pt : approx) {
+                    quad.push_back(cv::Point2f(static_cast<float>(pt.x), static_cast<float>(pt.y)));
+                }
+                double score = area * aspectScore(quad, imageSize);
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = quad;
+                }
+                break;
+            }
+        }
+        return best;
+    }
+
     for (const auto& contour : contours) {
         double area = cv::contourArea(contour);
         if (area < minArea) {
@@ -4,39 +4,60 @@
 #include <opencv2/opencv.hpp>
 #include <vector>
 
-struct DetectionResult {
-    bool found;
-    std::vector<cv::Point2f> corners;  // TL, TR, BR, BL
-    float confidence;
+#include "detector_backend.hpp"
 
-    DetectionResult() : found(false), confidence(0.0f) {}
-};
-
-class DocumentDetector {
+// Classical backend: CLAHE + Canny + contour quad search
+class DocumentDetector : public DetectorBackend {
 public:
     DocumentDetector();
     ~DocumentDetector();
 
-    DetectionResult detect(const cv::Mat& frame);
+    DetectionResult detect(const cv::Mat& frame) override;
+    const char* name() const override { return "classical"; }
 
     // Configuration
     void setCannyThreshold(int low, int high);
     void setMinAreaRatio(float ratio);
 
+    // Only accept quads whose true aspect (long/short, orientation-free)
+    // is within tolerance of the given one; 0 disables the constraint
+    void setAspectConstraint(float aspect, float tolerance = 0.08f) override;
+    float aspectConstraint() const { return target_aspect_; }
+
+    // Quad stage only, for backends that produce their own edge map
+    // Returns ordered corners (TL, TR, BR, BL) in edge-map coordinates
+    std::vector<cv::Point2f> findQuad(const cv::Mat& edges);
+    float calculateConfidence(const std::vector<cv::Point2f>& corners, const cv::Size& imageSize);
+
+    // Detection-resolution gray frame shared by all backends (scale = gray / frame)
+    static cv::Mat detectionGray(const cv::Mat& frame, float& scale);
+
+    static float profileAspect(DocumentProfile profile);
+
+    // True width/height of the rectangle imaged as quad (TL,TR,BR,BL),
+    // using the principal point at the image center (Zhang & He)
+    static float estimateAspect(const std::vector<cv::Point2f>& quad, const cv::Size& imageSize);
+
 private:
-    cv::Mat preprocess(const cv::Mat& input);
+    static cv::Mat toGray(const cv::Mat& input);
+    cv::Mat preprocess(const cv::Mat& gray);
     std::vector<std::vector<cv::Point>> findContours(const cv::Mat& edges);
     std::vector<cv::Point2f> findLargestQuadrilateral(
         const std::vector<std::vector<cv::Point>>& contours,
         const cv::Size& imageSize
     );
     std::vector<cv::Point2f> orderCorners(const std::vector<cv::Point2f>& corners);
-    float calculateConfidence(const std::vector<cv::Point2f>& corners, const cv::Size& imageSize);
+    // 0-1 match of a candidate against the aspect constraint (1 if unconstrained)
+    float aspectScore(const std::vector<cv::Point2f>& quad, const cv::Size& imageSize);
 
     // Parameters - adjusted for better sensitivity
     int canny_low_ = 30;      // Lower threshold for better edge detection
     int canny_high_ = 100;    // Lower high threshold
     float min_area_ratio_ = 0.05f;  // Allow smaller documents (5% of image)
+    float target_aspect_ = 0.0f;    // Long/short, 0 = any
+    float aspect_tolerance_ = 0.08f;
+
+    cv::Ptr<cv::CLAHE> clahe_;  // Created once; apply() reuses its buffers
 };
 
 #endif // DOCUMENT_DETECTOR_HPP
@@ -0,0 +1,264 @@
+#include "edge_snapper.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+EdgeSnapper::EdgeSnapper() {}
+
+EdgeSnapper::~EdgeSnapper() {}
+
+void EdgeSnapper::clear() {
+    image_.release();
+    edge_map_.release();
+    corners_.clear();
+    corner_strength_.clear();
+    scale_ = 1.0f;
+    edge_threshold_ = 0;
+}
+
+bool EdgeSnapper::prepare(const cv::Mat& image) {
+    clear();
+
+    if (image.empty()) {
+        return false;
+    }
+
+    // Keep BGR copy for magnifier patches
+    if (image.channels() == 4) {
+        cv::cvtColor(image, image_, cv::COLOR_BGRA2BGR);
+    } else if (image.channels() == 1) {
+        cv::cvtColor(image, image_, cv::COLOR_GRAY2BGR);
+    } else {
+        image_ = image;
+    }
+
+    // Work on a downscaled gray image; maps are cheap to query at this size
+    cv::Mat gray;
+    cv::cvtColor(image_, gray, cv::COLOR_BGR2GRAY);
+
+    int longSide = std::max(gray.cols, gray.rows);
+    if (longSide > MAX_WORKING_SIZE) {
+        scale_ = static_cast<float>(MAX_WORKING_SIZE) / longSide;
+        cv::resize(gray, gray, cv::Size(), scale_, scale_, cv::INTER_AREA);
+    }
+
+    cv::GaussianBlur(gray, gray, cv::Size(3, 3), 0);
+
+    // Gradient magnitude (L1) as 8-bit map
+    cv::Mat gx, gy, absX, absY;
+    cv::Sobel(gray, gx, CV_16S, 1, 0, 3);
+    cv::Sobel(gray, gy, CV_16S, 0, 1, 3);
+    cv::convertScaleAbs(gx, absX);
+    cv::convertScaleAbs(gy, absY);
+    cv::addWeighted(absX, 0.5, absY, 0.5, 0, edge_map_);
+
+    // Strong edge threshold: 90th percentile of gradient magnitude
+    int histSize = 256;
+    float range[] = {0, 256};
+    const float* ranges = range;
+    cv::Mat hist;
+    cv::calcHist(&edge_map_, 1, 0, cv::Mat(), hist, 1, &histSize, &ranges);
+
+    float target = static_cast<float>(edge_map_.total()) * 0.9f;
+    float cumulative = 0;
+    edge_threshold_ = 255;
+    for (int i = 0; i < histSize; i++) {
+        cumulative += hist.at<float>(i);
+        if (cumulative >= target) {
+            edge_threshold_ = i;
+            break;
+        }
+    }
+    // Flat images: avoid snapping to noise
+    edge_threshold_ = std::max(edge_threshold_, 20);
+
+    // Corner candidates (Shi-Tomasi) per grid cell, so every region of the
+    // image keeps its strongest corners; cells must still clear 1% of the
+    // global response so flat areas do not contribute noise
+    cv::Mat eig;
+    cv::cornerMinEigenVal(gray, eig, 3, 3);
+    double maxEig = 0;
+    cv::minMaxLoc(eig, nullptr, &maxEig);
+    const float minEig = static_cast<float>(maxEig * 0.01);
+
+    std::vector<cv::Point2f> cellCorners;
+    for (int gy = 0; gy < CORNER_GRID; gy++) {
+        for (int gx = 0; gx < CORNER_GRID; gx++) {
+            cv::Rect cell(gx * gray.cols / CORNER_GRID, gy * gray.rows / CORNER_GRID, 0, 0);
+            cell.width = (gx + 1) * gray.cols / CORNER_GRID - cell.x;
+            cell.height = (gy + 1) * gray.rows / CORNER_GRID - cell.y;
+            if (cell.width < 8 || cell.height < 8) continue;
+
+            cv::goodFeaturesToTrack(gray(cell), cellCorners, CORNERS_PER_CELL, 0.01, 8);
+            for (const auto& pt : cellCorners) {
+                cv::Point2f p(pt.x + cell.x, pt.y + cell.y);
+                if (eig.at<float>(static_cast<int>(p.y), static_cast<int>(p.x)) >= minEig) {
+                    corners_.push_back(p);
+                }
+            }
+        }
+    }
+
+    if (!corners_.empty()) {
+        cv::cornerSubPix(gray, corners_, cv::Size(5, 5), cv::Size(-1, -1),
+                         cv::TermCriteria(cv::TermCriteria::EPS + cv::TermCriteria::COUNT, 20, 0.03));
+
+        corner_strength_.reserve(corners_.size());
+        for (const auto& pt : corners_) {
+            int cx = std::min(std::max(static_cast<int>(pt.x + 0.5f), 0), eig.cols - 1);
+            int cy = std::min(std::max(static_cast<int>(pt.y + 0.5f), 0), eig.rows - 1);
+            float s = maxEig > 0 ? static_cast<float>(eig.at<float>(cy, cx) / maxEig) : 0.0f;
+            corner_strength_.push_back(std::min(1.0f, s));
+        }
+    }
+
+    return true;
+}
+
+SnapResult EdgeSnapper::snap(float x, float y, float radius, SnapMode mode) const {
+    if (mode == SNAP_MODE_CORNER) {
+        return snapToCorner(x, y, radius);
+    }
+    if (mode == SNAP_MODE_EDGE) {
+        return snapToEdge(x, y, radius);
+    }
+
+    SnapResult corner = snapToCorner(x, y, radius);
+    if (corner.kind != SNAP_NONE) {
+        return corner;
+    }
+    return snapToEdge(x, y, radius);
+}
+
+SnapResult EdgeSnapper::snapToCorner(float x, float y, float radius) const {
+    SnapResult result;
+
+    if (!isPrepared() || corners_.empty() || radius <= 0) {
+        return result;
+    }
+
+    float qx = x * scale_;
+    float qy = y * scale_;
+    float r = radius * scale_;
+    float bestDist2 = r * r;
+    int bestIdx = -1;
+
+    // Linear scan over at most CORNER_GRID^2 * CORNERS_PER_CELL candidates
+    for (size_t i = 0; i < corners_.size(); i++) {
+        float dx = corners_[i].x - qx;
+        float dy = corners_[i].y - qy;
+        float d2 = dx * dx + dy * dy;
+        if (d2 <= bestDist2) {
+            bestDist2 = d2;
+            bestIdx = static_cast<int>(i);
+        }
+    }
+
+    if (bestIdx < 0) {
+        return result;
+    }
+
+    result.kind = SNAP_CORNER;
+    result.point = cv::Point2f(corners_[bestIdx].x / scale_, corners_[bestIdx].y / scale_);
+    result.strength = corner_strength_[bestIdx];
+    result.distance = std::sqrt(bestDist2) / scale_;
+    return result;
+}
+
+SnapResult EdgeSnapper::snapToEdge(float x, float y, float radius) const {
+    SnapResult result;
+
+    if (!isPrepared() || radius <= 0) {
+        return result;
+    }
+
+    float qx = x * scale_;
+    float qy = y * scale_;
+    int r = std::max(1, static_cast<int>(std::ceil(radius * scale_)));
+
+    int x0 = std::max(0, static_cast<int>(qx) - r);
+    int y0 = std::max(0, static_cast<int>(qy) - r);
+    int x1 = std::min(edge_map_.cols - 1, static_cast<int>(qx) + r);
+    int y1 = std::min(edge_map_.rows - 1, static_cast<int>(qy) + r);
+
+    if (x0 > x1 || y0 > y1) {
+        return result;
+    }
+
+    float r2 = static_cast<float>(r * r);
+    float bestScore = std::numeric_limits<float>::max();
+    int bestX = -1, bestY = -1, bestMag = 0;
+
+    for (int py = y0; py <= y1; py++) {
+        const uchar* row = edge_map_.ptr<uchar>(py);
+        float dy = py - qy;
+        for (int px = x0; px <= x1; px++) {
+            int mag = row[px];
+            if (mag < edge_threshold_) continue;
+
+            float dx = px - qx;
+            float d2 = dx * dx + dy * dy;
+            if (d2 > r2) continue;
+
+            // Prefer close points, break ties toward stronger gradients
+            float score = d2 - mag * 0.01f;
+            if (score < bestScore) {
+                bestScore = score;
+                bestX = px;
+                bestY = py;
+                bestMag = mag;
+            }
+        }
+    }
+
+    if (bestX < 0) {
+        return result;
+    }
+
+    result.kind = SNAP_EDGE;
+    result.point = cv::Point2f((bestX + 0.5f) / scale_, (bestY + 0.5f) / scale_);
+    result.strength = bestMag / 255.0f;
+    result.distance = cv::norm(result.point - cv::Point2f(x, y));
+    return result;
+}
+
+int EdgeSnapper::extractPatch(float x, float y, int radius, int outSize,
+                              uint8_t* out, int outCapacity) const {
+    if (!isPrepared() || !out || radius <= 0 || outSize <= 0) {
+        return 0;
+    }
+
+    const int channels = image_.channels();
+    if (outCapacity < outSize * outSize * channels) {
+        return 0;
+    }
+
+    // Source window, possibly partially outside the image
+    int side = radius * 2;
+    cv::Rect window(static_cast<int>(std::lround(x)) - radius,
+                    static_cast<int>(std::lround(y)) - radius, side, side);
+    cv::Rect valid = window & cv::Rect(0, 0, image_.cols, image_.rows);
+
+    cv::Mat dst(outSize, outSize, image_.type(), out);
+
+    if (valid.area() == 0) {
+        dst.setTo(cv::Scalar::all(0));
+        return channels;
+    }
+
+    if (valid == window) {
+        // Fast path: ROI view, no intermediate copy
+        cv::resize(image_(window), dst, dst.size(), 0, 0,
+                   side < outSize ? cv::INTER_LINEAR : cv::INTER_AREA);
+    } else {
+        // Near borders: pad only the small window
+        cv::Mat patch(side, side, image_.type(), cv::Scalar::all(0));
+        image_(valid).copyTo(patch(cv::Rect(valid.x - window.x, valid.y - window.y,
+                                             valid.width, valid.height)));
+        cv::resize(patch, dst, dst.size(), 0, 0,
+                   side < outSize ? cv::INTER_LINEAR : cv::INTER_AREA);
+    }
+
+    return channels;
+}
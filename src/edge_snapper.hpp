@@ -0,0 +1,70 @@
+#ifndef EDGE_SNAPPER_HPP
+#define EDGE_SNAPPER_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// Snap target kinds
+enum SnapKind {
+    SNAP_NONE = 0,
+    SNAP_CORNER = 1,
+    SNAP_EDGE = 2
+};
+
+// Snap query mode
+enum SnapMode {
+    SNAP_MODE_AUTO = 0,    // Corner first, fall back to edge
+    SNAP_MODE_CORNER = 1,  // Corners only
+    SNAP_MODE_EDGE = 2     // Edges only
+};
+
+struct SnapResult {
+    SnapKind kind;
+    cv::Point2f point;  // Snapped point in image coordinates
+    float strength;     // 0-1, normalized response at snapped point
+    float distance;     // Distance from query point (image pixels)
+
+    SnapResult() : kind(SNAP_NONE), point(0, 0), strength(0), distance(0) {}
+};
+
+// Caches gradient and corner maps for one captured image so that the manual
+// corner editor can snap touch points without recomputing per touch event.
+class EdgeSnapper {
+public:
+    EdgeSnapper();
+    ~EdgeSnapper();
+
+    // Build gradient/corner maps (call once per captured image, ~10-30ms)
+    bool prepare(const cv::Mat& image);
+    bool isPrepared() const { return !image_.empty(); }
+    void clear();
+
+    // Queries (image coordinates, microseconds)
+    SnapResult snap(float x, float y, float radius, SnapMode mode = SNAP_MODE_AUTO) const;
+    SnapResult snapToCorner(float x, float y, float radius) const;
+    SnapResult snapToEdge(float x, float y, float radius) const;
+
+    // Copy a magnified patch centered at (x, y) into caller buffer.
+    // Only the (2*radius)^2 source window is read; returns channels written or 0.
+    int extractPatch(float x, float y, int radius, int outSize,
+                     uint8_t* out, int outCapacity) const;
+
+    int imageWidth() const { return image_.cols; }
+    int imageHeight() const { return image_.rows; }
+
+private:
+    cv::Mat image_;                    // BGR source image (full resolution)
+    cv::Mat edge_map_;                 // Gradient magnitude at working scale (CV_8U)
+    std::vector<cv::Point2f> corners_; // Corner candidates at working scale
+    std::vector<float> corner_strength_;
+    float scale_ = 1.0f;               // working / original
+    int edge_threshold_ = 0;           // Strong edge threshold on edge_map_
+
+    static const int MAX_WORKING_SIZE = 1024;
+    // Corner budget per grid cell: a global cap is spent on glyph corners
+    // of text-dense pages and drops the page corners
+    static const int CORNER_GRID = 8;
+    static const int CORNERS_PER_CELL = 12;
+};
+
+#endif // EDGE_SNAPPER_HPP
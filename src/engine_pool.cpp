@@ -0,0 +1,183 @@
+#include "engine_pool.hpp"
+#include "shared_resources.hpp"
+#include <algorithm>
+#include <cstring>
+
+EnginePool::EnginePool(int max_engines, size_t memory_budget)
+    : max_engines_(std::max(1, max_engines)), memory_budget_(memory_budget) {
+    SharedResources::instance();
+}
+
+EnginePool::~EnginePool() {}
+
+int EnginePool::openSession() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Start at the current minimum so a new session can't monopolize the
+    // pool while it "catches up" with long-running ones
+    Session session;
+    if (!sessions_.empty()) {
+        session.served = std::min_element(sessions_.begin(), sessions_.end(),
+            [](const std::pair<const int, Session>& a, const std::pair<const int, Session>& b) {
+                return a.second.served < b.second.served;
+            })->second.served;
+    }
+
+    int id = next_session_++;
+    sessions_[id] = session;
+    return id;
+}
+
+void EnginePool::closeSession(int session_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sessions_.erase(session_id);
+}
+
+bool EnginePool::fits(size_t bytes) const {
+    bool engineFree = !idle_.empty() ||
+                      static_cast<int>(engines_.size()) + pending_engines_ < max_engines_;
+    bool memoryFree = memory_in_use_ == 0 || memory_in_use_ + bytes <= memory_budget_;
+    return engineFree && memoryFree;
+}
+
+const EnginePool::Ticket* EnginePool::nextTicket() const {
+    const Ticket* best = nullptr;
+    uint64_t bestServed = 0;
+
+    for (const auto& ticket : waiting_) {
+        auto it = sessions_.find(ticket.session);
+        uint64_t served = it != sessions_.end() ? it->second.served : 0;
+        if (!best || served < bestServed || (served == bestServed && ticket.seq < best->seq)) {
+            best = &ticket;
+            bestServed = served;
+        }
+    }
+
+    return best;
+}
+
+EnginePool::Lease EnginePool::acquire(int session_id, size_t job_bytes) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    const uint64_t seq = next_seq_++;
+    waiting_.push_back({session_id, seq, job_bytes});
+
+    cv_.wait(lock, [&]() {
+        const Ticket* next = nextTicket();
+        return next && next->seq == seq && fits(job_bytes);
+    });
+
+    waiting_.erase(std::find_if(waiting_.begin(), waiting_.end(),
+                                [seq](const Ticket& t) { return t.seq == seq; }));
+    auto it = sessions_.find(session_id);
+    if (it != sessions_.end()) {
+        it->second.served++;
+    }
+    memory_in_use_ += job_bytes;
+    busy_++;
+
+    CaptureEngine* engine = nullptr;
+    if (!idle_.empty()) {
+        engine = idle_.back();
+        idle_.pop_back();
+    } else {
+        // Construct outside the lock; the slot is reserved meanwhile
+        pending_engines_++;
+        lock.unlock();
+        std::unique_ptr<CaptureEngine> created = std::make_unique<CaptureEngine>();
+        engine = created.get();
+        lock.lock();
+        pending_engines_--;
+        engines_.push_back(std::move(created));
+    }
+
+    // Another waiter may be runnable too (free engines, budget left)
+    lock.unlock();
+    cv_.notify_all();
+
+    engine->resetSession();
+    return Lease(this, engine, job_bytes);
+}
+
+void EnginePool::release(CaptureEngine* engine, size_t bytes) {
+    // Keep idle engines small; buffers are sized per job
+    engine->releaseStreamBuffers();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle_.push_back(engine);
+        memory_in_use_ -= bytes;
+        busy_--;
+        completed_++;
+    }
+    cv_.notify_all();
+}
+
+EnginePool::Lease::Lease(EnginePool* pool, CaptureEngine* engine, size_t bytes)
+    : pool_(pool), engine_(engine), bytes_(bytes) {}
+
+EnginePool::Lease::Lease(Lease&& other) noexcept
+    : pool_(other.pool_), engine_(other.engine_), bytes_(other.bytes_) {
+    other.pool_ = nullptr;
+    other.engine_ = nullptr;
+}
+
+EnginePool::Lease::~Lease() {
+    if (pool_ && engine_) {
+        pool_->release(engine_, bytes_);
+    }
+}
+
+size_t EnginePool::estimateJobBytes(int width, int height) {
+    // BGRA input copy + BGR frame + rectified page + enhancement temporaries
+    return static_cast<size_t>(std::max(0, width)) * static_cast<size_t>(std::max(0, height)) * 16;
+}
+
+EnhancementResult EnginePool::processPhoto(
+    int session_id,
+    const uint8_t* image_data,
+    int width,
+    int height,
+    int format,
+    const EnhancementOptions& options,
+    FrameAnalysisResult* analysis
+) {
+    if (!image_data || width <= 0 || height <= 0) {
+        EnhancementResult result;
+        strncpy(result.error_message, "Invalid image data", sizeof(result.error_message) - 1);
+        return result;
+    }
+
+    Lease lease = acquire(session_id, estimateJobBytes(width, height));
+
+    FrameAnalysisResult detected = lease->analyzeFrame(image_data, width, height, format);
+    if (analysis) {
+        *analysis = detected;
+    }
+
+    float corners[8];
+    if (detected.document_found || detected.text_region_found) {
+        memcpy(corners, detected.corners, sizeof(corners));
+    } else {
+        const float w = static_cast<float>(width);
+        const float h = static_cast<float>(height);
+        const float full[8] = {0, 0, w, 0, w, h, 0, h};
+        memcpy(corners, full, sizeof(corners));
+    }
+
+    return lease->enhanceImage(image_data, width, height, format, corners, options);
+}
+
+PoolStats EnginePool::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    PoolStats stats;
+    stats.engines = static_cast<int>(engines_.size());
+    stats.busy = busy_;
+    stats.sessions = static_cast<int>(sessions_.size());
+    stats.waiting = static_cast<int>(waiting_.size());
+    stats.memory_in_use = memory_in_use_;
+    stats.memory_budget = memory_budget_;
+    stats.jobs_completed = completed_;
+    return stats;
+}
@@ -0,0 +1,122 @@
+#ifndef ENGINE_POOL_HPP
+#define ENGINE_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "capture_engine.hpp"
+
+struct PoolStats {
+    int engines;            // Created so far (<= max_engines)
+    int busy;
+    int sessions;
+    int waiting;            // Jobs queued for an engine or memory
+    size_t memory_in_use;   // Sum of estimates of running jobs
+    size_t memory_budget;
+    uint64_t jobs_completed;
+
+    PoolStats()
+        : engines(0), busy(0), sessions(0), waiting(0), memory_in_use(0), memory_budget(0),
+          jobs_completed(0) {}
+};
+
+// Serves many concurrent sessions (e.g. server upload requests) from a
+// bounded set of CaptureEngines. Shared resources come from
+// SharedResources; engines get a full session reset before each job, so no
+// tracking state or settings cross sessions.
+//
+// Scheduling: a job runs when an engine is idle and its memory estimate
+// fits the budget. Among waiting jobs the session with the fewest jobs
+// served goes first (FIFO within a session); a job that does not fit
+// blocks later ones, so large jobs can't starve. A job larger than the
+// whole budget runs alone.
+class EnginePool {
+public:
+    EnginePool(int max_engines, size_t memory_budget);
+    ~EnginePool();  // No leases may be outstanding
+
+    EnginePool(const EnginePool&) = delete;
+    EnginePool& operator=(const EnginePool&) = delete;
+
+    int openSession();
+    void closeSession(int session_id);
+
+    // Exclusive use of one engine; returned to the pool on destruction
+    class Lease {
+    public:
+        Lease(Lease&& other) noexcept;
+        ~Lease();
+
+        CaptureEngine* engine() const { return engine_; }
+        CaptureEngine* operator->() const { return engine_; }
+
+    private:
+        friend class EnginePool;
+        Lease(EnginePool* pool, CaptureEngine* engine, size_t bytes);
+
+        EnginePool* pool_;
+        CaptureEngine* engine_;
+        size_t bytes_;
+    };
+
+    // Blocks until the job may run
+    Lease acquire(int session_id, size_t job_bytes);
+
+    // Whole-photo reprocessing: detect the page (text-region fallback,
+    // else full frame) and enhance with the given options. The detection
+    // result is copied to analysis when given.
+    EnhancementResult processPhoto(
+        int session_id,
+        const uint8_t* image_data,
+        int width,
+        int height,
+        int format,
+        const EnhancementOptions& options,
+        FrameAnalysisResult* analysis = nullptr
+    );
+
+    PoolStats stats() const;
+
+    // Peak working memory of one photo job (input, conversions, warp, enhance)
+    static size_t estimateJobBytes(int width, int height);
+
+private:
+    struct Session {
+        uint64_t served = 0;
+    };
+
+    struct Ticket {
+        int session;
+        uint64_t seq;
+        size_t bytes;
+    };
+
+    void release(CaptureEngine* engine, size_t bytes);
+    const Ticket* nextTicket() const;
+    bool fits(size_t bytes) const;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+
+    std::vector<std::unique_ptr<CaptureEngine>> engines_;
+    std::vector<CaptureEngine*> idle_;
+    int pending_engines_ = 0;   // Being constructed outside the lock
+    int busy_ = 0;
+
+    std::map<int, Session> sessions_;
+    std::vector<Ticket> waiting_;
+    int next_session_ = 1;
+    uint64_t next_seq_ = 0;
+
+    const int max_engines_;
+    const size_t memory_budget_;
+    size_t memory_in_use_ = 0;
+    uint64_t completed_ = 0;
+};
+
+#endif // ENGINE_POOL_HPP
@@ -5,6 +5,10 @@
 #include <string>
 
 #include "capture_engine.hpp"
+#include "cpu_dispatch.hpp"
+#include "engine_pool.hpp"
+#include "page_store.hpp"
+#include "shared_resources.hpp"
 
 #ifdef __ANDROID__
 #include <android/log.h>
@@ -41,6 +45,17 @@ void capture_engine_destroy(void* engine) {
     }
 }
 
+// Prime the engine for a stream of the declared size/format before the
+// scanner opens (thread pool, buffers, first-run allocations)
+// Returns warm-up duration in ms, or -1 on invalid parameters
+FFI_EXPORT
+float capture_engine_warm_up(void* engine, int width, int height, int format, int rotation) {
+    if (!engine) {
+        return -1.0f;
+    }
+    return static_cast<CaptureEngine*>(engine)->warmUp(width, height, format, rotation);
+}
+
 // Reset engine state (clear stability history)
 FFI_EXPORT
 void capture_engine_reset(void* engine) {
@@ -49,6 +64,87 @@ void capture_engine_reset(void* engine) {
     }
 }
 
+// Enable/disable continuous (book) scan mode
+FFI_EXPORT
+void capture_engine_set_continuous_scan(void* engine, int enabled) {
+    if (engine) {
+        static_cast<CaptureEngine*>(engine)->setContinuousScan(enabled != 0);
+    }
+}
+
+// Document profile: 0 any, 1 ID-1 card, 2 passport, 3 A4, 4 letter, 5 custom
+// custom_aspect: long/short side ratio for profile 5
+FFI_EXPORT
+void capture_engine_set_document_profile(void* engine, int profile, float custom_aspect) {
+    if (engine) {
+        static_cast<CaptureEngine*>(engine)->setDocumentProfile(
+            static_cast<DocumentProfile>(profile), custom_aspect);
+    }
+}
+
+// Load a detector network for the DNN backend (OpenCV dnn, CPU)
+// Returns 1 on success, 0 if the file can't be loaded or dnn is not built in
+FFI_EXPORT
+int capture_engine_load_detector_model(void* engine, const char* model_path, int input_size) {
+    if (!engine || !model_path) {
+        return 0;
+    }
+    return static_cast<CaptureEngine*>(engine)->loadDetectorModel(model_path, input_size) ? 1 : 0;
+}
+
+// Detector backend: 0 classical, 1 DNN (requires a loaded model)
+// Returns 1 if the backend is active
+FFI_EXPORT
+int capture_engine_set_detector_backend(void* engine, int backend) {
+    if (!engine) {
+        return 0;
+    }
+    return static_cast<CaptureEngine*>(engine)->setDetectorBackend(
+        static_cast<DetectorBackendType>(backend)) ? 1 : 0;
+}
+
+// Bounds for the recommended analysis rate; values <= 0 keep the current setting
+FFI_EXPORT
+void capture_engine_set_frame_rate_limits(void* engine, int min_fps, int max_fps) {
+    if (engine) {
+        static_cast<CaptureEngine*>(engine)->setFrameRateLimits(min_fps, max_fps);
+    }
+}
+
+// Framing guidance targets; values <= 0 keep the current setting
+FFI_EXPORT
+void capture_engine_set_framing_target(void* engine, float target_fill, float min_text_px) {
+    if (engine) {
+        static_cast<CaptureEngine*>(engine)->setFramingTarget(target_fill, min_text_px);
+    }
+}
+
+// Enable/disable QR/barcode region detection in analyze_frame
+FFI_EXPORT
+void capture_engine_set_barcode_detection(void* engine, int enabled) {
+    if (engine) {
+        static_cast<CaptureEngine*>(engine)->setBarcodeDetection(enabled != 0);
+    }
+}
+
+// Enable/disable the capture_ready veto for fingers over the document edges
+FFI_EXPORT
+void capture_engine_set_occlusion_veto(void* engine, int enabled) {
+    if (engine) {
+        static_cast<CaptureEngine*>(engine)->setOcclusionVeto(enabled != 0);
+    }
+}
+
+// Push a gyroscope (type 0, rad/s) or accelerometer (type 1, m/s^2) sample
+// timestamp_ns: sensor timestamp in nanoseconds
+FFI_EXPORT
+void capture_engine_push_imu_sample(void* engine, int type, float x, float y, float z, int64_t timestamp_ns) {
+    if (engine) {
+        static_cast<CaptureEngine*>(engine)->pushImuSample(
+            static_cast<ImuSampleType>(type), x, y, z, timestamp_ns);
+    }
+}
+
 // Helper to append formatted string
 static void append_fmt(std::string& s, const char* fmt, ...) {
     char buf[256];
@@ -59,6 +155,284 @@ static void append_fmt(std::string& s, const char* fmt, ...) {
     s += buf;
 }
 
+// Startup latency: create-to-first-result, first vs steady analysis time
+// Returns JSON string (free with free_string)
+FFI_EXPORT
+char* capture_engine_get_startup_stats(void* engine) {
+    if (!engine) {
+        return strdup("{\"error\":\"Invalid parameters\"}");
+    }
+
+    const StartupStats& stats = static_cast<CaptureEngine*>(engine)->startupStats();
+
+    std::string json;
+    json += "{";
+    append_fmt(json, "\"construct_ms\":%.3f,", stats.construct_ms);
+    append_fmt(json, "\"warmup_ms\":%.3f,", stats.warmup_ms);
+    append_fmt(json, "\"create_to_first_result_ms\":%.3f,", stats.create_to_first_result_ms);
+    append_fmt(json, "\"first_analysis_ms\":%.3f,", stats.first_analysis_ms);
+    append_fmt(json, "\"steady_analysis_ms\":%.3f,", stats.steady_analysis_ms);
+    append_fmt(json, "\"analyzed_frames\":%d,", stats.analyzed_frames);
+    json += stats.warmed_up ? "\"warmed_up\":true" : "\"warmed_up\":false";
+    json += "}";
+
+    return strdup(json.c_str());
+}
+
+// Engine pool for server-side batch processing (many concurrent sessions)
+FFI_EXPORT
+void* engine_pool_create(int max_engines, int memory_budget_mb) {
+    size_t budget = static_cast<size_t>(memory_budget_mb > 0 ? memory_budget_mb : 512) * 1024 * 1024;
+    return new EnginePool(max_engines, budget);
+}
+
+FFI_EXPORT
+void engine_pool_destroy(void* pool) {
+    delete static_cast<EnginePool*>(pool);
+}
+
+FFI_EXPORT
+int engine_pool_open_session(void* pool) {
+    if (!pool) return 0;
+    return static_cast<EnginePool*>(pool)->openSession();
+}
+
+FFI_EXPORT
+void engine_pool_close_session(void* pool, int session_id) {
+    if (pool) {
+        static_cast<EnginePool*>(pool)->closeSession(session_id);
+    }
+}
+
+// Detect + enhance a whole photo on a pooled engine; blocks until the
+// session's turn. Free result with free_enhancement_result
+FFI_EXPORT
+void* engine_pool_process_photo(
+    void* pool,
+    int session_id,
+    const uint8_t* image_data,
+    int width,
+    int height,
+    int format,
+    int apply_sharpening,
+    float sharpening_strength,
+    int enhance_mode,
+    int output_width,
+    int output_height
+) {
+    if (!pool || !image_data) {
+        EnhancementResult* result = new EnhancementResult();
+        strncpy(result->error_message, "Invalid parameters", sizeof(result->error_message) - 1);
+        return result;
+    }
+
+    EnhancementOptions options;
+    options.apply_perspective_correction = true;
+    options.apply_crop = false;
+    options.apply_deskew = true;
+    options.apply_auto_enhance = true;
+    options.apply_sharpening = (apply_sharpening != 0);
+    options.sharpening_strength = sharpening_strength;
+    options.enhance_mode = static_cast<EnhanceMode>(enhance_mode);
+    options.output_width = output_width;
+    options.output_height = output_height;
+
+    EnhancementResult* result = new EnhancementResult();
+    *result = static_cast<EnginePool*>(pool)->processPhoto(
+        session_id, image_data, width, height, format, options);
+    return result;
+}
+
+// Returns JSON string (free with free_string)
+FFI_EXPORT
+char* engine_pool_get_stats(void* pool) {
+    if (!pool) {
+        return strdup("{\"error\":\"Invalid parameters\"}");
+    }
+
+    PoolStats stats = static_cast<EnginePool*>(pool)->stats();
+
+    std::string json;
+    json += "{";
+    append_fmt(json, "\"engines\":%d,", stats.engines);
+    append_fmt(json, "\"busy\":%d,", stats.busy);
+    append_fmt(json, "\"sessions\":%d,", stats.sessions);
+    append_fmt(json, "\"waiting\":%d,", stats.waiting);
+    append_fmt(json, "\"memory_in_use\":%llu,", static_cast<unsigned long long>(stats.memory_in_use));
+    append_fmt(json, "\"memory_budget\":%llu,", static_cast<unsigned long long>(stats.memory_budget));
+    append_fmt(json, "\"jobs_completed\":%llu,", static_cast<unsigned long long>(stats.jobs_completed));
+    append_fmt(json, "\"threads\":%d", SharedResources::instance().threadCount());
+    json += "}";
+
+    return strdup(json.c_str());
+}
+
+// Cap OpenCV worker threads process-wide (0 = library default)
+FFI_EXPORT
+void configure_threads(int threads) {
+    SharedResources::configureThreads(threads);
+}
+
+// Memory-mapped page store for multi-page sessions
+FFI_EXPORT
+void* page_store_create() {
+    return new PageStore();
+}
+
+FFI_EXPORT
+void page_store_destroy(void* store) {
+    delete static_cast<PageStore*>(store);
+}
+
+// resume: keep pages already in the file. Returns 1 on success
+FFI_EXPORT
+int page_store_open(void* store, const char* path, int resume) {
+    if (!store || !path) return 0;
+    return static_cast<PageStore*>(store)->open(path, resume != 0) ? 1 : 0;
+}
+
+FFI_EXPORT
+void page_store_close(void* store) {
+    if (store) {
+        static_cast<PageStore*>(store)->close();
+    }
+}
+
+// Last error message (free with free_string)
+FFI_EXPORT
+char* page_store_get_error(void* store) {
+    if (!store) {
+        return strdup("Invalid parameters");
+    }
+    return strdup(static_cast<PageStore*>(store)->lastError().c_str());
+}
+
+// Store an enhancement result without copying it through Dart.
+// Returns the page index, -1 on error
+FFI_EXPORT
+int page_store_append_result(void* store, void* result, int enhance_mode, const float* corners) {
+    if (!store || !result) return -1;
+
+    EnhancementResult* r = static_cast<EnhancementResult*>(result);
+    if (!r->success || !r->image_data) return -1;
+
+    cv::Mat page(r->height, r->width, CV_8UC(r->channels), r->image_data, static_cast<size_t>(r->stride));
+    return static_cast<PageStore*>(store)->append(page, enhance_mode, corners);
+}
+
+FFI_EXPORT
+int page_store_append_image(
+    void* store,
+    const uint8_t* image_data,
+    int width,
+    int height,
+    int channels,
+    int enhance_mode,
+    const float* corners  // 8 floats or null
+) {
+    if (!store || !image_data || width <= 0 || height <= 0 ||
+        (channels != 1 && channels != 3 && channels != 4)) {
+        return -1;
+    }
+
+    cv::Mat page(height, width, CV_8UC(channels), const_cast<uint8_t*>(image_data));
+    return static_cast<PageStore*>(store)->append(page, enhance_mode, corners);
+}
+
+FFI_EXPORT
+int page_store_count(void* store) {
+    if (!store) return 0;
+    return static_cast<PageStore*>(store)->pageCount();
+}
+
+// Page index (geometry, mode, corners, thumbnail size)
+// Returns JSON string (free with free_string)
+FFI_EXPORT
+char* page_store_get_index(void* store) {
+    if (!store) {
+        return strdup("{\"error\":\"Invalid parameters\"}");
+    }
+
+    PageStore* ps = static_cast<PageStore*>(store);
+    const int count = ps->pageCount();
+
+    std::string json;
+    json += "{";
+    append_fmt(json, "\"file_size\":%llu,", static_cast<unsigned long long>(ps->fileSize()));
+    json += "\"pages\":[";
+    for (int i = 0; i < count; i++) {
+        StoredPageInfo info;
+        if (!ps->pageInfo(i, info)) break;
+
+        if (i > 0) json += ",";
+        append_fmt(json, "{\"width\":%d,\"height\":%d,\"channels\":%d,", info.width, info.height, info.channels);
+        append_fmt(json, "\"enhance_mode\":%d,", info.enhance_mode);
+        json += "\"corners\":[";
+        for (int c = 0; c < 8; c++) {
+            append_fmt(json, c ? ",%.1f" : "%.1f", info.corners[c]);
+        }
+        json += "],";
+        append_fmt(json, "\"thumb_width\":%d,\"thumb_height\":%d}", info.thumb_width, info.thumb_height);
+    }
+    json += "]}";
+
+    return strdup(json.c_str());
+}
+
+// Zero-copy mapping of a page (or its thumbnail); null on error.
+// Release with page_view_release
+FFI_EXPORT
+void* page_store_map_page(void* store, int index, int thumbnail) {
+    if (!store) return nullptr;
+
+    PageView* view = new PageView();
+    if (!static_cast<PageStore*>(store)->mapPage(index, thumbnail != 0, *view)) {
+        delete view;
+        return nullptr;
+    }
+    return view;
+}
+
+FFI_EXPORT
+const uint8_t* page_view_data(void* view) {
+    return view ? static_cast<PageView*>(view)->data : nullptr;
+}
+
+FFI_EXPORT
+int page_view_width(void* view) {
+    return view ? static_cast<PageView*>(view)->width : 0;
+}
+
+FFI_EXPORT
+int page_view_height(void* view) {
+    return view ? static_cast<PageView*>(view)->height : 0;
+}
+
+FFI_EXPORT
+int page_view_channels(void* view) {
+    return view ? static_cast<PageView*>(view)->channels : 0;
+}
+
+FFI_EXPORT
+int page_view_stride(void* view) {
+    return view ? static_cast<PageView*>(view)->stride : 0;
+}
+
+FFI_EXPORT
+void page_view_release(void* view) {
+    if (view) {
+        PageView* v = static_cast<PageView*>(view);
+        PageStore::releaseView(*v);
+        delete v;
+    }
+}
+
+FFI_EXPORT
+int page_store_sync(void* store) {
+    if (!store) return 0;
+    return static_cast<PageStore*>(store)->sync() ? 1 : 0;
+}
+
 // Analyze a single frame (Stage 1: real-time)
 // Returns JSON string with analysis results
 FFI_EXPORT
@@ -100,11 +474,44 @@ char* analyze_frame(
     json += "],";
 
     append_fmt(json, "\"corner_confidence\":%.4f,", result.corner_confidence);
+    append_fmt(json, "\"document_aspect\":%.4f,", result.document_aspect);
+    append_fmt(json, "\"document_type\":%d,", result.document_type);
+    append_fmt(json, "\"document_type_confidence\":%.4f,", result.document_type_confidence);
     append_fmt(json, "\"blur_score\":%.4f,", result.blur_score);
+    append_fmt(json, "\"blur_type\":%d,", result.blur_type);
+    append_fmt(json, "\"blur_direction\":%.1f,", result.blur_direction);
+    append_fmt(json, "\"blur_strength\":%.4f,", result.blur_strength);
     append_fmt(json, "\"brightness_score\":%.4f,", result.brightness_score);
     append_fmt(json, "\"stability_score\":%.4f,", result.stability_score);
     append_fmt(json, "\"overall_score\":%.4f,", result.overall_score);
     json += result.capture_ready ? "\"capture_ready\":true," : "\"capture_ready\":false,";
+    append_fmt(json, "\"occluded_edges\":%d,", result.occluded_edges);
+    append_fmt(json, "\"occlusion_score\":%.4f,", result.occlusion_score);
+    append_fmt(json, "\"moire_score\":%.4f,", result.moire_score);
+
+    json += "\"codes\":[";
+    for (int i = 0; i < result.code_count; i++) {
+        append_fmt(json, "{\"type\":%d,\"bounds\":[%.2f,%.2f,%.2f,%.2f],\"score\":%.4f}",
+                   result.code_types[i],
+                   result.code_regions[i * 4 + 0], result.code_regions[i * 4 + 1],
+                   result.code_regions[i * 4 + 2], result.code_regions[i * 4 + 3],
+                   result.code_scores[i]);
+        if (i < result.code_count - 1) json += ",";
+    }
+    json += "],";
+
+    append_fmt(json, "\"guidance\":%d,", result.guidance);
+    append_fmt(json, "\"fill_ratio\":%.4f,", result.fill_ratio);
+    append_fmt(json, "\"target_fill\":%.4f,", result.target_fill);
+    append_fmt(json, "\"center_offset\":[%.4f,%.4f],", result.center_offset_x, result.center_offset_y);
+    append_fmt(json, "\"tilt\":[%.2f,%.2f],", result.tilt_x, result.tilt_y);
+    append_fmt(json, "\"rotation_angle\":%.2f,", result.rotation_angle);
+    append_fmt(json, "\"text_px\":%.2f,", result.text_px);
+    append_fmt(json, "\"focus_point\":[%.4f,%.4f],", result.focus_x, result.focus_y);
+    json += result.focus_on_tile ? "\"focus_on_tile\":true," : "\"focus_on_tile\":false,";
+    append_fmt(json, "\"exposure_ev\":%.2f,", result.exposure_ev);
+    append_fmt(json, "\"recommended_fps\":%d,", result.recommended_fps);
+    append_fmt(json, "\"rate_state\":%d,", result.rate_state);
 
     // Table/Trapezoid data
     json += result.is_trapezoid ? "\"is_trapezoid\":true," : "\"is_trapezoid\":false,";
@@ -137,7 +544,16 @@ char* analyze_frame(
         json += "]";
         if (i < result.text_region_count - 1) json += ",";
     }
-    json += "]";
+    json += "],";
+
+    // Continuous scan data
+    append_fmt(json, "\"scan_state\":%d,", result.scan_state);
+    json += result.scan_trigger ? "\"scan_trigger\":true," : "\"scan_trigger\":false,";
+    append_fmt(json, "\"scan_change_score\":%.4f,", result.scan_change_score);
+    append_fmt(json, "\"scan_motion_score\":%.4f,", result.scan_motion_score);
+    json += result.imu_active ? "\"imu_active\":true," : "\"imu_active\":false,";
+    append_fmt(json, "\"imu_motion_score\":%.4f,", result.imu_motion_score);
+    json += result.analysis_skipped ? "\"analysis_skipped\":true" : "\"analysis_skipped\":false";
     json += "}";
 
     return strdup(json.c_str());
@@ -158,9 +574,12 @@ void* enhance_image(
     int apply_enhance,
     int apply_sharpening,
     float sharpening_strength,  // 0.0 - 1.0+
-    int enhance_mode,      // 0=none, 1=whiten_bg, 2=contrast_stretch, 3=adaptive_binarize, 4=sauvola
+    int enhance_mode,      // 0=none, 1=whiten_bg, 2=contrast_stretch, 3=adaptive_binarize, 4=sauvola, 5=auto
     int output_width,
-    int output_height
+    int output_height,
+    int apply_moire_removal,  // Notch filter for photographed screens
+    const int* level_sizes,   // Long side of extra downscaled outputs (may be null)
+    int level_count
 ) {
     EnhancementResult* result = new EnhancementResult();
 
@@ -181,6 +600,10 @@ void* enhance_image(
     options.enhance_mode = static_cast<EnhanceMode>(enhance_mode);
     options.output_width = output_width;
     options.output_height = output_height;
+    options.apply_moire_removal = (apply_moire_removal != 0);
+    for (int i = 0; level_sizes && i < level_count && i < MAX_OUTPUT_LEVELS; i++) {
+        options.level_sizes[i] = level_sizes[i];
+    }
 
     *result = eng->enhanceImage(image_data, width, height, format, corners, options);
 
@@ -202,7 +625,9 @@ void* enhance_image_with_guide_frame(
     int apply_sharpening,
     float sharpening_strength,
     int enhance_mode,
-    int rotation  // 0: none, 90: clockwise, 180, 270: counter-clockwise
+    int rotation,  // 0: none, 90: clockwise, 180, 270: counter-clockwise
+    const int* level_sizes,
+    int level_count
 ) {
     EnhancementResult* result = new EnhancementResult();
 
@@ -223,6 +648,9 @@ void* enhance_image_with_guide_frame(
     options.enhance_mode = static_cast<EnhanceMode>(enhance_mode);
     options.output_width = 0;
     options.output_height = 0;
+    for (int i = 0; level_sizes && i < level_count && i < MAX_OUTPUT_LEVELS; i++) {
+        options.level_sizes[i] = level_sizes[i];
+    }
 
     *result = eng->enhanceImageWithGuideFrame(
         image_data, width, height, format,
@@ -271,6 +699,37 @@ int get_enhancement_stride(void* result) {
     return static_cast<EnhancementResult*>(result)->stride;
 }
 
+// Downscaled output levels (index in requested order)
+FFI_EXPORT
+int get_enhancement_level_count(void* result) {
+    if (!result) return 0;
+    return static_cast<EnhancementResult*>(result)->level_count;
+}
+
+FFI_EXPORT
+uint8_t* get_enhancement_level_data(void* result, int level) {
+    if (!result || level < 0 || level >= MAX_OUTPUT_LEVELS) return nullptr;
+    return static_cast<EnhancementResult*>(result)->level_data[level];
+}
+
+FFI_EXPORT
+int get_enhancement_level_width(void* result, int level) {
+    if (!result || level < 0 || level >= MAX_OUTPUT_LEVELS) return 0;
+    return static_cast<EnhancementResult*>(result)->level_width[level];
+}
+
+FFI_EXPORT
+int get_enhancement_level_height(void* result, int level) {
+    if (!result || level < 0 || level >= MAX_OUTPUT_LEVELS) return 0;
+    return static_cast<EnhancementResult*>(result)->level_height[level];
+}
+
+FFI_EXPORT
+int get_enhancement_level_stride(void* result, int level) {
+    if (!result || level < 0 || level >= MAX_OUTPUT_LEVELS) return 0;
+    return static_cast<EnhancementResult*>(result)->level_stride[level];
+}
+
 FFI_EXPORT
 const char* get_enhancement_error(void* result) {
     if (!result) return "Invalid result pointer";
@@ -282,14 +741,446 @@ FFI_EXPORT
 void free_enhancement_result(void* result) {
     if (result) {
         EnhancementResult* r = static_cast<EnhancementResult*>(result);
-        if (r->image_data) {
-            delete[] r->image_data;
-            r->image_data = nullptr;
-        }
+        CaptureEngine::freeEnhancementResult(r);
         delete r;
     }
 }
 
+// Extract table grid from a (rectified) page
+// corners: 8 floats to rectify first, or NULL if image is already rectified
+// Returns JSON string with ruling lines and cells (free with free_string)
+FFI_EXPORT
+char* analyze_table(
+    void* engine,
+    const uint8_t* image_data,
+    int width,
+    int height,
+    int format,
+    const float* corners
+) {
+    if (!engine || !image_data) {
+        return strdup("{\"error\":\"Invalid parameters\"}");
+    }
+
+    CaptureEngine* eng = static_cast<CaptureEngine*>(engine);
+    TableAnalysisResult table = eng->analyzeTable(image_data, width, height, format, corners);
+
+    std::string json;
+    json.reserve(256 + table.cells.size() * 48);
+
+    json += "{";
+    json += table.found ? "\"found\":true," : "\"found\":false,";
+    append_fmt(json, "\"rows\":%d,", table.rows);
+    append_fmt(json, "\"cols\":%d,", table.cols);
+    append_fmt(json, "\"page_width\":%d,", table.page_width);
+    append_fmt(json, "\"page_height\":%d,", table.page_height);
+    append_fmt(json, "\"table_bounds\":[%d,%d,%d,%d],",
+               table.table_bounds.x, table.table_bounds.y,
+               table.table_bounds.width, table.table_bounds.height);
+
+    json += "\"row_lines\":[";
+    for (size_t i = 0; i < table.row_lines.size(); i++) {
+        append_fmt(json, "%d", table.row_lines[i]);
+        if (i + 1 < table.row_lines.size()) json += ",";
+    }
+    json += "],";
+
+    json += "\"col_lines\":[";
+    for (size_t i = 0; i < table.col_lines.size(); i++) {
+        append_fmt(json, "%d", table.col_lines[i]);
+        if (i + 1 < table.col_lines.size()) json += ",";
+    }
+    json += "],";
+
+    // Each cell: [x, y, w, h, row, col, row_span, col_span]
+    json += "\"cells\":[";
+    for (size_t i = 0; i < table.cells.size(); i++) {
+        const TableCell& c = table.cells[i];
+        append_fmt(json, "[%d,%d,%d,%d,%d,%d,%d,%d]",
+                   c.bounds.x, c.bounds.y, c.bounds.width, c.bounds.height,
+                   c.row, c.col, c.row_span, c.col_span);
+        if (i + 1 < table.cells.size()) json += ",";
+    }
+    json += "]";
+    json += "}";
+
+    return strdup(json.c_str());
+}
+
+// Export OCR-ready text-line crops packed into one gray buffer
+// corners: 8 floats to rectify first, or NULL if image is already rectified
+// Returns pointer to TextLineBatch (free with free_text_lines)
+FFI_EXPORT
+void* extract_text_lines(
+    void* engine,
+    const uint8_t* image_data,
+    int width,
+    int height,
+    int format,
+    const float* corners,
+    int line_height  // Normalized line height in pixels (e.g. 48)
+) {
+    TextLineBatch* batch = new TextLineBatch();
+
+    if (!engine || !image_data) {
+        strncpy(batch->error_message, "Invalid parameters", sizeof(batch->error_message) - 1);
+        return batch;
+    }
+
+    CaptureEngine* eng = static_cast<CaptureEngine*>(engine);
+    *batch = eng->exportTextLines(image_data, width, height, format, corners, line_height);
+
+    return batch;
+}
+
+// Get text-line batch data
+FFI_EXPORT
+int get_text_lines_success(void* batch) {
+    if (!batch) return 0;
+    return static_cast<TextLineBatch*>(batch)->success ? 1 : 0;
+}
+
+FFI_EXPORT
+int get_text_lines_count(void* batch) {
+    if (!batch) return 0;
+    return static_cast<TextLineBatch*>(batch)->count;
+}
+
+FFI_EXPORT
+int get_text_lines_height(void* batch) {
+    if (!batch) return 0;
+    return static_cast<TextLineBatch*>(batch)->line_height;
+}
+
+FFI_EXPORT
+uint8_t* get_text_lines_data(void* batch) {
+    if (!batch) return nullptr;
+    return static_cast<TextLineBatch*>(batch)->data;
+}
+
+FFI_EXPORT
+int get_text_lines_data_size(void* batch) {
+    if (!batch) return 0;
+    return static_cast<TextLineBatch*>(batch)->data_size;
+}
+
+// Byte offset of each line (count entries)
+FFI_EXPORT
+int* get_text_lines_offsets(void* batch) {
+    if (!batch) return nullptr;
+    return static_cast<TextLineBatch*>(batch)->offsets;
+}
+
+// Width of each line (count entries)
+FFI_EXPORT
+int* get_text_lines_widths(void* batch) {
+    if (!batch) return nullptr;
+    return static_cast<TextLineBatch*>(batch)->widths;
+}
+
+// Page-space box of each line: x,y,w,h (count * 4 entries)
+FFI_EXPORT
+float* get_text_lines_boxes(void* batch) {
+    if (!batch) return nullptr;
+    return static_cast<TextLineBatch*>(batch)->boxes;
+}
+
+FFI_EXPORT
+const char* get_text_lines_error(void* batch) {
+    if (!batch) return "Invalid batch pointer";
+    return static_cast<TextLineBatch*>(batch)->error_message;
+}
+
+// Free text-line batch
+FFI_EXPORT
+void free_text_lines(void* batch) {
+    if (batch) {
+        TextLineBatch* b = static_cast<TextLineBatch*>(batch);
+        TextLineExtractor::freeBatch(b);
+        delete b;
+    }
+}
+
+// Compute 64-bit perceptual hash of a captured page
+// corners: 8 floats (TL,TR,BR,BL) of the page, or NULL for the whole image
+FFI_EXPORT
+uint64_t page_hash_compute(
+    void* engine,
+    const uint8_t* image_data,
+    int width,
+    int height,
+    int format,
+    const float* corners
+) {
+    if (!engine || !image_data) {
+        return 0;
+    }
+
+    CaptureEngine* eng = static_cast<CaptureEngine*>(engine);
+    return eng->computePageHash(image_data, width, height, format, corners);
+}
+
+// Find a near-duplicate page in the session index
+// Returns matching page id, or -1 if none within max_distance bits
+FFI_EXPORT
+int page_index_find_duplicate(
+    void* engine,
+    uint64_t hash,
+    int max_distance,
+    int* out_distance
+) {
+    if (!engine) {
+        return -1;
+    }
+
+    CaptureEngine* eng = static_cast<CaptureEngine*>(engine);
+    DuplicateMatch match = eng->findDuplicatePage(hash, max_distance);
+
+    if (out_distance) {
+        *out_distance = match.distance;
+    }
+    return match.found ? match.page_id : -1;
+}
+
+// Add page hash to the session index, returns page id
+FFI_EXPORT
+int page_index_add(void* engine, uint64_t hash) {
+    if (!engine) {
+        return -1;
+    }
+    return static_cast<CaptureEngine*>(engine)->registerPage(hash);
+}
+
+// Remove page from the session index (e.g. page deleted by user)
+FFI_EXPORT
+int page_index_remove(void* engine, int page_id) {
+    if (!engine) {
+        return 0;
+    }
+    return static_cast<CaptureEngine*>(engine)->removePage(page_id) ? 1 : 0;
+}
+
+// Clear the session index (new session)
+FFI_EXPORT
+void page_index_clear(void* engine) {
+    if (engine) {
+        static_cast<CaptureEngine*>(engine)->clearPages();
+    }
+}
+
+// Start long receipt stitching session
+// Returns 1 on success
+FFI_EXPORT
+int stitch_begin(void* engine, int output_width, int max_height) {
+    if (!engine) {
+        return 0;
+    }
+    return static_cast<CaptureEngine*>(engine)->beginStitching(output_width, max_height) ? 1 : 0;
+}
+
+// Add a frame while panning along the receipt
+// corners: 8 floats of the receipt quad, or NULL to track it automatically
+// Returns JSON string with stitch status (free with free_string)
+FFI_EXPORT
+char* stitch_add_frame(
+    void* engine,
+    const uint8_t* image_data,
+    int width,
+    int height,
+    int format,
+    int rotation,
+    const float* corners
+) {
+    if (!engine || !image_data) {
+        return strdup("{\"error\":\"Invalid parameters\"}");
+    }
+
+    CaptureEngine* eng = static_cast<CaptureEngine*>(engine);
+    StitchStatus status = eng->addStitchFrame(image_data, width, height, format, rotation, corners);
+
+    std::string json;
+    json += "{";
+    append_fmt(json, "\"status\":%d,", static_cast<int>(status.status));
+    append_fmt(json, "\"shift\":%.2f,", status.shift);
+    append_fmt(json, "\"response\":%.4f,", status.response);
+    append_fmt(json, "\"stitched_height\":%d", status.stitched_height);
+    json += "}";
+
+    return strdup(json.c_str());
+}
+
+// Finish stitching and return the long image
+// Returns pointer to EnhancementResult (free with free_enhancement_result)
+FFI_EXPORT
+void* stitch_finish(void* engine) {
+    EnhancementResult* result = new EnhancementResult();
+
+    if (!engine) {
+        strncpy(result->error_message, "Invalid parameters", sizeof(result->error_message) - 1);
+        return result;
+    }
+
+    *result = static_cast<CaptureEngine*>(engine)->finishStitching();
+    return result;
+}
+
+// Cancel stitching session and release the canvas
+FFI_EXPORT
+void stitch_cancel(void* engine) {
+    if (engine) {
+        static_cast<CaptureEngine*>(engine)->cancelStitching();
+    }
+}
+
+// Remove glare by compositing several frames of the same page
+// images: array of count frame pointers (same size/format)
+// corners: count * 8 floats (TL,TR,BR,BL per frame)
+// Returns pointer to EnhancementResult (free with free_enhancement_result)
+FFI_EXPORT
+void* remove_glare(
+    void* engine,
+    const uint8_t** images,
+    int count,
+    int width,
+    int height,
+    int format,
+    const float* corners,
+    int output_width,
+    int output_height
+) {
+    EnhancementResult* result = new EnhancementResult();
+
+    if (!engine || !images || !corners) {
+        strncpy(result->error_message, "Invalid parameters", sizeof(result->error_message) - 1);
+        return result;
+    }
+
+    CaptureEngine* eng = static_cast<CaptureEngine*>(engine);
+    *result = eng->removeGlare(images, count, width, height, format, corners,
+                               output_width, output_height);
+
+    return result;
+}
+
+// Compare detector backends on the same frames
+// images: array of count frame pointers (same size/format)
+// ground_truth: count * 8 floats (TL,TR,BR,BL per frame), or NULL to compare
+// against the classical backend
+// Returns JSON string with per-backend latency and accuracy (free with free_string)
+FFI_EXPORT
+char* benchmark_detectors(
+    void* engine,
+    const uint8_t** images,
+    int count,
+    int width,
+    int height,
+    int format,
+    const float* ground_truth,
+    int iterations
+) {
+    if (!engine || !images) {
+        return strdup("{\"error\":\"Invalid parameters\"}");
+    }
+
+    CaptureEngine* eng = static_cast<CaptureEngine*>(engine);
+    std::vector<DetectorBenchmark> benchmarks =
+        eng->benchmarkDetectors(images, count, width, height, format, ground_truth, iterations);
+
+    std::string json;
+    json += ground_truth ? "{\"reference\":\"ground_truth\",\"backends\":["
+                         : "{\"reference\":\"classical\",\"backends\":[";
+    for (size_t i = 0; i < benchmarks.size(); i++) {
+        const DetectorBenchmark& b = benchmarks[i];
+        json += "{";
+        append_fmt(json, "\"backend\":%d,", b.backend);
+        json += b.available ? "\"available\":true," : "\"available\":false,";
+        append_fmt(json, "\"frames\":%d,", b.frames);
+        append_fmt(json, "\"mean_ms\":%.3f,", b.mean_ms);
+        append_fmt(json, "\"p95_ms\":%.3f,", b.p95_ms);
+        append_fmt(json, "\"found_rate\":%.4f,", b.found_rate);
+        append_fmt(json, "\"corner_error\":%.5f,", b.corner_error);
+        append_fmt(json, "\"agreement\":%.4f", b.agreement);
+        json += "}";
+        if (i + 1 < benchmarks.size()) json += ",";
+    }
+    json += "]}";
+
+    return strdup(json.c_str());
+}
+
+// Prepare corner snapping for a captured image (computes gradient/corner maps once)
+// Returns 1 on success
+FFI_EXPORT
+int corner_snap_prepare(
+    void* engine,
+    const uint8_t* image_data,
+    int width,
+    int height,
+    int format  // 0: BGRA, 1: BGR, 2: RGB
+) {
+    if (!engine || !image_data) {
+        return 0;
+    }
+
+    CaptureEngine* eng = static_cast<CaptureEngine*>(engine);
+    return eng->prepareCornerSnapping(image_data, width, height, format) ? 1 : 0;
+}
+
+// Find nearest strong corner/edge to (x, y) within radius (image pixels)
+// out_result: 4 floats [x, y, strength, distance]
+// Returns snap kind: 0=none, 1=corner, 2=edge
+FFI_EXPORT
+int corner_snap_query(
+    void* engine,
+    float x,
+    float y,
+    float radius,
+    int mode,  // 0=auto, 1=corner only, 2=edge only
+    float* out_result
+) {
+    if (!engine || !out_result) {
+        return 0;
+    }
+
+    CaptureEngine* eng = static_cast<CaptureEngine*>(engine);
+    SnapResult snap = eng->snapCorner(x, y, radius, static_cast<SnapMode>(mode));
+
+    out_result[0] = snap.point.x;
+    out_result[1] = snap.point.y;
+    out_result[2] = snap.strength;
+    out_result[3] = snap.distance;
+
+    return static_cast<int>(snap.kind);
+}
+
+// Copy magnifier patch around (x, y) into caller buffer (out_size x out_size, BGR)
+// Returns channels written, 0 on failure
+FFI_EXPORT
+int corner_snap_get_patch(
+    void* engine,
+    float x,
+    float y,
+    int radius,
+    int out_size,
+    uint8_t* out_buffer,
+    int out_capacity
+) {
+    if (!engine || !out_buffer) {
+        return 0;
+    }
+
+    CaptureEngine* eng = static_cast<CaptureEngine*>(engine);
+    return eng->getMagnifierPatch(x, y, radius, out_size, out_buffer, out_capacity);
+}
+
+// Release cached snapping maps
+FFI_EXPORT
+void corner_snap_release(void* engine) {
+    if (engine) {
+        static_cast<CaptureEngine*>(engine)->releaseCornerSnapping();
+    }
+}
+
 // Free string allocated by analyze_frame
 FFI_EXPORT
 void free_string(char* str) {
@@ -298,6 +1189,33 @@ void free_string(char* str) {
     }
 }
 
+// CPU features, selected kernel variant and a bit-exact check of every
+// SIMD variant against the scalar kernels
+// Returns JSON string (free with free_string)
+FFI_EXPORT
+char* cpu_kernel_self_test() {
+    CpuFeatureSet features = CpuDispatch::features();
+    std::vector<KernelCheck> checks = CpuDispatch::selfTest();
+
+    std::string json;
+    json += "{\"features\":{";
+    json += features.sse41 ? "\"sse41\":true," : "\"sse41\":false,";
+    json += features.avx2 ? "\"avx2\":true," : "\"avx2\":false,";
+    json += features.neon ? "\"neon\":true," : "\"neon\":false,";
+    json += features.dotprod ? "\"dotprod\":true}," : "\"dotprod\":false},";
+    append_fmt(json, "\"active\":\"%s\",", CpuDispatch::kernels().name);
+
+    json += "\"variants\":[";
+    for (size_t i = 0; i < checks.size(); i++) {
+        append_fmt(json, "{\"name\":\"%s\",\"passed\":%s,\"mismatches\":%d}",
+                   checks[i].name.c_str(), checks[i].passed ? "true" : "false", checks[i].mismatches);
+        if (i + 1 < checks.size()) json += ",";
+    }
+    json += "]}";
+
+    return strdup(json.c_str());
+}
+
 // Get library version
 FFI_EXPORT
 const char* get_version() {
@@ -0,0 +1,70 @@
+#include "frame_rate_governor.hpp"
+#include <algorithm>
+
+FrameRateGovernor::FrameRateGovernor() {}
+
+FrameRateGovernor::~FrameRateGovernor() {}
+
+void FrameRateGovernor::reset() {
+    previous_.release();
+    has_change_ = false;
+}
+
+void FrameRateGovernor::setLimits(int minFps, int maxFps) {
+    if (maxFps > 0) {
+        max_fps_ = maxFps;
+    }
+    if (minFps > 0) {
+        min_fps_ = minFps;
+    }
+    min_fps_ = std::min(min_fps_, max_fps_);
+}
+
+RateAdvice FrameRateGovernor::updateSkipped() {
+    last_change_ = Clock::now();
+    has_change_ = true;
+
+    RateAdvice advice;
+    advice.state = RATE_MOVING;
+    advice.fps = std::max(min_fps_, max_fps_ / 2);
+    advice.scene_motion = 1.0f;
+    return advice;
+}
+
+RateAdvice FrameRateGovernor::update(const cv::Mat& gray, bool documentFound, bool captureReady) {
+    RateAdvice advice;
+    const Clock::time_point now = Clock::now();
+
+    if (!gray.empty()) {
+        cv::Mat thumb;
+        cv::resize(gray, thumb, cv::Size(THUMB_SIZE, THUMB_SIZE), 0, 0, cv::INTER_AREA);
+        if (previous_.empty()) {
+            advice.scene_motion = 1.0f;
+        } else {
+            cv::Mat diff;
+            cv::absdiff(thumb, previous_, diff);
+            advice.scene_motion = static_cast<float>(cv::mean(diff)[0] / 255.0);
+        }
+        previous_ = thumb;
+    }
+
+    if (advice.scene_motion > CHANGE_THRESHOLD || !has_change_) {
+        last_change_ = now;
+        has_change_ = true;
+    }
+    auto quietMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_change_).count();
+
+    if (captureReady || (documentFound && quietMs < IDLE_AFTER_MS)) {
+        // Converging or about to capture: never throttle
+        advice.state = RATE_ACTIVE;
+        advice.fps = max_fps_;
+    } else if (quietMs >= IDLE_AFTER_MS) {
+        advice.state = RATE_IDLE;
+        advice.fps = min_fps_;
+    } else {
+        advice.state = RATE_SEARCHING;
+        advice.fps = std::max(min_fps_, max_fps_ / 2);
+    }
+
+    return advice;
+}
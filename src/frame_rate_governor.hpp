@@ -0,0 +1,56 @@
+#ifndef FRAME_RATE_GOVERNOR_HPP
+#define FRAME_RATE_GOVERNOR_HPP
+
+#include <opencv2/opencv.hpp>
+#include <chrono>
+
+// Why the current rate was chosen
+enum RateState {
+    RATE_ACTIVE = 0,     // Converging on a document: full rate
+    RATE_SEARCHING = 1,  // Scene changing, no document yet
+    RATE_IDLE = 2,       // Nothing changing (phone on the desk)
+    RATE_MOVING = 3      // Fast device motion, frames are skipped anyway
+};
+
+struct RateAdvice {
+    int fps;             // Recommended analysis rate
+    RateState state;
+    float scene_motion;  // 0-1, mean thumbnail difference to the previous frame
+
+    RateAdvice() : fps(0), state(RATE_ACTIVE), scene_motion(0) {}
+};
+
+// Recommends an analysis frame rate from scene motion and detection state,
+// so the host capture loop can throttle while nothing is happening.
+// Ramps up on the first changed frame, ramps down only after a quiet period.
+class FrameRateGovernor {
+public:
+    FrameRateGovernor();
+    ~FrameRateGovernor();
+
+    void reset();
+
+    // gray: detection-resolution gray frame
+    RateAdvice update(const cv::Mat& gray, bool documentFound, bool captureReady);
+
+    // Frame skipped for fast device motion
+    RateAdvice updateSkipped();
+
+    void setLimits(int minFps, int maxFps);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    cv::Mat previous_;
+    Clock::time_point last_change_;
+    bool has_change_ = false;
+
+    int min_fps_ = 5;
+    int max_fps_ = 30;
+
+    static const int THUMB_SIZE = 32;
+    static constexpr float CHANGE_THRESHOLD = 0.015f;  // Above sensor noise
+    static const int IDLE_AFTER_MS = 1500;
+};
+
+#endif // FRAME_RATE_GOVERNOR_HPP
@@ -0,0 +1,97 @@
+#include "framing_guide.hpp"
+#include <algorithm>
+#include <cmath>
+
+FramingGuide::FramingGuide() {}
+
+FramingGuide::~FramingGuide() {}
+
+void FramingGuide::estimateTilt(const std::vector<cv::Point2f>& corners, cv::Size frameSize,
+                                FramingGuidance& g) const {
+    // Homography unit square -> quad; K^-1 H = [r1 r2 t] up to scale
+    std::vector<cv::Point2f> square = {
+        cv::Point2f(0, 0), cv::Point2f(1, 0), cv::Point2f(1, 1), cv::Point2f(0, 1)
+    };
+    cv::Mat H = cv::getPerspectiveTransform(square, corners);
+
+    double f = focal_ratio_ * std::max(frameSize.width, frameSize.height);
+    double cx = frameSize.width * 0.5;
+    double cy = frameSize.height * 0.5;
+    cv::Matx33d Kinv(1.0 / f, 0, -cx / f,
+                     0, 1.0 / f, -cy / f,
+                     0, 0, 1);
+    cv::Matx33d M = Kinv * cv::Matx33d(H);
+
+    cv::Vec3d r1(M(0, 0), M(1, 0), M(2, 0));
+    cv::Vec3d r2(M(0, 1), M(1, 1), M(2, 1));
+    cv::Vec3d n = r1.cross(r2);
+    double len = cv::norm(n);
+    if (len < 1e-12) {
+        return;
+    }
+    n /= len;
+    if (n[2] < 0) {
+        n = -n;  // Normal pointing away from the camera
+    }
+
+    const double toDeg = 180.0 / CV_PI;
+    g.tilt_x = static_cast<float>(std::atan2(n[1], n[2]) * toDeg);
+    g.tilt_y = static_cast<float>(std::atan2(n[0], n[2]) * toDeg);
+    g.rotation = static_cast<float>(std::atan2(corners[1].y - corners[0].y,
+                                               corners[1].x - corners[0].x) * toDeg);
+}
+
+FramingGuidance FramingGuide::evaluate(const std::vector<cv::Point2f>& corners, cv::Size frameSize) const {
+    FramingGuidance g;
+    g.target_fill = target_fill_;
+
+    if (corners.size() != 4 || frameSize.width <= 0 || frameSize.height <= 0) {
+        return g;
+    }
+
+    const float frameArea = static_cast<float>(frameSize.area());
+    g.fill_ratio = static_cast<float>(cv::contourArea(corners)) / frameArea;
+
+    cv::Point2f center = (corners[0] + corners[1] + corners[2] + corners[3]) * 0.25f;
+    g.center_offset_x = (center.x - frameSize.width * 0.5f) / (frameSize.width * 0.5f);
+    g.center_offset_y = (center.y - frameSize.height * 0.5f) / (frameSize.height * 0.5f);
+
+    estimateTilt(corners, frameSize, g);
+
+    // Text size from the page's shorter projected side
+    float top = cv::norm(corners[1] - corners[0]);
+    float bottom = cv::norm(corners[2] - corners[3]);
+    float left = cv::norm(corners[3] - corners[0]);
+    float right = cv::norm(corners[2] - corners[1]);
+    float shortSide = std::min(std::min(top, bottom), std::min(left, right));
+    g.text_px = shortSide * text_height_ratio_;
+
+    // Page cut off by the frame border: the quad is a guess, back off first
+    const float margin = 0.01f * std::max(frameSize.width, frameSize.height);
+    bool touchesBorder = false;
+    for (const auto& pt : corners) {
+        if (pt.x < margin || pt.y < margin ||
+            pt.x > frameSize.width - margin || pt.y > frameSize.height - margin) {
+            touchesBorder = true;
+        }
+    }
+
+    if (touchesBorder || g.fill_ratio > target_fill_ + FILL_TOLERANCE) {
+        g.code = GUIDE_MOVE_BACK;
+    } else if (g.fill_ratio < target_fill_ - FILL_TOLERANCE || g.text_px < min_text_px_) {
+        g.code = GUIDE_MOVE_CLOSER;
+    } else if (std::abs(g.center_offset_x) > MAX_CENTER_OFFSET ||
+               std::abs(g.center_offset_y) > MAX_CENTER_OFFSET) {
+        if (std::abs(g.center_offset_x) >= std::abs(g.center_offset_y)) {
+            g.code = g.center_offset_x > 0 ? GUIDE_MOVE_RIGHT : GUIDE_MOVE_LEFT;
+        } else {
+            g.code = g.center_offset_y > 0 ? GUIDE_MOVE_DOWN : GUIDE_MOVE_UP;
+        }
+    } else if (std::abs(g.tilt_x) > MAX_TILT_DEG || std::abs(g.tilt_y) > MAX_TILT_DEG) {
+        g.code = GUIDE_HOLD_PARALLEL;
+    } else {
+        g.code = GUIDE_OK;
+    }
+
+    return g;
+}
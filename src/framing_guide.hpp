@@ -0,0 +1,68 @@
+#ifndef FRAMING_GUIDE_HPP
+#define FRAMING_GUIDE_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// Single most useful instruction for the user. Directions are phone
+// movements (GUIDE_MOVE_RIGHT: the page sits right of center).
+enum GuidanceCode {
+    GUIDE_NONE = 0,        // No document
+    GUIDE_OK = 1,
+    GUIDE_MOVE_CLOSER = 2,
+    GUIDE_MOVE_BACK = 3,   // Too large or cut off by the frame
+    GUIDE_MOVE_LEFT = 4,
+    GUIDE_MOVE_RIGHT = 5,
+    GUIDE_MOVE_UP = 6,
+    GUIDE_MOVE_DOWN = 7,
+    GUIDE_HOLD_PARALLEL = 8  // Tilted; hold the phone parallel to the page
+};
+
+struct FramingGuidance {
+    float fill_ratio;        // Quad area / frame area
+    float target_fill;
+    float center_offset_x;   // -1..1, quad center relative to frame center
+    float center_offset_y;
+    float tilt_x;            // Degrees, page rotated about the image x axis (top/bottom keystone)
+    float tilt_y;            // Degrees, page rotated about the image y axis (left/right keystone)
+    float rotation;          // Degrees, in-plane rotation of the page's top edge
+    float text_px;           // Estimated body text height in frame pixels
+    GuidanceCode code;
+
+    FramingGuidance()
+        : fill_ratio(0), target_fill(0), center_offset_x(0), center_offset_y(0),
+          tilt_x(0), tilt_y(0), rotation(0), text_px(0), code(GUIDE_NONE) {}
+};
+
+// Distance/centering/tilt guidance from the detected quad alone.
+// Tilt comes from the unit-square-to-quad homography with a nominal
+// phone camera focal length (no calibration needed).
+class FramingGuide {
+public:
+    FramingGuide();
+    ~FramingGuide();
+
+    FramingGuidance evaluate(const std::vector<cv::Point2f>& corners, cv::Size frameSize) const;
+
+    void setTargetFill(float fill) { target_fill_ = fill; }
+    void setMinTextPx(float px) { min_text_px_ = px; }
+    // Focal length as a fraction of the frame's long side (~0.75 for main cameras)
+    void setFocalRatio(float ratio) { focal_ratio_ = ratio; }
+    // Body text height as a fraction of the page's short side (~1/60 for 10 pt on A4)
+    void setTextHeightRatio(float ratio) { text_height_ratio_ = ratio; }
+
+private:
+    void estimateTilt(const std::vector<cv::Point2f>& corners, cv::Size frameSize,
+                      FramingGuidance& g) const;
+
+    float target_fill_ = 0.6f;
+    float min_text_px_ = 10.0f;
+    float focal_ratio_ = 0.75f;
+    float text_height_ratio_ = 1.0f / 60.0f;
+
+    static constexpr float FILL_TOLERANCE = 0.2f;   // Accepted |fill - target| band
+    static constexpr float MAX_CENTER_OFFSET = 0.2f;
+    static constexpr float MAX_TILT_DEG = 15.0f;
+};
+
+#endif // FRAMING_GUIDE_HPP
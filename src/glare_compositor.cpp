@@ -0,0 +1,149 @@
+#include "glare_compositor.hpp"
+#include <algorithm>
+#include <cmath>
+
+GlareCompositor::GlareCompositor() {}
+
+GlareCompositor::~GlareCompositor() {}
+
+void GlareCompositor::buildGrid(cv::Size outputSize) {
+    if (grid_output_ == outputSize && !grid_.empty()) {
+        return;
+    }
+
+    // Node j sits at the center of upsampled block j-1, matching cv::resize
+    // pixel-center alignment; one extra node on each side avoids edge clamping
+    int gw = (outputSize.width - 1) / GRID_STEP + 3;
+    int gh = (outputSize.height - 1) / GRID_STEP + 3;
+    const float center = (GRID_STEP - 1) * 0.5f;
+
+    grid_.create(gh, gw, CV_32FC2);
+    for (int y = 0; y < gh; y++) {
+        cv::Vec2f* row = grid_.ptr<cv::Vec2f>(y);
+        for (int x = 0; x < gw; x++) {
+            row[x] = cv::Vec2f((x - 1) * GRID_STEP + center, (y - 1) * GRID_STEP + center);
+        }
+    }
+
+    grid_output_ = outputSize;
+}
+
+void GlareCompositor::buildMaps(const std::vector<cv::Point2f>& quad, cv::Size outputSize,
+                                cv::Mat& map1, cv::Mat& map2) {
+    std::vector<cv::Point2f> dst = {
+        cv::Point2f(0, 0),
+        cv::Point2f(static_cast<float>(outputSize.width - 1), 0),
+        cv::Point2f(static_cast<float>(outputSize.width - 1), static_cast<float>(outputSize.height - 1)),
+        cv::Point2f(0, static_cast<float>(outputSize.height - 1))
+    };
+
+    // Output -> source mapping evaluated only on the coarse grid
+    cv::Mat Hinv = cv::getPerspectiveTransform(dst, quad);
+    cv::Mat coarse;
+    cv::perspectiveTransform(grid_, coarse, Hinv);
+
+    // Bilinear upsampling of the map; projective error inside an 8px cell is sub-pixel
+    cv::Mat dense;
+    cv::resize(coarse, dense, cv::Size(grid_.cols * GRID_STEP, grid_.rows * GRID_STEP), 0, 0, cv::INTER_LINEAR);
+    dense = dense(cv::Rect(GRID_STEP, GRID_STEP, outputSize.width, outputSize.height));
+
+    // Fixed-point maps make remap considerably faster
+    cv::convertMaps(dense, cv::noArray(), map1, map2, CV_16SC2);
+}
+
+cv::Mat GlareCompositor::highlightScore(const cv::Mat& bgr) {
+    // Glare is bright and desaturated: score = V - S
+    cv::Mat hsv;
+    cv::cvtColor(bgr, hsv, cv::COLOR_BGR2HSV);
+    cv::Mat channels[3];
+    cv::split(hsv, channels);
+
+    cv::Mat score;
+    cv::subtract(channels[2], channels[1], score);
+    return score;
+}
+
+cv::Mat GlareCompositor::composite(
+    const std::vector<cv::Mat>& frames,
+    const std::vector<std::vector<cv::Point2f>>& quads,
+    cv::Size outputSize
+) {
+    size_t count = std::min(frames.size(), quads.size());
+    count = std::min(count, static_cast<size_t>(MAX_FRAMES));
+
+    if (count == 0 || quads[0].size() != 4) {
+        return cv::Mat();
+    }
+
+    if (outputSize.width <= 0 || outputSize.height <= 0) {
+        const auto& q = quads[0];
+        float w = static_cast<float>(cv::norm(q[1] - q[0]) + cv::norm(q[2] - q[3])) * 0.5f;
+        float h = static_cast<float>(cv::norm(q[3] - q[0]) + cv::norm(q[2] - q[1])) * 0.5f;
+        outputSize = cv::Size(std::max(100, static_cast<int>(w)), std::max(100, static_cast<int>(h)));
+    }
+
+    buildGrid(outputSize);
+
+    cv::Mat sum = cv::Mat::zeros(outputSize, CV_32FC3);
+    cv::Mat weight = cv::Mat::zeros(outputSize, CV_32F);
+    cv::Mat best;                 // Least highlighted pixel across frames (fallback)
+    cv::Mat bestScore(outputSize, CV_8U, cv::Scalar(255));
+
+    cv::Mat dilateKernel = cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(9, 9));
+    cv::Mat map1, map2, warped, floatWarped, clean;
+
+    for (size_t i = 0; i < count; i++) {
+        if (frames[i].empty() || quads[i].size() != 4) continue;
+
+        buildMaps(quads[i], outputSize, map1, map2);
+        cv::remap(frames[i], warped, map1, map2, cv::INTER_LINEAR, cv::BORDER_REPLICATE);
+
+        if (warped.channels() == 4) {
+            cv::cvtColor(warped, warped, cv::COLOR_BGRA2BGR);
+        }
+
+        cv::Mat score = highlightScore(warped);
+
+        // Glare mask grown to cover the halo around hotspots
+        cv::Mat glare = score > GLARE_THRESHOLD;
+        cv::dilate(glare, glare, dilateKernel);
+        cv::bitwise_not(glare, clean);
+
+        // Average of non-glare observations
+        warped.convertTo(floatWarped, CV_32FC3);
+        cv::add(sum, floatWarped, sum, clean);
+        cv::add(weight, cv::Scalar(1.0), weight, clean);
+
+        // Minimum-highlight fallback where every frame is glared
+        if (best.empty()) {
+            best = warped.clone();
+            bestScore = score;
+        } else {
+            cv::Mat lower = score < bestScore;
+            warped.copyTo(best, lower);
+            score.copyTo(bestScore, lower);
+        }
+    }
+
+    if (best.empty()) {
+        return cv::Mat();
+    }
+
+    cv::Mat covered = weight > 0;
+    cv::Mat safeWeight;
+    cv::max(weight, 1.0, safeWeight);
+
+    cv::Mat weight3;
+    cv::Mat weights[3] = {safeWeight, safeWeight, safeWeight};
+    cv::merge(weights, 3, weight3);
+
+    cv::Mat mean;
+    cv::divide(sum, weight3, mean);
+
+    cv::Mat result = best;
+    cv::Mat mean8u;
+    mean.convertTo(mean8u, CV_8UC3);
+    mean8u.copyTo(result, covered);
+
+    return result;
+}
@@ -0,0 +1,39 @@
+#ifndef GLARE_COMPOSITOR_HPP
+#define GLARE_COMPOSITOR_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// Removes specular hotspots by compositing several frames of the same page in
+// the rectified domain. Glare moves with the phone, so each pixel is taken
+// from the frames where it is not highlighted.
+class GlareCompositor {
+public:
+    GlareCompositor();
+    ~GlareCompositor();
+
+    // frames: same page from different angles; quads: TL,TR,BR,BL per frame
+    // outputSize (0,0) = derived from the first quad
+    cv::Mat composite(
+        const std::vector<cv::Mat>& frames,
+        const std::vector<std::vector<cv::Point2f>>& quads,
+        cv::Size outputSize = cv::Size(0, 0)
+    );
+
+    static const int MAX_FRAMES = 8;
+
+private:
+    // Coarse destination grid shared by every frame's warp map
+    void buildGrid(cv::Size outputSize);
+    void buildMaps(const std::vector<cv::Point2f>& quad, cv::Size outputSize,
+                   cv::Mat& map1, cv::Mat& map2);
+    cv::Mat highlightScore(const cv::Mat& bgr);
+
+    cv::Mat grid_;          // CV_32FC2 destination points every GRID_STEP pixels
+    cv::Size grid_output_;  // Output size the grid was built for
+
+    static const int GRID_STEP = 8;
+    static const int GLARE_THRESHOLD = 170;  // Highlight score above which a pixel is glare
+};
+
+#endif // GLARE_COMPOSITOR_HPP
@@ -1,7 +1,11 @@
 #include "image_enhancer.hpp"
+#include "cpu_dispatch.hpp"
 #include <algorithm>
+#include <cmath>
 
-ImageEnhancer::ImageEnhancer() {}
+ImageEnhancer::ImageEnhancer() {
+    clahe_ = cv::createCLAHE();
+}
 
 ImageEnhancer::~ImageEnhancer() {}
 
@@ -37,10 +41,12 @@ cv::Mat ImageEnhancer::applyCLAHE(const cv::Mat& input, float clipLimit, int til
 
     cv::Mat result;
 
+    clahe_->setClipLimit(clipLimit);
+    clahe_->setTilesGridSize(cv::Size(tileSize, tileSize));
+
     if (input.channels() == 1) {
         // Grayscale image
-        cv::Ptr<cv::CLAHE> clahe = cv::createCLAHE(clipLimit, cv::Size(tileSize, tileSize));
-        clahe->apply(input, result);
+        clahe_->apply(input, result);
     } else {
         // Color image - convert to LAB, apply CLAHE to L channel
         cv::Mat lab;
@@ -50,8 +56,7 @@ cv::Mat ImageEnhancer::applyCLAHE(const cv::Mat& input, float clipLimit, int til
         cv::split(lab, channels);
 
         // Apply CLAHE to L channel
-        cv::Ptr<cv::CLAHE> clahe = cv::createCLAHE(clipLimit, cv::Size(tileSize, tileSize));
-        clahe->apply(channels[0], channels[0]);
+        clahe_->apply(channels[0], channels[0]);
 
         cv::merge(channels, lab);
         cv::cvtColor(lab, result, cv::COLOR_Lab2BGR);
@@ -65,31 +70,12 @@ cv::Mat ImageEnhancer::adjustBrightness(const cv::Mat& input, float targetBright
         return input;
     }
 
-    float currentBrightness = calculateBrightness(input);
-
-    // Calculate adjustment factor
-    // targetBrightness is 0-1, where 0.5 is neutral
-    float brightnessDiff = targetBrightness - currentBrightness;
-
-    // Only adjust if difference is significant
-    if (std::abs(brightnessDiff) < 0.05f) {
-        return input.clone();
-    }
-
-    cv::Mat result;
-
-    // Convert brightness difference to alpha/beta for convertTo
-    // alpha: contrast (1.0 = no change)
-    // beta: brightness (-127 to 127)
-    float alpha = 1.0f;
-    float beta = brightnessDiff * 100.0f;  // Scale to reasonable range
-
-    // Clamp beta
-    beta = std::max(-50.0f, std::min(50.0f, beta));
-
-    input.convertTo(result, -1, alpha, beta);
-
-    return result;
+    // Offset of (target - mean) * 100 levels, clamped to +-50 and skipped
+    // below 0.05; computed as a tone curve (thumbnail mean, one LUT pass)
+    ToneCurveConfig tone;
+    tone.auto_brightness = true;
+    tone.target_brightness = targetBrightness;
+    return applyToneCurve(input, tone);
 }
 
 cv::Mat ImageEnhancer::sharpen(const cv::Mat& input, float strength) {
@@ -108,22 +94,6 @@ cv::Mat ImageEnhancer::sharpen(const cv::Mat& input, float strength) {
     return result;
 }
 
-float ImageEnhancer::calculateBrightness(const cv::Mat& input) {
-    if (input.empty()) {
-        return 0.5f;
-    }
-
-    cv::Mat gray;
-    if (input.channels() == 1) {
-        gray = input;
-    } else {
-        cv::cvtColor(input, gray, cv::COLOR_BGR2GRAY);
-    }
-
-    cv::Scalar mean = cv::mean(gray);
-    return static_cast<float>(mean[0]) / 255.0f;
-}
-
 cv::Mat ImageEnhancer::whitenBackground(const cv::Mat& input, int threshold) {
     if (input.empty()) {
         return input;
@@ -137,26 +107,23 @@ cv::Mat ImageEnhancer::whitenBackground(const cv::Mat& input, int threshold) {
     }
 
     cv::Mat result = input.clone();
+    if (threshold >= 255) {
+        return result;
+    }
+    if (threshold < 0) {
+        result.setTo(cv::Scalar::all(255));
+        return result;
+    }
+    const uint8_t t = static_cast<uint8_t>(threshold);
 
     // Find pixels above threshold (likely background)
     // and push them towards white
-    if (input.channels() == 1) {
-        for (int y = 0; y < gray.rows; y++) {
-            for (int x = 0; x < gray.cols; x++) {
-                uchar pixel = gray.at<uchar>(y, x);
-                if (pixel > threshold) {
-                    result.at<uchar>(y, x) = 255;
-                }
-            }
-        }
-    } else {
-        for (int y = 0; y < gray.rows; y++) {
-            for (int x = 0; x < gray.cols; x++) {
-                uchar pixel = gray.at<uchar>(y, x);
-                if (pixel > threshold) {
-                    result.at<cv::Vec3b>(y, x) = cv::Vec3b(255, 255, 255);
-                }
-            }
+    const KernelTable& k = CpuDispatch::kernels();
+    for (int y = 0; y < gray.rows; y++) {
+        if (input.channels() == 1) {
+            k.whiten_gray(gray.ptr<uint8_t>(y), result.ptr<uint8_t>(y), gray.cols, t);
+        } else {
+            k.whiten_bgr(gray.ptr<uint8_t>(y), result.ptr<uint8_t>(y), gray.cols, t);
         }
     }
 
@@ -288,3 +255,307 @@ cv::Mat ImageEnhancer::sauvolaBinarize(const cv::Mat& input, int windowSize, dou
 
     return result;
 }
+
+cv::Mat ImageEnhancer::removeMoire(const cv::Mat& input, float peakThreshold) {
+    const int T = MOIRE_TILE;
+    const int S = T / 2;
+    if (input.empty() || input.cols < S || input.rows < S) {
+        return input.clone();
+    }
+
+    // Periodic Hann is a partition of unity at 50% overlap; its square root
+    // is used for both analysis and synthesis
+    cv::Mat hann;
+    cv::createHanningWindow(hann, cv::Size(T, T), CV_32F);
+    cv::Mat window(T, T, CV_32F);
+    for (int y = 0; y < T; y++) {
+        float wy = 0.5f * (1.0f - std::cos(2.0f * static_cast<float>(CV_PI) * y / T));
+        for (int x = 0; x < T; x++) {
+            float wx = 0.5f * (1.0f - std::cos(2.0f * static_cast<float>(CV_PI) * x / T));
+            window.at<float>(y, x) = std::sqrt(wx * wy);
+        }
+    }
+
+    cv::Mat gray;
+    if (input.channels() == 3) {
+        cv::cvtColor(input, gray, cv::COLOR_BGR2GRAY);
+    } else if (input.channels() == 4) {
+        cv::cvtColor(input, gray, cv::COLOR_BGRA2GRAY);
+    } else {
+        gray = input;
+    }
+
+    // Screen pitch is uniform over the page, so peaks are found once on the
+    // mean magnitude of a sparse grid of full-resolution tiles (downscaling
+    // would alias the very frequencies being removed)
+    const int GRID = 4;
+    cv::Mat meanMag = cv::Mat::zeros(T, T, CV_32F);
+    cv::Mat spectrum, planes[2], f, mag;
+    for (int gy = 0; gy < GRID; gy++) {
+        for (int gx = 0; gx < GRID; gx++) {
+            int x = (std::max(0, gray.cols - T) * gx) / (GRID - 1);
+            int y = (std::max(0, gray.rows - T) * gy) / (GRID - 1);
+            cv::Mat tile;
+            cv::copyMakeBorder(gray(cv::Rect(x, y, std::min(T, gray.cols), std::min(T, gray.rows))),
+                               tile, 0, T - std::min(T, gray.rows), 0, T - std::min(T, gray.cols),
+                               cv::BORDER_REFLECT);
+            tile.convertTo(f, CV_32F);
+            f -= cv::mean(f)[0];
+            f = f.mul(hann);
+            cv::dft(f, spectrum, cv::DFT_COMPLEX_OUTPUT);
+            cv::split(spectrum, planes);
+            cv::magnitude(planes[0], planes[1], mag);
+            meanMag += mag;
+        }
+    }
+    meanMag /= static_cast<float>(GRID * GRID);
+
+    cv::Mat logMag = meanMag + 1.0f;
+    cv::log(logMag, logMag);
+
+    // Peak = local maximum well above the local spectral background
+    cv::Mat background, localMax;
+    cv::blur(logMag, background, cv::Size(15, 15));
+    cv::dilate(logMag, localMax, cv::Mat());
+
+    // Text lines and layout live below this radius (cycles/pixel)
+    const float MIN_FREQ = 0.04f;
+    const int MAX_NOTCHES = 32;
+
+    struct Peak { int u, v; float strength; };
+    std::vector<Peak> peaks;
+    for (int v = 0; v <= T / 2; v++) {
+        const float* lm = logMag.ptr<float>(v);
+        const float* bg = background.ptr<float>(v);
+        const float* mx = localMax.ptr<float>(v);
+        float fv = static_cast<float>(v) / T;
+        for (int u = 0; u < T; u++) {
+            float fu = static_cast<float>(u <= T / 2 ? u : u - T) / T;
+            if (fu * fu + fv * fv < MIN_FREQ * MIN_FREQ) continue;
+            float excess = lm[u] - bg[u];
+            if (excess > peakThreshold && lm[u] >= mx[u]) {
+                peaks.push_back({u, v, excess});
+            }
+        }
+    }
+
+    if (peaks.empty()) {
+        return input.clone();
+    }
+
+    std::sort(peaks.begin(), peaks.end(),
+              [](const Peak& a, const Peak& b) { return a.strength > b.strength; });
+    if (peaks.size() > static_cast<size_t>(MAX_NOTCHES)) {
+        peaks.resize(MAX_NOTCHES);
+    }
+
+    // Gaussian notches at each peak and its conjugate-symmetric twin; sized
+    // for the Hann main lobe at tile resolution
+    cv::Mat mask(T, T, CV_32F, cv::Scalar(1.0f));
+    const float sigma = 1.5f;
+    const int radius = 4;
+    auto notch = [&](int cu, int cv_) {
+        for (int dv = -radius; dv <= radius; dv++) {
+            int v = (cv_ + dv + T) % T;
+            float* row = mask.ptr<float>(v);
+            for (int du = -radius; du <= radius; du++) {
+                int u = (cu + du + T) % T;
+                float d2 = static_cast<float>(du * du + dv * dv);
+                row[u] *= 1.0f - std::exp(-d2 / (2.0f * sigma * sigma));
+            }
+        }
+    };
+    for (const auto& p : peaks) {
+        notch(p.u, p.v);
+        notch((T - p.u) % T, (T - p.v) % T);
+    }
+
+    cv::Mat mask2;
+    cv::merge(std::vector<cv::Mat>{mask, mask}, mask2);
+
+    // Overlap-add over T x T tiles at stride S. Each pixel is covered by
+    // exactly 2x2 tiles; a T-row float band holds the partial sums, so
+    // working memory is one padded 8-bit copy plus T rows, not full-size
+    // complex spectra.
+    const int cn = input.channels();
+    const int padRight = S + (S - input.cols % S) % S;
+    const int padBottom = S + (S - input.rows % S) % S;
+    cv::Mat padded;
+    cv::copyMakeBorder(input, padded, S, padBottom, S, padRight, cv::BORDER_REFLECT);
+
+    cv::Mat result(input.size(), input.type());
+    cv::Mat band = cv::Mat::zeros(T, padded.cols, CV_32FC(cn));
+    std::vector<cv::Mat> tileChannels(cn), outChannels(cn);
+    cv::Mat filtered;
+
+    for (int ty = 0; ty + T <= padded.rows; ty += S) {
+        for (int tx = 0; tx + T <= padded.cols; tx += S) {
+            cv::split(padded(cv::Rect(tx, ty, T, T)), tileChannels);
+            for (int c = 0; c < cn; c++) {
+                tileChannels[c].convertTo(f, CV_32F);
+                f = f.mul(window);
+                cv::dft(f, spectrum, cv::DFT_COMPLEX_OUTPUT);
+                spectrum = spectrum.mul(mask2);
+                cv::idft(spectrum, f, cv::DFT_REAL_OUTPUT | cv::DFT_SCALE);
+                outChannels[c] = f.mul(window);
+            }
+            cv::merge(outChannels, filtered);
+            cv::Mat dst = band(cv::Rect(tx, 0, T, T));
+            dst += filtered;
+        }
+
+        // Top half of the band is complete: padded rows [ty, ty + S)
+        for (int r = 0; r < S; r++) {
+            int y = ty + r - S;
+            if (y < 0 || y >= input.rows) continue;
+            band.row(r).colRange(S, S + input.cols).convertTo(result.row(y), input.type());
+        }
+
+        band.rowRange(S, T).copyTo(band.rowRange(0, S));
+        band.rowRange(S, T).setTo(cv::Scalar::all(0));
+    }
+
+    return result;
+}
+
+cv::Mat ImageEnhancer::buildToneCurve(const float* histogram, const ToneCurveConfig& config) {
+    float curve[256];
+    for (int i = 0; i < 256; i++) {
+        curve[i] = static_cast<float>(i);
+    }
+
+    auto clampLevel = [](float v) { return std::max(0.0f, std::min(255.0f, v)); };
+
+    // Each step sees the histogram as transformed by the previous steps,
+    // so the result matches running them as separate passes in this order
+    // (brightness as in enhance(), then stretchContrast)
+    if (config.auto_brightness) {
+        float mean = 0.0f;
+        for (int i = 0; i < 256; i++) {
+            mean += histogram[i] * curve[i];
+        }
+        float brightnessDiff = config.target_brightness - mean / 255.0f;
+
+        // Same response as adjustBrightness: ignore small differences
+        if (std::abs(brightnessDiff) >= 0.05f) {
+            float beta = std::max(-50.0f, std::min(50.0f, brightnessDiff * 100.0f));
+            for (int i = 0; i < 256; i++) {
+                curve[i] = clampLevel(curve[i] + beta);
+            }
+        }
+    }
+
+    // The curve is still monotonic here, so percentiles of the input levels
+    // map to percentiles of the current output levels
+    if (config.percentile_stretch) {
+        float cdf = 0.0f;
+        int lowLevel = -1, highLevel = 255;
+        for (int i = 0; i < 256; i++) {
+            cdf += histogram[i];
+            if (lowLevel < 0 && cdf >= config.low_percentile) lowLevel = i;
+            if (cdf >= config.high_percentile) {
+                highLevel = i;
+                break;
+            }
+        }
+        const float low = curve[std::max(0, lowLevel)];
+        const float high = curve[highLevel];
+        if (high > low) {
+            const float scale = 255.0f / (high - low);
+            for (int i = 0; i < 256; i++) {
+                curve[i] = clampLevel((curve[i] - low) * scale);
+            }
+        }
+    }
+
+    if (config.gain != 1.0f) {
+        for (int i = 0; i < 256; i++) {
+            curve[i] = clampLevel((curve[i] - 128.0f) * config.gain + 128.0f);
+        }
+    }
+
+    if (config.gamma != 1.0f && config.gamma > 0.0f) {
+        for (int i = 0; i < 256; i++) {
+            curve[i] = 255.0f * std::pow(curve[i] / 255.0f, config.gamma);
+        }
+    }
+
+    cv::Mat lut(1, 256, CV_8U);
+    for (int i = 0; i < 256; i++) {
+        lut.at<uint8_t>(0, i) = cv::saturate_cast<uint8_t>(curve[i]);
+    }
+    return lut;
+}
+
+cv::Mat ImageEnhancer::applyToneCurve(const cv::Mat& input, const ToneCurveConfig& config) {
+    if (input.empty() || input.depth() != CV_8U) {
+        return input;
+    }
+    if (config.isIdentity()) {
+        return input.clone();
+    }
+
+    // Statistics from a thumbnail; the curve only needs the distribution
+    const int THUMB_SIZE = 256;
+    cv::Mat thumb;
+    float scale = static_cast<float>(THUMB_SIZE) / std::max(input.cols, input.rows);
+    if (scale < 1.0f) {
+        cv::resize(input, thumb, cv::Size(), scale, scale, cv::INTER_AREA);
+    } else {
+        thumb = input;
+    }
+
+    cv::Mat gray;
+    if (thumb.channels() == 1) {
+        gray = thumb;
+    } else if (thumb.channels() == 4) {
+        cv::cvtColor(thumb, gray, cv::COLOR_BGRA2GRAY);
+    } else {
+        cv::cvtColor(thumb, gray, cv::COLOR_BGR2GRAY);
+    }
+
+    float histogram[256] = {0};
+    for (int y = 0; y < gray.rows; y++) {
+        const uint8_t* row = gray.ptr<uint8_t>(y);
+        for (int x = 0; x < gray.cols; x++) {
+            histogram[row[x]] += 1.0f;
+        }
+    }
+    const float inv = 1.0f / static_cast<float>(gray.total());
+    for (float& h : histogram) {
+        h *= inv;
+    }
+
+    cv::Mat lut = buildToneCurve(histogram, config);
+
+    // Single pass over the full-resolution image
+    cv::Mat result;
+    cv::LUT(input, lut, result);
+
+    // Whitening keys on luminance of the toned pixels, not per channel, so
+    // light colored areas keep their hue unless they whiten as a whole
+    if (config.whiten_threshold >= 0 && config.whiten_threshold < 255) {
+        const uint8_t t = static_cast<uint8_t>(config.whiten_threshold);
+        if (result.channels() == 4) {
+            cv::Mat toned;
+            cv::cvtColor(result, toned, cv::COLOR_BGRA2GRAY);
+            result.setTo(cv::Scalar::all(255), toned > t);
+        } else {
+            cv::Mat toned;
+            if (result.channels() == 3) {
+                cv::cvtColor(result, toned, cv::COLOR_BGR2GRAY);
+            } else {
+                toned = result.clone();
+            }
+            const KernelTable& k = CpuDispatch::kernels();
+            for (int y = 0; y < result.rows; y++) {
+                if (result.channels() == 1) {
+                    k.whiten_gray(toned.ptr<uint8_t>(y), result.ptr<uint8_t>(y), result.cols, t);
+                } else {
+                    k.whiten_bgr(toned.ptr<uint8_t>(y), result.ptr<uint8_t>(y), result.cols, t);
+                }
+            }
+        }
+    }
+    return result;
+}
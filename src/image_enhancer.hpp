@@ -23,6 +23,37 @@ struct EnhanceConfig {
     }
 };
 
+// Point-wise tone operations, composed into one 256-entry curve and
+// applied in a single LUT pass (per channel for color images).
+// Order: brightness, percentile stretch, gain, gamma. Whitening follows as
+// a separate pass masked on the toned luminance (as whitenBackground).
+struct ToneCurveConfig {
+    bool percentile_stretch;    // Map [low, high] percentile levels to 0-255
+    float low_percentile;       // 0-1 (default: 0.005)
+    float high_percentile;      // 0-1 (default: 0.995)
+    bool auto_brightness;       // Shift mean toward target (as adjustBrightness)
+    float target_brightness;    // 0-1 (default: 0.5)
+    float gain;                 // Contrast around mid-gray (1 = none)
+    float gamma;                // out = in^gamma on 0-1 (1 = none)
+    int whiten_threshold;       // Pixels with gray above go to white (-1 = off)
+
+    ToneCurveConfig() {
+        percentile_stretch = false;
+        low_percentile = 0.005f;
+        high_percentile = 0.995f;
+        auto_brightness = false;
+        target_brightness = 0.5f;
+        gain = 1.0f;
+        gamma = 1.0f;
+        whiten_threshold = -1;
+    }
+
+    bool isIdentity() const {
+        return !percentile_stretch && !auto_brightness && gain == 1.0f && gamma == 1.0f &&
+               whiten_threshold < 0;
+    }
+};
+
 class ImageEnhancer {
 public:
     ImageEnhancer();
@@ -42,8 +73,22 @@ public:
     cv::Mat adaptiveBinarize(const cv::Mat& input, int blockSize = 11, double C = 2);
     cv::Mat sauvolaBinarize(const cv::Mat& input, int windowSize = 15, double k = 0.2, double R = 128);
 
+    // Notch out periodic spectrum peaks (moire from photographed screens).
+    // Peaks come from a grid of MOIRE_TILE tiles; the notch is applied by
+    // overlap-add over the same tiles, so memory stays bounded by tile rows.
+    cv::Mat removeMoire(const cv::Mat& input, float peakThreshold = 2.5f);
+
+    // Fused tone stage: histogram from a thumbnail, one LUT pass, then the
+    // optional whitening pass
+    cv::Mat applyToneCurve(const cv::Mat& input, const ToneCurveConfig& config);
+
+    // 1x256 CV_8U curve from a normalized 256-bin gray histogram
+    static cv::Mat buildToneCurve(const float* histogram, const ToneCurveConfig& config);
+
 private:
-    float calculateBrightness(const cv::Mat& input);
+    static const int MOIRE_TILE = 256;  // Power of two; even, for 50% overlap
+
+    cv::Ptr<cv::CLAHE> clahe_;  // Reconfigured per call instead of recreated
 };
 
 #endif // IMAGE_ENHANCER_HPP
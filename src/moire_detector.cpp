@@ -0,0 +1,81 @@
+#include "moire_detector.hpp"
+#include <algorithm>
+#include <cmath>
+
+MoireDetector::MoireDetector() {}
+
+MoireDetector::~MoireDetector() {}
+
+float MoireDetector::peakRatio(const cv::Mat& patch) {
+    if (window_.empty()) {
+        cv::createHanningWindow(window_, cv::Size(PATCH_SIZE, PATCH_SIZE), CV_32F);
+    }
+
+    cv::Mat f;
+    patch.convertTo(f, CV_32F);
+    f -= cv::mean(f)[0];
+    f = f.mul(window_);
+
+    cv::Mat spectrum;
+    cv::dft(f, spectrum, cv::DFT_COMPLEX_OUTPUT);
+
+    cv::Mat planes[2];
+    cv::split(spectrum, planes);
+    cv::Mat mag;
+    cv::magnitude(planes[0], planes[1], mag);
+
+    // Upper half-plane only (the spectrum of a real signal is symmetric),
+    // annulus between MIN_RADIUS and Nyquist
+    const int n = PATCH_SIZE;
+    std::vector<float> band;
+    band.reserve(n * n / 2);
+    float peak = 0.0f;
+    for (int v = 0; v <= n / 2; v++) {
+        const float* row = mag.ptr<float>(v);
+        for (int u = 0; u < n; u++) {
+            int fu = u <= n / 2 ? u : u - n;
+            int r2 = fu * fu + v * v;
+            if (r2 < MIN_RADIUS * MIN_RADIUS || r2 > (n / 2) * (n / 2)) continue;
+            band.push_back(row[u]);
+            peak = std::max(peak, row[u]);
+        }
+    }
+
+    if (band.empty()) {
+        return 0.0f;
+    }
+
+    std::nth_element(band.begin(), band.begin() + band.size() / 2, band.end());
+    float median = band[band.size() / 2];
+
+    return median > 1e-3f ? peak / median : 0.0f;
+}
+
+float MoireDetector::score(const cv::Mat& frame, const std::vector<cv::Point2f>& corners) {
+    if (frame.cols < PATCH_SIZE || frame.rows < PATCH_SIZE) {
+        return 0.0f;
+    }
+
+    cv::Point2f center(frame.cols * 0.5f, frame.rows * 0.5f);
+    if (corners.size() == 4) {
+        center = (corners[0] + corners[1] + corners[2] + corners[3]) * 0.25f;
+    }
+
+    int x = std::min(std::max(0, static_cast<int>(center.x) - PATCH_SIZE / 2), frame.cols - PATCH_SIZE);
+    int y = std::min(std::max(0, static_cast<int>(center.y) - PATCH_SIZE / 2), frame.rows - PATCH_SIZE);
+    cv::Mat patch = frame(cv::Rect(x, y, PATCH_SIZE, PATCH_SIZE));
+
+    // Full resolution: the display's pixel grid is lost by any downscale
+    cv::Mat gray;
+    if (patch.channels() == 3) {
+        cv::cvtColor(patch, gray, cv::COLOR_BGR2GRAY);
+    } else if (patch.channels() == 4) {
+        cv::cvtColor(patch, gray, cv::COLOR_BGRA2GRAY);
+    } else {
+        gray = patch;
+    }
+
+    // Paper peaks stay below ~10x the band median; screens reach 40x+
+    float ratio = peakRatio(gray);
+    return std::min(1.0f, std::max(0.0f, (ratio - 10.0f) / 30.0f));
+}
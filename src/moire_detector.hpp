@@ -0,0 +1,29 @@
+#ifndef MOIRE_DETECTOR_HPP
+#define MOIRE_DETECTOR_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// Detects screen captures / moire: a photographed display shows narrow
+// periodic peaks in the high-frequency spectrum that paper never has.
+// Works on one small full-resolution gray patch per frame.
+class MoireDetector {
+public:
+    MoireDetector();
+    ~MoireDetector();
+
+    // frame: BGR/BGRA/gray; corners: document quad (patch taken at its center)
+    // or empty for the frame center. Returns 0-1.
+    float score(const cv::Mat& frame, const std::vector<cv::Point2f>& corners);
+
+    // Peak-to-background ratio of the strongest high-frequency peak
+    float peakRatio(const cv::Mat& patch);
+
+private:
+    cv::Mat window_;  // Hann window, created once
+
+    static const int PATCH_SIZE = 128;
+    static const int MIN_RADIUS = 12;  // Bins; lower frequencies are layout/text lines
+};
+
+#endif // MOIRE_DETECTOR_HPP
@@ -0,0 +1,95 @@
+#include "motion_tracker.hpp"
+#include <algorithm>
+#include <cmath>
+
+MotionTracker::MotionTracker() {}
+
+MotionTracker::~MotionTracker() {}
+
+void MotionTracker::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    gyro_.clear();
+    accel_.clear();
+    gravity_init_ = false;
+    has_gyro_ = false;
+    has_accel_ = false;
+}
+
+void MotionTracker::push(std::deque<Sample>& window, const Sample& s) {
+    // Drop out-of-order samples and anything older than the window
+    if (!window.empty() && s.timestamp_ns < window.back().timestamp_ns) {
+        window.clear();
+    }
+    window.push_back(s);
+    while (window.front().timestamp_ns < s.timestamp_ns - WINDOW_NS) {
+        window.pop_front();
+    }
+}
+
+float MotionTracker::peak(const std::deque<Sample>& window) {
+    float m = 0.0f;
+    for (const auto& s : window) {
+        m = std::max(m, s.magnitude);
+    }
+    return m;
+}
+
+bool MotionTracker::fresh(bool has, std::chrono::steady_clock::time_point last,
+                          std::chrono::steady_clock::time_point now) {
+    return has && std::chrono::duration_cast<std::chrono::milliseconds>(now - last).count() <= STALE_MS;
+}
+
+void MotionTracker::addSample(ImuSampleType type, float x, float y, float z, int64_t timestamp_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (type == IMU_GYROSCOPE) {
+        push(gyro_, {timestamp_ns, std::sqrt(x * x + y * y + z * z)});
+        last_gyro_ = std::chrono::steady_clock::now();
+        has_gyro_ = true;
+    } else if (type == IMU_ACCELEROMETER) {
+        // Low-pass gravity estimate; the residual is hand motion
+        const float alpha = 0.9f;
+        if (!gravity_init_) {
+            gravity_[0] = x;
+            gravity_[1] = y;
+            gravity_[2] = z;
+            gravity_init_ = true;
+        } else {
+            gravity_[0] = alpha * gravity_[0] + (1.0f - alpha) * x;
+            gravity_[1] = alpha * gravity_[1] + (1.0f - alpha) * y;
+            gravity_[2] = alpha * gravity_[2] + (1.0f - alpha) * z;
+        }
+        float lx = x - gravity_[0];
+        float ly = y - gravity_[1];
+        float lz = z - gravity_[2];
+        push(accel_, {timestamp_ns, std::sqrt(lx * lx + ly * ly + lz * lz)});
+        last_accel_ = std::chrono::steady_clock::now();
+        has_accel_ = true;
+    }
+}
+
+MotionState MotionTracker::state() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    MotionState state;
+
+    const auto now = std::chrono::steady_clock::now();
+    const bool gyroFresh = fresh(has_gyro_, last_gyro_, now);
+    const bool accelFresh = fresh(has_accel_, last_accel_, now);
+    if (!gyroFresh && !accelFresh) {
+        return state;
+    }
+
+    // A silent sensor's window is ignored, not held at its last peak
+    state.active = true;
+    state.angular_speed = gyroFresh ? peak(gyro_) : 0.0f;
+    state.linear_accel = accelFresh ? peak(accel_) : 0.0f;
+
+    // Rotation dominates blur at document distances; translation is a backup
+    float gyroMotion = state.angular_speed / GYRO_LIMIT;
+    float accelMotion = state.linear_accel / ACCEL_LIMIT;
+    state.motion_score = std::min(1.0f, std::max(gyroMotion, accelMotion));
+    state.stability = 1.0f - state.motion_score;
+    state.fast_motion = state.motion_score >= FAST_MOTION;
+
+    return state;
+}
@@ -0,0 +1,74 @@
+#ifndef MOTION_TRACKER_HPP
+#define MOTION_TRACKER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+// IMU sample types pushed by the host
+enum ImuSampleType {
+    IMU_GYROSCOPE = 0,      // rad/s
+    IMU_ACCELEROMETER = 1   // m/s^2, gravity included
+};
+
+struct MotionState {
+    bool active;         // Recent IMU samples are available
+    bool fast_motion;    // Device moving too fast for a usable frame
+    float motion_score;  // 0-1, 0 = perfectly still
+    float stability;     // 0-1, 1 - motion_score
+    float angular_speed; // Peak rad/s over the window
+    float linear_accel;  // Peak m/s^2 (gravity removed) over the window
+
+    MotionState()
+        : active(false), fast_motion(false), motion_score(0),
+          stability(0), angular_speed(0), linear_accel(0) {}
+};
+
+// Device motion from gyroscope/accelerometer samples.
+// Reacts within one sensor period, so frames can be gated before any
+// image analysis is done. Samples may arrive on a sensor thread.
+class MotionTracker {
+public:
+    MotionTracker();
+    ~MotionTracker();
+
+    void reset();
+
+    // timestamp_ns: sensor timestamp (monotonic, any epoch)
+    void addSample(ImuSampleType type, float x, float y, float z, int64_t timestamp_ns);
+
+    // Motion over the last window; inactive if no samples arrived recently
+    MotionState state() const;
+
+private:
+    struct Sample {
+        int64_t timestamp_ns;
+        float magnitude;
+    };
+
+    static void push(std::deque<Sample>& window, const Sample& s);
+    static float peak(const std::deque<Sample>& window);
+    static bool fresh(bool has, std::chrono::steady_clock::time_point last,
+                      std::chrono::steady_clock::time_point now);
+
+    mutable std::mutex mutex_;
+    std::deque<Sample> gyro_;
+    std::deque<Sample> accel_;
+    float gravity_[3] = {0, 0, 0};
+    bool gravity_init_ = false;
+    // Per sensor: one sensor going silent (throttled, unregistered) must
+    // not keep its last peak alive while the other keeps the IMU active
+    std::chrono::steady_clock::time_point last_gyro_;
+    std::chrono::steady_clock::time_point last_accel_;
+    bool has_gyro_ = false;
+    bool has_accel_ = false;
+
+    static const int64_t WINDOW_NS = 150000000;  // Motion window (150 ms)
+    static const int STALE_MS = 300;             // IMU considered off after this gap
+    static constexpr float GYRO_LIMIT = 0.6f;    // rad/s that maps to motion 1
+    static constexpr float ACCEL_LIMIT = 2.0f;   // m/s^2 that maps to motion 1
+    static constexpr float FAST_MOTION = 0.9f;   // Motion score above which analysis is skipped
+};
+
+#endif // MOTION_TRACKER_HPP
@@ -0,0 +1,89 @@
+#include "occlusion_detector.hpp"
+#include <algorithm>
+#include <cmath>
+
+OcclusionDetector::OcclusionDetector() {}
+
+OcclusionDetector::~OcclusionDetector() {}
+
+cv::Mat OcclusionDetector::skinMask(const cv::Mat& thumb) {
+    cv::Mat ycrcb;
+    cv::cvtColor(thumb, ycrcb, cv::COLOR_BGR2YCrCb);
+
+    // Classic skin box in Cr/Cb; Y bounds drop deep shadows and specular highlights
+    cv::Mat mask;
+    cv::inRange(ycrcb, cv::Scalar(40, 135, 85), cv::Scalar(240, 180, 135), mask);
+
+    // Remove isolated pixels (print, noise)
+    cv::morphologyEx(mask, mask, cv::MORPH_OPEN,
+                     cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(3, 3)));
+    return mask;
+}
+
+OcclusionResult OcclusionDetector::detect(const cv::Mat& frame, const std::vector<cv::Point2f>& corners) {
+    OcclusionResult result;
+
+    if (frame.empty() || corners.size() != 4) {
+        return result;
+    }
+
+    // Thumbnail (skin regions are large; color is all that matters)
+    float scale = static_cast<float>(THUMB_SIZE) / std::max(frame.cols, frame.rows);
+    scale = std::min(scale, 1.0f);
+    cv::Mat thumb;
+    cv::resize(frame, thumb, cv::Size(), scale, scale, cv::INTER_AREA);
+    if (thumb.channels() == 4) {
+        cv::cvtColor(thumb, thumb, cv::COLOR_BGRA2BGR);
+    } else if (thumb.channels() == 1) {
+        return result;
+    }
+
+    cv::Mat skin = skinMask(thumb);
+
+    std::vector<cv::Point> quad;
+    for (const auto& pt : corners) {
+        quad.push_back(cv::Point(cvRound(pt.x * scale), cvRound(pt.y * scale)));
+    }
+
+    cv::Mat inside = cv::Mat::zeros(thumb.size(), CV_8UC1);
+    cv::fillConvexPoly(inside, quad, cv::Scalar(255));
+    int insideArea = cv::countNonZero(inside);
+    if (insideArea < 100) {
+        return result;
+    }
+
+    // Beige/kraft paper matches the skin box; the check would fire everywhere
+    cv::Mat skinInside;
+    cv::bitwise_and(skin, inside, skinInside);
+    if (cv::countNonZero(skinInside) > insideArea / 2) {
+        return result;
+    }
+    result.reliable = true;
+
+    // Band just inside each edge: a thumb on the edge intrudes into the page,
+    // a skin-toned table outside it does not
+    double perimeter = cv::arcLength(quad, true);
+    int thickness = std::max(3, static_cast<int>(perimeter * 0.02));
+
+    cv::Mat band(thumb.size(), CV_8UC1);
+    cv::Mat hit;
+    for (int e = 0; e < 4; e++) {
+        band.setTo(cv::Scalar(0));
+        cv::line(band, quad[e], quad[(e + 1) % 4], cv::Scalar(255), thickness * 2);
+        cv::bitwise_and(band, inside, band);
+
+        int bandArea = cv::countNonZero(band);
+        if (bandArea == 0) continue;
+
+        cv::bitwise_and(band, skinInside, hit);
+        result.coverage[e] = static_cast<float>(cv::countNonZero(hit)) / bandArea;
+
+        if (result.coverage[e] > edge_threshold_) {
+            result.edges |= (1 << e);
+        }
+        result.score = std::max(result.score, result.coverage[e]);
+    }
+
+    result.occluded = result.edges != 0;
+    return result;
+}
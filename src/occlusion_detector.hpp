@@ -0,0 +1,48 @@
+#ifndef OCCLUSION_DETECTOR_HPP
+#define OCCLUSION_DETECTOR_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// Occluded quad edges (bitmask)
+enum OccludedEdge {
+    OCCLUDED_TOP = 1,
+    OCCLUDED_RIGHT = 2,
+    OCCLUDED_BOTTOM = 4,
+    OCCLUDED_LEFT = 8
+};
+
+struct OcclusionResult {
+    bool reliable;         // False when the page itself is skin-toned (check skipped)
+    bool occluded;
+    int edges;             // OccludedEdge bitmask
+    float coverage[4];     // Skin fraction along each edge (top, right, bottom, left)
+    float score;           // 0-1, max edge coverage
+
+    OcclusionResult() : reliable(false), occluded(false), edges(0), score(0) {
+        coverage[0] = coverage[1] = coverage[2] = coverage[3] = 0;
+    }
+};
+
+// Detects fingers/hands over the document edges: skin-colored pixels
+// (YCrCb box) on a small thumbnail, intersected with a band just inside
+// each quad edge.
+class OcclusionDetector {
+public:
+    OcclusionDetector();
+    ~OcclusionDetector();
+
+    // frame: BGR/BGRA; corners: TL,TR,BR,BL in frame coordinates
+    OcclusionResult detect(const cv::Mat& frame, const std::vector<cv::Point2f>& corners);
+
+    void setEdgeThreshold(float threshold) { edge_threshold_ = threshold; }
+
+private:
+    cv::Mat skinMask(const cv::Mat& thumb);
+
+    float edge_threshold_ = 0.12f;  // Edge coverage above which the edge is occluded
+
+    static const int THUMB_SIZE = 160;
+};
+
+#endif // OCCLUSION_DETECTOR_HPP
@@ -0,0 +1,136 @@
+#include "page_hasher.hpp"
+#include <algorithm>
+
+uint64_t PageHasher::computeHash(const cv::Mat& page) {
+    if (page.empty()) {
+        return 0;
+    }
+
+    cv::Mat gray;
+    if (page.channels() == 3) {
+        cv::cvtColor(page, gray, cv::COLOR_BGR2GRAY);
+    } else if (page.channels() == 4) {
+        cv::cvtColor(page, gray, cv::COLOR_BGRA2GRAY);
+    } else {
+        gray = page;
+    }
+
+    cv::Mat small, floatSmall, dct;
+    cv::resize(gray, small, cv::Size(HASH_SIZE, HASH_SIZE), 0, 0, cv::INTER_AREA);
+    small.convertTo(floatSmall, CV_32F);
+    cv::dct(floatSmall, dct);
+
+    // Low-frequency block, compared against its median (DC term excluded)
+    float values[LOW_FREQ * LOW_FREQ];
+    for (int y = 0; y < LOW_FREQ; y++) {
+        for (int x = 0; x < LOW_FREQ; x++) {
+            values[y * LOW_FREQ + x] = dct.at<float>(y, x);
+        }
+    }
+
+    float sorted[LOW_FREQ * LOW_FREQ - 1];
+    std::copy(values + 1, values + LOW_FREQ * LOW_FREQ, sorted);
+    const int n = LOW_FREQ * LOW_FREQ - 1;
+    std::nth_element(sorted, sorted + n / 2, sorted + n);
+    float median = sorted[n / 2];
+
+    uint64_t hash = 0;
+    for (int i = 0; i < LOW_FREQ * LOW_FREQ; i++) {
+        if (i > 0 && values[i] > median) {
+            hash |= (1ULL << i);
+        }
+    }
+
+    return hash;
+}
+
+uint64_t PageHasher::computeHash(const cv::Mat& frame, const std::vector<cv::Point2f>& corners) {
+    if (frame.empty()) {
+        return 0;
+    }
+
+    if (corners.size() != 4) {
+        return computeHash(frame);
+    }
+
+    // Downscale the frame first so the thumbnail warp reads few pixels
+    const int THUMB = HASH_SIZE * 2;
+    float scale = std::min(1.0f, static_cast<float>(THUMB * 4) / std::max(frame.cols, frame.rows));
+
+    cv::Mat small;
+    if (scale < 1.0f) {
+        cv::resize(frame, small, cv::Size(), scale, scale, cv::INTER_AREA);
+    } else {
+        small = frame;
+    }
+
+    std::vector<cv::Point2f> src(4);
+    for (int i = 0; i < 4; i++) {
+        src[i] = corners[i] * scale;
+    }
+    std::vector<cv::Point2f> dst = {
+        cv::Point2f(0, 0),
+        cv::Point2f(THUMB - 1.0f, 0),
+        cv::Point2f(THUMB - 1.0f, THUMB - 1.0f),
+        cv::Point2f(0, THUMB - 1.0f)
+    };
+
+    cv::Mat M = cv::getPerspectiveTransform(src, dst);
+    cv::Mat thumb;
+    cv::warpPerspective(small, thumb, M, cv::Size(THUMB, THUMB), cv::INTER_LINEAR, cv::BORDER_REPLICATE);
+
+    return computeHash(thumb);
+}
+
+int PageHasher::hammingDistance(uint64_t a, uint64_t b) {
+    uint64_t x = a ^ b;
+    int count = 0;
+    while (x) {
+        x &= x - 1;
+        count++;
+    }
+    return count;
+}
+
+PageHashIndex::PageHashIndex() {}
+
+PageHashIndex::~PageHashIndex() {}
+
+int PageHashIndex::add(uint64_t hash) {
+    Entry entry;
+    entry.page_id = next_id_++;
+    entry.hash = hash;
+    entries_.push_back(entry);
+    return entry.page_id;
+}
+
+bool PageHashIndex::remove(int page_id) {
+    auto it = std::find_if(entries_.begin(), entries_.end(),
+                           [page_id](const Entry& e) { return e.page_id == page_id; });
+    if (it == entries_.end()) {
+        return false;
+    }
+    entries_.erase(it);
+    return true;
+}
+
+void PageHashIndex::clear() {
+    entries_.clear();
+    next_id_ = 0;
+}
+
+DuplicateMatch PageHashIndex::findDuplicate(uint64_t hash, int maxDistance) const {
+    DuplicateMatch match;
+
+    // Sessions hold tens of pages; a linear scan of 64-bit XORs is plenty
+    for (const auto& entry : entries_) {
+        int d = PageHasher::hammingDistance(hash, entry.hash);
+        if (d <= maxDistance && d < match.distance) {
+            match.found = true;
+            match.page_id = entry.page_id;
+            match.distance = d;
+        }
+    }
+
+    return match;
+}
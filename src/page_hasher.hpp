@@ -0,0 +1,56 @@
+#ifndef PAGE_HASHER_HPP
+#define PAGE_HASHER_HPP
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <vector>
+
+struct DuplicateMatch {
+    bool found;
+    int page_id;   // Matching page id (-1 if none)
+    int distance;  // Hamming distance in bits (0-64)
+
+    DuplicateMatch() : found(false), page_id(-1), distance(64) {}
+};
+
+// 64-bit DCT perceptual hash of a rectified page thumbnail
+class PageHasher {
+public:
+    // page: rectified page (any size, 1/3/4 channels)
+    static uint64_t computeHash(const cv::Mat& page);
+
+    // Hash straight from a full frame + quad without full-resolution warp
+    static uint64_t computeHash(const cv::Mat& frame, const std::vector<cv::Point2f>& corners);
+
+    static int hammingDistance(uint64_t a, uint64_t b);
+
+private:
+    static const int HASH_SIZE = 32;  // DCT input size
+    static const int LOW_FREQ = 8;    // 8x8 low-frequency block -> 64 bits
+};
+
+// Session-level index of page hashes for near-duplicate detection
+class PageHashIndex {
+public:
+    PageHashIndex();
+    ~PageHashIndex();
+
+    int add(uint64_t hash);  // Returns new page id
+    bool remove(int page_id);
+    void clear();
+    int size() const { return static_cast<int>(entries_.size()); }
+
+    // Nearest stored page within maxDistance bits
+    DuplicateMatch findDuplicate(uint64_t hash, int maxDistance = 10) const;
+
+private:
+    struct Entry {
+        int page_id;
+        uint64_t hash;
+    };
+
+    std::vector<Entry> entries_;
+    int next_id_ = 0;
+};
+
+#endif // PAGE_HASHER_HPP
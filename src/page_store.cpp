@@ -0,0 +1,407 @@
+#include "page_store.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char FILE_MAGIC[8] = {'D', 'C', 'P', 'A', 'G', 'E', 'S', '1'};
+const uint32_t FILE_VERSION = 1;
+const uint32_t RECORD_MAGIC = 0x45474150;  // "PAGE"
+const uint64_t RECORD_ALIGN = 64;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+};
+
+struct RecordHeader {
+    uint32_t magic;         // RECORD_MAGIC once pixels are fully written
+    uint32_t header_size;
+    int32_t width;
+    int32_t height;
+    int32_t channels;
+    int32_t stride;
+    int32_t enhance_mode;
+    int32_t thumb_width;
+    int32_t thumb_height;
+    int32_t thumb_stride;
+    uint64_t data_size;
+    uint64_t thumb_size;
+    float corners[8];
+};
+
+uint64_t alignUp(uint64_t value) {
+    return (value + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+}
+
+const uint64_t DATA_START = alignUp(sizeof(FileHeader));
+const uint64_t RECORD_HEADER_SIZE = alignUp(sizeof(RecordHeader));
+
+#ifndef _WIN32
+bool writeAll(int fd, const void* data, size_t size, uint64_t offset) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        ssize_t n = pwrite(fd, p, size, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += n;
+        size -= static_cast<size_t>(n);
+        offset += static_cast<uint64_t>(n);
+    }
+    return true;
+}
+
+bool readAll(int fd, void* data, size_t size, uint64_t offset) {
+    uint8_t* p = static_cast<uint8_t*>(data);
+    while (size > 0) {
+        ssize_t n = pread(fd, p, size, static_cast<off_t>(offset));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= static_cast<size_t>(n);
+        offset += static_cast<uint64_t>(n);
+    }
+    return true;
+}
+#endif
+
+bool validRecord(const RecordHeader& h) {
+    if (h.magic != RECORD_MAGIC || h.header_size != sizeof(RecordHeader)) return false;
+    if (h.width <= 0 || h.height <= 0) return false;
+    if (h.channels != 1 && h.channels != 3 && h.channels != 4) return false;
+    if (h.stride < h.width * h.channels || h.thumb_stride < h.thumb_width * h.channels) return false;
+    if (h.data_size != static_cast<uint64_t>(h.stride) * h.height) return false;
+    if (h.thumb_size != static_cast<uint64_t>(h.thumb_stride) * h.thumb_height) return false;
+    return true;
+}
+
+}  // namespace
+
+PageStore::PageStore() {}
+
+PageStore::~PageStore() {
+    close();
+}
+
+void PageStore::fail(const std::string& message) const {
+    error_ = message;
+}
+
+std::string PageStore::lastError() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return error_;
+}
+
+bool PageStore::isOpen() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return fd_ >= 0;
+}
+
+#ifdef _WIN32
+
+bool PageStore::open(const std::string&, bool) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fail("Page store is not supported on this platform");
+    return false;
+}
+
+void PageStore::close() {}
+
+int PageStore::append(const cv::Mat&, int, const float*) { return -1; }
+
+bool PageStore::rebuildIndex(uint64_t) { return false; }
+
+bool PageStore::mapRange(uint64_t, size_t, PageView&) const { return false; }
+
+void PageStore::releaseView(PageView& view) { view = PageView(); }
+
+bool PageStore::sync() { return false; }
+
+#else
+
+bool PageStore::open(const std::string& path, bool resume) {
+    close();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    error_.clear();
+
+    int flags = O_RDWR | O_CREAT | O_CLOEXEC;
+    if (!resume) {
+        flags |= O_TRUNC;
+    }
+
+    int fd = ::open(path.c_str(), flags, 0600);
+    if (fd < 0) {
+        fail(std::string("Cannot open page store: ") + strerror(errno));
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        fail(std::string("Cannot stat page store: ") + strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    fd_ = fd;
+    const uint64_t size = static_cast<uint64_t>(st.st_size);
+
+    if (size >= sizeof(FileHeader)) {
+        FileHeader header;
+        if (!readAll(fd_, &header, sizeof(header), 0) ||
+            memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+            header.version != FILE_VERSION) {
+            fail("Not a page store file");
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        return rebuildIndex(size);
+    }
+
+    // New (or truncated before the header was complete) file
+    FileHeader header;
+    memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FILE_VERSION;
+    header.header_size = sizeof(FileHeader);
+
+    if (ftruncate(fd_, 0) != 0 || !writeAll(fd_, &header, sizeof(header), 0)) {
+        fail(std::string("Cannot write page store header: ") + strerror(errno));
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    end_ = DATA_START;
+    return true;
+}
+
+bool PageStore::rebuildIndex(uint64_t fileSize) {
+    pages_.clear();
+
+    uint64_t offset = DATA_START;
+    while (offset + RECORD_HEADER_SIZE <= fileSize) {
+        RecordHeader h;
+        if (!readAll(fd_, &h, sizeof(h), offset) || !validRecord(h)) {
+            break;
+        }
+
+        uint64_t recordEnd = offset + RECORD_HEADER_SIZE + h.data_size + h.thumb_size;
+        if (recordEnd > fileSize) {
+            break;
+        }
+
+        Entry entry;
+        entry.info.width = h.width;
+        entry.info.height = h.height;
+        entry.info.channels = h.channels;
+        entry.info.stride = h.stride;
+        entry.info.enhance_mode = h.enhance_mode;
+        memcpy(entry.info.corners, h.corners, sizeof(h.corners));
+        entry.info.thumb_width = h.thumb_width;
+        entry.info.thumb_height = h.thumb_height;
+        entry.thumb_stride = h.thumb_stride;
+        entry.data_offset = offset + RECORD_HEADER_SIZE;
+        entry.thumb_offset = entry.data_offset + h.data_size;
+        pages_.push_back(entry);
+
+        offset = alignUp(recordEnd);
+    }
+
+    // Drop a torn tail so the next append starts from a clean record
+    end_ = offset;
+    if (fileSize > end_ && ftruncate(fd_, static_cast<off_t>(end_)) != 0) {
+        fail(std::string("Cannot truncate torn page: ") + strerror(errno));
+    }
+
+    return true;
+}
+
+void PageStore::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    pages_.clear();
+    end_ = 0;
+}
+
+int PageStore::append(const cv::Mat& page, int enhanceMode, const float* corners) {
+    if (page.empty() || page.depth() != CV_8U ||
+        (page.channels() != 1 && page.channels() != 3 && page.channels() != 4)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fail("Invalid page image");
+        return -1;
+    }
+
+    // Thumbnail before taking the lock (only the write is serialized)
+    cv::Mat thumb;
+    float scale = std::min(1.0f, static_cast<float>(THUMBNAIL_SIZE) / std::max(page.cols, page.rows));
+    cv::Size thumbSize(std::max(1, static_cast<int>(page.cols * scale)),
+                       std::max(1, static_cast<int>(page.rows * scale)));
+    cv::resize(page, thumb, thumbSize, 0, 0, cv::INTER_AREA);
+
+    RecordHeader h;
+    memset(&h, 0, sizeof(h));
+    h.header_size = sizeof(RecordHeader);
+    h.width = page.cols;
+    h.height = page.rows;
+    h.channels = page.channels();
+    h.stride = page.cols * page.channels();
+    h.enhance_mode = enhanceMode;
+    h.thumb_width = thumb.cols;
+    h.thumb_height = thumb.rows;
+    h.thumb_stride = thumb.cols * thumb.channels();
+    h.data_size = static_cast<uint64_t>(h.stride) * h.height;
+    h.thumb_size = static_cast<uint64_t>(h.thumb_stride) * h.thumb_height;
+    if (corners) {
+        memcpy(h.corners, corners, sizeof(h.corners));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (fd_ < 0) {
+        fail("Page store is not open");
+        return -1;
+    }
+
+    const uint64_t offset = end_;
+    const uint64_t dataOffset = offset + RECORD_HEADER_SIZE;
+
+    // Header without magic, pixels row by row, then commit the magic
+    bool ok = writeAll(fd_, &h, sizeof(h), offset);
+    for (int y = 0; ok && y < page.rows; y++) {
+        ok = writeAll(fd_, page.ptr(y), static_cast<size_t>(h.stride),
+                      dataOffset + static_cast<uint64_t>(y) * h.stride);
+    }
+    const uint64_t thumbOffset = dataOffset + h.data_size;
+    if (ok) {
+        cv::Mat thumbCont = thumb.isContinuous() ? thumb : thumb.clone();
+        ok = writeAll(fd_, thumbCont.data, static_cast<size_t>(h.thumb_size), thumbOffset);
+    }
+    if (ok) {
+        h.magic = RECORD_MAGIC;
+        ok = writeAll(fd_, &h.magic, sizeof(h.magic), offset);
+    }
+
+    if (!ok) {
+        // end_ is unchanged, so the next append overwrites the partial
+        // record; the resume scan drops it if we never get there
+        fail(std::string("Cannot write page: ") + strerror(errno));
+        return -1;
+    }
+
+    Entry entry;
+    entry.info.width = h.width;
+    entry.info.height = h.height;
+    entry.info.channels = h.channels;
+    entry.info.stride = h.stride;
+    entry.info.enhance_mode = h.enhance_mode;
+    memcpy(entry.info.corners, h.corners, sizeof(h.corners));
+    entry.info.thumb_width = h.thumb_width;
+    entry.info.thumb_height = h.thumb_height;
+    entry.thumb_stride = h.thumb_stride;
+    entry.data_offset = dataOffset;
+    entry.thumb_offset = thumbOffset;
+    pages_.push_back(entry);
+
+    end_ = alignUp(thumbOffset + h.thumb_size);
+    return static_cast<int>(pages_.size()) - 1;
+}
+
+bool PageStore::mapRange(uint64_t offset, size_t size, PageView& view) const {
+    // mmap offsets must be page aligned (4K or 16K depending on device)
+    const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    const uint64_t aligned = offset - offset % pageSize;
+    const size_t delta = static_cast<size_t>(offset - aligned);
+
+    void* base = mmap(nullptr, size + delta, PROT_READ, MAP_SHARED, fd_, static_cast<off_t>(aligned));
+    if (base == MAP_FAILED) {
+        fail(std::string("Cannot map page: ") + strerror(errno));
+        return false;
+    }
+
+    view.mapping = base;
+    view.mapping_size = size + delta;
+    view.data = static_cast<const uint8_t*>(base) + delta;
+    return true;
+}
+
+void PageStore::releaseView(PageView& view) {
+    if (view.mapping) {
+        munmap(view.mapping, view.mapping_size);
+    }
+    view = PageView();
+}
+
+bool PageStore::sync() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return fd_ >= 0 && fsync(fd_) == 0;
+}
+
+#endif
+
+int PageStore::pageCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(pages_.size());
+}
+
+bool PageStore::pageInfo(int index, StoredPageInfo& info) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (index < 0 || index >= static_cast<int>(pages_.size())) {
+        return false;
+    }
+
+    info = pages_[index].info;
+    return true;
+}
+
+bool PageStore::mapPage(int index, bool thumbnail, PageView& view) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (fd_ < 0 || index < 0 || index >= static_cast<int>(pages_.size())) {
+        fail("Invalid page index");
+        return false;
+    }
+
+    const Entry& entry = pages_[index];
+    PageView mapped;
+    mapped.channels = entry.info.channels;
+    if (thumbnail) {
+        mapped.width = entry.info.thumb_width;
+        mapped.height = entry.info.thumb_height;
+        mapped.stride = entry.thumb_stride;
+    } else {
+        mapped.width = entry.info.width;
+        mapped.height = entry.info.height;
+        mapped.stride = entry.info.stride;
+    }
+
+    uint64_t offset = thumbnail ? entry.thumb_offset : entry.data_offset;
+    size_t size = static_cast<size_t>(mapped.stride) * mapped.height;
+    if (!mapRange(offset, size, mapped)) {
+        return false;
+    }
+
+    view = mapped;
+    return true;
+}
+
+uint64_t PageStore::fileSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return end_;
+}
@@ -0,0 +1,96 @@
+#ifndef PAGE_STORE_HPP
+#define PAGE_STORE_HPP
+
+#include <opencv2/opencv.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct StoredPageInfo {
+    int width;
+    int height;
+    int channels;
+    int stride;
+    int enhance_mode;      // EnhanceMode the page was produced with
+    float corners[8];      // Source quad in the captured frame (TL,TR,BR,BL)
+    int thumb_width;
+    int thumb_height;
+
+    StoredPageInfo()
+        : width(0), height(0), channels(0), stride(0), enhance_mode(0), thumb_width(0), thumb_height(0) {
+        memset(corners, 0, sizeof(corners));
+    }
+};
+
+// Zero-copy read-only view of stored pixels. Owns its own mapping, so it
+// stays valid after further appends or closing the store until released.
+struct PageView {
+    const uint8_t* data;
+    int width;
+    int height;
+    int channels;
+    int stride;
+    void* mapping;
+    size_t mapping_size;
+
+    PageView()
+        : data(nullptr), width(0), height(0), channels(0), stride(0), mapping(nullptr), mapping_size(0) {}
+};
+
+// Append-only file of rectified pages for multi-page sessions. Pages are
+// written through the file (not kept in RAM) and read back via mmap, so
+// memory use does not grow with the page count.
+//
+// Layout: file header, then one record per page at 64-byte aligned
+// offsets: record header (geometry, mode, corners) + pixels + thumbnail.
+// A record's magic is written last; on resume the index is rebuilt by
+// scanning records and a torn tail (crash mid-append) is truncated.
+class PageStore {
+public:
+    PageStore();
+    ~PageStore();
+
+    // resume: keep pages already in the file, otherwise start empty
+    bool open(const std::string& path, bool resume);
+    void close();
+    bool isOpen() const;
+
+    // page: 8-bit, 1/3/4 channels. Returns the page index, -1 on error
+    int append(const cv::Mat& page, int enhanceMode, const float* corners);
+
+    int pageCount() const;
+    bool pageInfo(int index, StoredPageInfo& info) const;
+
+    bool mapPage(int index, bool thumbnail, PageView& view) const;
+    static void releaseView(PageView& view);
+
+    uint64_t fileSize() const;
+    bool sync();
+
+    std::string lastError() const;
+
+    static const int THUMBNAIL_SIZE = 256;   // Long side
+
+private:
+    struct Entry {
+        StoredPageInfo info;
+        int thumb_stride;
+        uint64_t data_offset;
+        uint64_t thumb_offset;
+    };
+
+    bool rebuildIndex(uint64_t fileSize);
+    bool mapRange(uint64_t offset, size_t size, PageView& view) const;
+    void fail(const std::string& message) const;
+
+    int fd_ = -1;
+    uint64_t end_ = 0;        // Next record offset
+    std::vector<Entry> pages_;
+
+    mutable std::mutex mutex_;
+    mutable std::string error_;
+};
+
+#endif // PAGE_STORE_HPP
@@ -0,0 +1,127 @@
+#include "page_turn_detector.hpp"
+#include "cpu_dispatch.hpp"
+#include <algorithm>
+
+PageTurnDetector::PageTurnDetector() {}
+
+PageTurnDetector::~PageTurnDetector() {}
+
+void PageTurnDetector::reset() {
+    previous_.release();
+    captured_.release();
+    state_ = SCAN_WAITING_FOR_TURN;
+    settled_ = 0;
+}
+
+cv::Mat PageTurnDetector::makeThumbnail(const cv::Mat& gray, const std::vector<cv::Point2f>& corners) {
+    cv::Mat thumb;
+
+    if (gray.empty()) {
+        return thumb;
+    }
+
+    if (corners.size() == 4) {
+        std::vector<cv::Point2f> dst = {
+            cv::Point2f(0, 0),
+            cv::Point2f(THUMB_SIZE - 1.0f, 0),
+            cv::Point2f(THUMB_SIZE - 1.0f, THUMB_SIZE - 1.0f),
+            cv::Point2f(0, THUMB_SIZE - 1.0f)
+        };
+        cv::Mat M = cv::getPerspectiveTransform(corners, dst);
+        cv::warpPerspective(gray, thumb, M, cv::Size(THUMB_SIZE, THUMB_SIZE),
+                            cv::INTER_LINEAR, cv::BORDER_REPLICATE);
+    } else {
+        cv::resize(gray, thumb, cv::Size(THUMB_SIZE, THUMB_SIZE), 0, 0, cv::INTER_AREA);
+    }
+
+    // Suppress sensor noise and small corner jitter
+    cv::GaussianBlur(thumb, thumb, cv::Size(5, 5), 0);
+
+    return thumb;
+}
+
+float PageTurnDetector::meanDifference(const cv::Mat& a, const cv::Mat& b) {
+    if (a.empty() || b.empty() || a.size() != b.size()) {
+        return 1.0f;
+    }
+
+    // Remove global brightness shift (auto exposure) before comparing
+    double raw;
+    if (a.type() == CV_8UC1 && b.type() == CV_8UC1 && a.isContinuous() && b.isContinuous()) {
+        raw = static_cast<double>(CpuDispatch::kernels().sad_u8(a.data, b.data, a.total())) / a.total();
+    } else {
+        cv::Mat diff;
+        cv::absdiff(a, b, diff);
+        raw = cv::mean(diff)[0];
+    }
+    double meanA = cv::mean(a)[0];
+    double meanB = cv::mean(b)[0];
+    double corrected = std::max(0.0, raw - std::abs(meanA - meanB));
+
+    return static_cast<float>(corrected / 255.0);
+}
+
+ScanEvent PageTurnDetector::update(const cv::Mat& thumbnail, bool qualityOk) {
+    ScanEvent event;
+
+    if (thumbnail.empty()) {
+        event.state = state_;
+        return event;
+    }
+
+    float motion = previous_.empty() ? 1.0f : meanDifference(thumbnail, previous_);
+    float change = captured_.empty() ? 1.0f : meanDifference(thumbnail, captured_);
+    bool still = motion < motion_threshold_;
+
+    switch (state_) {
+        case SCAN_WAITING_FOR_TURN:
+            if (change > change_threshold_) {
+                state_ = still ? SCAN_SETTLING : SCAN_TURNING;
+                settled_ = still ? 1 : 0;
+            }
+            break;
+
+        case SCAN_TURNING:
+            if (still) {
+                state_ = SCAN_SETTLING;
+                settled_ = 1;
+            }
+            break;
+
+        case SCAN_SETTLING:
+            if (!still) {
+                state_ = SCAN_TURNING;
+                settled_ = 0;
+                break;
+            }
+
+            settled_++;
+            if (settled_ >= settle_frames_) {
+                if (change <= change_threshold_) {
+                    // Page turned back or never left: nothing new to capture
+                    state_ = SCAN_WAITING_FOR_TURN;
+                    settled_ = 0;
+                } else if (qualityOk) {
+                    event.capture_trigger = true;
+                    thumbnail.copyTo(captured_);
+                    change = 0.0f;
+                    state_ = SCAN_WAITING_FOR_TURN;
+                    settled_ = 0;
+                }
+                // Otherwise keep settling until quality is acceptable
+            }
+            break;
+
+        case SCAN_OFF:
+        default:
+            break;
+    }
+
+    thumbnail.copyTo(previous_);
+
+    event.state = state_;
+    event.change_score = change;
+    event.motion_score = std::min(1.0f, motion);
+    event.settled_frames = settled_;
+    return event;
+}
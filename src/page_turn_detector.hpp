@@ -0,0 +1,60 @@
+#ifndef PAGE_TURN_DETECTOR_HPP
+#define PAGE_TURN_DETECTOR_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// Continuous (book) scan states
+enum ScanState {
+    SCAN_OFF = 0,
+    SCAN_WAITING_FOR_TURN = 1,  // Showing the last captured page
+    SCAN_TURNING = 2,           // Content changing (page being turned)
+    SCAN_SETTLING = 3           // New content, waiting for it to hold still
+};
+
+struct ScanEvent {
+    ScanState state;
+    bool capture_trigger;  // True on the frame a new settled page should be captured
+    float change_score;    // 0-1, difference from last captured page
+    float motion_score;    // 0-1, difference from previous frame
+    int settled_frames;
+
+    ScanEvent()
+        : state(SCAN_OFF), capture_trigger(false),
+          change_score(0), motion_score(0), settled_frames(0) {}
+};
+
+// Tracks content change on a small thumbnail of the document ROI and
+// recognizes the "new page settled" event for hands-free book scanning.
+class PageTurnDetector {
+public:
+    PageTurnDetector();
+    ~PageTurnDetector();
+
+    void reset();
+
+    // Thumbnail of the document ROI (quad warped) or the whole gray frame
+    static cv::Mat makeThumbnail(const cv::Mat& gray, const std::vector<cv::Point2f>& corners);
+
+    // qualityOk: frame is sharp/bright enough to be captured
+    ScanEvent update(const cv::Mat& thumbnail, bool qualityOk);
+
+    void setSettleFrames(int frames) { settle_frames_ = frames; }
+    void setChangeThreshold(float threshold) { change_threshold_ = threshold; }
+
+private:
+    static float meanDifference(const cv::Mat& a, const cv::Mat& b);
+
+    cv::Mat previous_;
+    cv::Mat captured_;
+    ScanState state_ = SCAN_WAITING_FOR_TURN;
+    int settled_ = 0;
+
+    int settle_frames_ = 8;           // Still frames required before trigger
+    float change_threshold_ = 0.08f;  // Min difference from last capture
+    float motion_threshold_ = 0.02f;  // Max frame-to-frame difference for "still"
+
+    static const int THUMB_SIZE = 64;
+};
+
+#endif // PAGE_TURN_DETECTOR_HPP
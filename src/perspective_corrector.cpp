@@ -59,6 +59,18 @@ cv::Size PerspectiveCorrector::calculateOutputSize(const std::vector<cv::Point2f
     float rightHeight = cv::norm(corners[2] - corners[1]);
     float height = (leftHeight + rightHeight) / 2.0f;
 
+    // Known format: keep the measured long side, derive the short side
+    if (aspect_ > 0) {
+        float aspect = aspect_ < 1.0f ? 1.0f / aspect_ : aspect_;
+        if (width >= height) {
+            height = width / aspect;
+        } else {
+            width = height / aspect;
+        }
+        width = std::round(width);
+        height = std::round(height);
+    }
+
     // Ensure minimum size
     width = std::max(width, 100.0f);
     height = std::max(height, 100.0f);
@@ -24,9 +24,15 @@ public:
         cv::Size outputSize = cv::Size(0, 0)
     );
 
+    // Known document aspect (long/short); auto output size then has exactly
+    // this ratio, in the orientation of the quad. 0 = measured from the quad.
+    void setAspectRatio(float aspect) { aspect_ = aspect; }
+
 private:
     cv::Size calculateOutputSize(const std::vector<cv::Point2f>& corners);
     std::vector<cv::Point2f> orderCorners(const std::vector<cv::Point2f>& corners);
+
+    float aspect_ = 0.0f;
 };
 
 #endif // PERSPECTIVE_CORRECTOR_HPP
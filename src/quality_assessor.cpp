@@ -287,7 +287,8 @@ QualityScore QualityAssessor::assess(
     }
 
     // Assess quality metrics
-    score.blur_score = detectBlur(gray);
+    score.blur = analyzeBlur(gray);
+    score.blur_score = score.blur.sharpness;
     score.brightness_score = checkBrightness(gray);
 
     if (!corners.empty() && corners.size() == 4) {
@@ -314,6 +315,84 @@ float QualityAssessor::detectBlur(const cv::Mat& gray) {
     return score;
 }
 
+BlurAnalysis QualityAssessor::analyzeBlur(const cv::Mat& gray) {
+    BlurAnalysis result;
+
+    if (gray.empty()) {
+        return result;
+    }
+
+    result.sharpness = detectBlur(gray);
+    result.strength = 1.0f - result.sharpness;
+
+    // Orientation analysis on a downscale; blur of a few pixels survives it
+    cv::Mat work;
+    int longSide = std::max(gray.cols, gray.rows);
+    if (longSide > BLUR_WORKING_SIZE) {
+        double s = static_cast<double>(BLUR_WORKING_SIZE) / longSide;
+        cv::resize(gray, work, cv::Size(), s, s, cv::INTER_AREA);
+    } else {
+        work = gray;
+    }
+
+    cv::Mat gx, gy;
+    cv::Sobel(work, gx, CV_32F, 1, 0, 3);
+    cv::Sobel(work, gy, CV_32F, 0, 1, 3);
+
+    // Structure tensor over edge pixels (above-mean energy; flat areas are noise)
+    cv::Mat energy = gx.mul(gx) + gy.mul(gy);
+    cv::Mat mask = energy > cv::mean(energy)[0];
+
+    double jxx = 0, jyy = 0, jxy = 0;
+    for (int y = 0; y < work.rows; y++) {
+        const float* px = gx.ptr<float>(y);
+        const float* py = gy.ptr<float>(y);
+        const uchar* m = mask.ptr<uchar>(y);
+        for (int x = 0; x < work.cols; x++) {
+            if (!m[x]) continue;
+            jxx += px[x] * px[x];
+            jyy += py[x] * py[x];
+            jxy += px[x] * py[x];
+        }
+    }
+
+    double trace = jxx + jyy;
+    if (trace <= 0) {
+        result.type = result.sharpness > 0.6f ? BLUR_NONE : BLUR_DEFOCUS;
+        return result;
+    }
+
+    // Coherence = (l1 - l2) / (l1 + l2)
+    double diff = std::sqrt((jxx - jyy) * (jxx - jyy) + 4.0 * jxy * jxy);
+    result.anisotropy = static_cast<float>(diff / trace);
+
+    // Gradients across the motion survive; those along it are smeared.
+    // Motion direction is therefore the minor eigenvector (major + 90 deg).
+    double major = 0.5 * std::atan2(2.0 * jxy, jxx - jyy) * 180.0 / CV_PI;
+    double direction = std::fmod(major + 90.0 + 360.0, 180.0);
+    result.direction = static_cast<float>(direction);
+
+    if (result.sharpness > 0.6f) {
+        result.type = BLUR_NONE;
+    } else if (result.anisotropy > MOTION_ANISOTROPY) {
+        result.type = BLUR_MOTION;
+    } else {
+        result.type = BLUR_DEFOCUS;
+    }
+
+    return result;
+}
+
+BlurAnalysis QualityAssessor::analyzeBlurInRegion(const cv::Mat& gray, const cv::Rect& region) {
+    // Validate region bounds
+    cv::Rect safeRegion = region & cv::Rect(0, 0, gray.cols, gray.rows);
+    if (safeRegion.width < 10 || safeRegion.height < 10) {
+        return analyzeBlur(gray);
+    }
+
+    return analyzeBlur(gray(safeRegion));
+}
+
 float QualityAssessor::checkBrightness(const cv::Mat& gray) {
     cv::Scalar meanVal = cv::mean(gray);
     double brightness = meanVal.val[0] / 255.0;
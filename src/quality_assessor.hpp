@@ -27,11 +27,30 @@ struct TextRegionsResult {
     TextRegionsResult() : found(false), regionCount(0), totalArea(0), coverageRatio(0) {}
 };
 
+// Blur cause, for "hold still" vs "refocus" hints
+enum BlurType {
+    BLUR_NONE = 0,     // Sharp enough
+    BLUR_DEFOCUS = 1,  // Isotropic loss of detail
+    BLUR_MOTION = 2    // Detail lost along one direction
+};
+
+struct BlurAnalysis {
+    float sharpness;    // 0-1, Laplacian variance score (same as blur_score)
+    BlurType type;
+    float direction;    // Motion direction in degrees [0,180), 0 = horizontal
+    float strength;     // 0-1, 1 - sharpness
+    float anisotropy;   // 0-1, gradient structure tensor coherence
+
+    BlurAnalysis()
+        : sharpness(0), type(BLUR_NONE), direction(0), strength(0), anisotropy(0) {}
+};
+
 struct QualityScore {
     float blur_score;         // 0-1, higher is sharper
     float brightness_score;   // 0-1, 0.5 is optimal
     float stability_score;    // 0-1, higher is more stable
     float corner_confidence;  // 0-1, from detection
+    BlurAnalysis blur;        // Blur type/direction (blur_score == blur.sharpness)
     TextRegion text_region;   // Detected text region (legacy, single)
     TextRegionsResult text_regions;  // All detected text regions
 
@@ -76,6 +95,9 @@ public:
     // Quality assessment methods (public for direct use)
     float detectBlur(const cv::Mat& gray);
     float detectBlurInRegion(const cv::Mat& gray, const cv::Rect& region);
+    // Sharpness plus blur type from the gradient orientation distribution
+    BlurAnalysis analyzeBlur(const cv::Mat& gray);
+    BlurAnalysis analyzeBlurInRegion(const cv::Mat& gray, const cv::Rect& region);
     float checkBrightness(const cv::Mat& gray);
     float checkBrightnessInRegion(const cv::Mat& gray, const cv::Rect& region);
 
@@ -84,6 +106,9 @@ private:
 
     std::deque<std::vector<cv::Point2f>> corner_history_;
     static const size_t MAX_HISTORY = 5;
+
+    static const int BLUR_WORKING_SIZE = 400;          // Long side for the orientation analysis
+    static constexpr float MOTION_ANISOTROPY = 0.35f;  // Coherence above which blur is directional
 };
 
 #endif // QUALITY_ASSESSOR_HPP
@@ -0,0 +1,206 @@
+#include "receipt_stitcher.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+ReceiptStitcher::ReceiptStitcher() {}
+
+ReceiptStitcher::~ReceiptStitcher() {}
+
+bool ReceiptStitcher::begin(int outputWidth, int maxHeight) {
+    cancel();
+
+    if (outputWidth < 64 || maxHeight < outputWidth) {
+        return false;
+    }
+
+    // Allocate once; memory stays bounded for the whole session
+    canvas_.create(maxHeight, outputWidth, CV_8UC3);
+    canvas_.setTo(cv::Scalar::all(255));
+    return true;
+}
+
+void ReceiptStitcher::cancel() {
+    canvas_.release();
+    key_reg_.release();
+    hann_.release();
+    filled_ = 0;
+    key_top_ = 0;
+    key_height_ = 0;
+}
+
+cv::Mat ReceiptStitcher::finish() {
+    cv::Mat result;
+    if (isActive() && filled_ > 0) {
+        result = canvas_.rowRange(0, filled_).clone();
+    }
+    cancel();
+    return result;
+}
+
+cv::Mat ReceiptStitcher::rectifyStrip(const cv::Mat& frame, const std::vector<cv::Point2f>& corners) {
+    const int outW = canvas_.cols;
+    cv::Mat strip;
+
+    if (corners.size() == 4) {
+        float topW = static_cast<float>(cv::norm(corners[1] - corners[0]));
+        float bottomW = static_cast<float>(cv::norm(corners[2] - corners[3]));
+        float leftH = static_cast<float>(cv::norm(corners[3] - corners[0]));
+        float rightH = static_cast<float>(cv::norm(corners[2] - corners[1]));
+        float avgW = (topW + bottomW) * 0.5f;
+        float avgH = (leftH + rightH) * 0.5f;
+        if (avgW < 1.0f) {
+            return strip;
+        }
+
+        int outH = std::min(outW * 3, std::max(32, static_cast<int>(outW * avgH / avgW)));
+        std::vector<cv::Point2f> dst = {
+            cv::Point2f(0, 0),
+            cv::Point2f(outW - 1.0f, 0),
+            cv::Point2f(outW - 1.0f, outH - 1.0f),
+            cv::Point2f(0, outH - 1.0f)
+        };
+        cv::Mat M = cv::getPerspectiveTransform(corners, dst);
+        cv::warpPerspective(frame, strip, M, cv::Size(outW, outH), cv::INTER_LINEAR, cv::BORDER_REPLICATE);
+    } else {
+        float scale = static_cast<float>(outW) / frame.cols;
+        cv::resize(frame, strip, cv::Size(outW, std::max(32, static_cast<int>(frame.rows * scale))),
+                   0, 0, scale < 1.0f ? cv::INTER_AREA : cv::INTER_LINEAR);
+    }
+
+    if (strip.channels() == 4) {
+        cv::cvtColor(strip, strip, cv::COLOR_BGRA2BGR);
+    } else if (strip.channels() == 1) {
+        cv::cvtColor(strip, strip, cv::COLOR_GRAY2BGR);
+    }
+
+    return strip;
+}
+
+cv::Mat ReceiptStitcher::registrationImage(const cv::Mat& strip) {
+    cv::Mat gray, small, reg;
+    cv::cvtColor(strip, gray, cv::COLOR_BGR2GRAY);
+    cv::resize(gray, small, cv::Size(strip.cols / REG_SCALE, strip.rows / REG_SCALE), 0, 0, cv::INTER_AREA);
+    small.convertTo(reg, CV_32F);
+    return reg;
+}
+
+void ReceiptStitcher::writeStrip(const cv::Mat& strip, int top) {
+    // Rows of the strip that are new (below filled_) plus a feathered seam
+    int seamStart = std::max(top, filled_ - FEATHER_ROWS);
+    int end = std::min(top + strip.rows, canvas_.rows);
+
+    for (int y = seamStart; y < end; y++) {
+        const cv::Mat src = strip.row(y - top);
+        cv::Mat dst = canvas_.row(y);
+        if (y < filled_) {
+            float alpha = static_cast<float>(y - seamStart + 1) / (filled_ - seamStart + 1);
+            cv::addWeighted(src, alpha, dst, 1.0f - alpha, 0, dst);
+        } else {
+            src.copyTo(dst);
+        }
+    }
+
+    filled_ = std::max(filled_, end);
+}
+
+float ReceiptStitcher::shiftError(const cv::Mat& a, const cv::Mat& b, int shift) {
+    int overlap = a.rows - std::abs(shift);
+    if (overlap < 4) {
+        return std::numeric_limits<float>::max();
+    }
+    cv::Mat ra = shift >= 0 ? a.rowRange(shift, a.rows) : a.rowRange(0, overlap);
+    cv::Mat rb = shift >= 0 ? b.rowRange(0, overlap) : b.rowRange(-shift, b.rows);
+    cv::Mat diff;
+    cv::absdiff(ra, rb, diff);
+    return static_cast<float>(cv::mean(diff)[0]);
+}
+
+StitchStatus ReceiptStitcher::addFrame(const cv::Mat& frame, const std::vector<cv::Point2f>& corners) {
+    StitchStatus status;
+
+    if (!isActive() || frame.empty()) {
+        return status;
+    }
+
+    status.stitched_height = filled_;
+
+    if (filled_ >= canvas_.rows) {
+        status.status = STITCH_FULL;
+        return status;
+    }
+
+    cv::Mat strip = rectifyStrip(frame, corners);
+    if (strip.empty()) {
+        status.status = STITCH_LOST;
+        return status;
+    }
+
+    cv::Mat reg = registrationImage(strip);
+
+    // First strip starts the canvas
+    if (key_reg_.empty()) {
+        writeStrip(strip, 0);
+        key_reg_ = reg;
+        key_top_ = 0;
+        key_height_ = strip.rows;
+        status.status = STITCH_STARTED;
+        status.response = 1.0f;
+        status.stitched_height = filled_;
+        return status;
+    }
+
+    // Phase correlation needs equal sizes; compare the common top part
+    int rows = std::min(key_reg_.rows, reg.rows);
+    cv::Mat a = key_reg_.rowRange(0, rows);
+    cv::Mat b = reg.rowRange(0, rows);
+    if (hann_.size() != a.size()) {
+        cv::createHanningWindow(hann_, a.size(), CV_32F);
+    }
+
+    double response = 0;
+    cv::Point2d shift = cv::phaseCorrelate(a, b, hann_, &response);
+
+    // Content moving up in the frame (panning down) gives a negative y shift.
+    // The correlation is circular: a pan of more than half the window wraps
+    // to a backward shift, so test the unwrapped candidate against the pixels
+    double regDy = -shift.y;
+    if (regDy < 0) {
+        int wrapped = static_cast<int>(std::lround(regDy));
+        if (shiftError(a, b, wrapped + rows) < shiftError(a, b, wrapped)) {
+            regDy += rows;
+        }
+    }
+    float dy = static_cast<float>(regDy * REG_SCALE);
+    float dx = static_cast<float>(shift.x * REG_SCALE);
+
+    status.shift = dy;
+    status.response = static_cast<float>(response);
+
+    if (response < 0.08 || std::abs(dx) > canvas_.cols * 0.1f || dy < -key_height_ * 0.1f) {
+        status.status = STITCH_LOST;
+        return status;
+    }
+
+    if (dy > rows * REG_SCALE * 0.75f) {
+        status.status = STITCH_TOO_FAST;
+        return status;
+    }
+
+    // Append once a quarter of a strip of new content is visible
+    if (dy < strip.rows * 0.25f) {
+        status.status = STITCH_TRACKING;
+        return status;
+    }
+
+    int top = key_top_ + static_cast<int>(std::lround(dy));
+    writeStrip(strip, top);
+
+    key_reg_ = reg;
+    key_top_ = top;
+    key_height_ = strip.rows;
+
+    status.status = filled_ >= canvas_.rows ? STITCH_FULL : STITCH_APPENDED;
+    status.stitched_height = filled_;
+    return status;
+}
@@ -0,0 +1,63 @@
+#ifndef RECEIPT_STITCHER_HPP
+#define RECEIPT_STITCHER_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// Per-frame stitching outcome
+enum StitchFrameStatus {
+    STITCH_INACTIVE = 0,     // begin() not called
+    STITCH_STARTED = 1,      // First strip written
+    STITCH_APPENDED = 2,     // New content appended
+    STITCH_TRACKING = 3,     // Registered, not enough new content yet
+    STITCH_LOST = 4,         // Registration failed (low response / sideways)
+    STITCH_TOO_FAST = 5,     // Shift larger than reliable overlap
+    STITCH_FULL = 6          // Canvas reached max height
+};
+
+struct StitchStatus {
+    StitchFrameStatus status;
+    float shift;          // Registered shift vs keyframe (output pixels, + = new content below)
+    float response;       // Phase-correlation peak response (0-1)
+    int stitched_height;  // Rows written so far
+
+    StitchStatus() : status(STITCH_INACTIVE), shift(0), response(0), stitched_height(0) {}
+};
+
+// Stitches a long receipt from overlapping rectified strips while the user pans
+// top-to-bottom. Strips are registered with phase correlation on downscaled gray
+// and composited into a preallocated canvas (bounded memory).
+class ReceiptStitcher {
+public:
+    ReceiptStitcher();
+    ~ReceiptStitcher();
+
+    bool begin(int outputWidth = 800, int maxHeight = 8000);
+    bool isActive() const { return !canvas_.empty(); }
+
+    // corners: receipt quad in frame (TL,TR,BR,BL), or empty for the whole frame
+    StitchStatus addFrame(const cv::Mat& frame, const std::vector<cv::Point2f>& corners);
+
+    // Returns stitched image (BGR) and ends the session
+    cv::Mat finish();
+    void cancel();
+
+private:
+    cv::Mat rectifyStrip(const cv::Mat& frame, const std::vector<cv::Point2f>& corners);
+    cv::Mat registrationImage(const cv::Mat& strip);
+    void writeStrip(const cv::Mat& strip, int top);
+    // Mean absolute difference where b, moved up by shift rows, overlaps a
+    static float shiftError(const cv::Mat& a, const cv::Mat& b, int shift);
+
+    cv::Mat canvas_;      // output_width x max_height, BGR
+    int filled_ = 0;      // Rows written
+    cv::Mat key_reg_;     // Registration image of keyframe
+    int key_top_ = 0;     // Canvas row of keyframe top
+    int key_height_ = 0;
+    cv::Mat hann_;
+
+    static const int REG_SCALE = 4;       // Registration downscale factor
+    static const int FEATHER_ROWS = 16;   // Seam blend height
+};
+
+#endif // RECEIPT_STITCHER_HPP
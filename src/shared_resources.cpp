@@ -0,0 +1,35 @@
+#include "shared_resources.hpp"
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <atomic>
+
+static std::atomic<int> g_requested_threads(0);
+
+SharedResources::SharedResources() {
+    CpuDispatch::select();
+    kernels_ = &CpuDispatch::kernels();
+
+    int requested = g_requested_threads.load();
+    if (requested > 0) {
+        cv::setNumThreads(requested);
+    }
+
+    // Spin up the worker pool once instead of on some engine's first frame
+    cv::parallel_for_(cv::Range(0, threadCount() * 4), [](const cv::Range&) {});
+}
+
+int SharedResources::threadCount() const {
+    return std::max(1, cv::getNumThreads());
+}
+
+const SharedResources& SharedResources::instance() {
+    static const SharedResources resources;
+    return resources;
+}
+
+void SharedResources::configureThreads(int threads) {
+    g_requested_threads.store(std::max(0, threads));
+    if (threads > 0) {
+        cv::setNumThreads(threads);
+    }
+}
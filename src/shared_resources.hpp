@@ -0,0 +1,29 @@
+#ifndef SHARED_RESOURCES_HPP
+#define SHARED_RESOURCES_HPP
+
+#include "cpu_dispatch.hpp"
+
+// Process-wide, read-only state shared by every CaptureEngine: selected
+// SIMD kernels and the OpenCV worker pool. Engines hold only per-session
+// state (tracking history, buffers, settings), so many of them can run
+// side by side (see EnginePool).
+class SharedResources {
+public:
+    // Initialized once on first use (thread-safe)
+    static const SharedResources& instance();
+
+    const KernelTable& kernels() const { return *kernels_; }
+    int threadCount() const;
+
+    // Cap OpenCV worker threads for the whole process, e.g. when a server
+    // runs several engines concurrently (0 = library default). Applies to
+    // instance() if called before first use, otherwise immediately.
+    static void configureThreads(int threads);
+
+private:
+    SharedResources();
+
+    const KernelTable* kernels_;
+};
+
+#endif // SHARED_RESOURCES_HPP
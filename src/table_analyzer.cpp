@@ -0,0 +1,219 @@
+#include "table_analyzer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+TableAnalyzer::TableAnalyzer() {}
+
+TableAnalyzer::~TableAnalyzer() {}
+
+cv::Mat TableAnalyzer::binarize(const cv::Mat& gray) {
+    // Ink = 255, paper = 0
+    cv::Mat binary;
+    cv::adaptiveThreshold(gray, binary, 255,
+                          cv::ADAPTIVE_THRESH_MEAN_C,
+                          cv::THRESH_BINARY_INV, 15, 10);
+    return binary;
+}
+
+std::vector<int> TableAnalyzer::findLinePositions(const cv::Mat& mask, bool horizontal, int minLength) {
+    // Projection profile: ink count per row (horizontal) or column (vertical)
+    cv::Mat profile;
+    cv::reduce(mask, profile, horizontal ? 1 : 0, cv::REDUCE_SUM, CV_32S);
+
+    const int n = horizontal ? profile.rows : profile.cols;
+    const int* values = profile.ptr<int>(0);
+    const int threshold = minLength * 255;
+
+    // Group consecutive rows/columns above threshold into one line (center)
+    std::vector<int> positions;
+    int start = -1;
+    for (int i = 0; i <= n; i++) {
+        bool on = i < n && values[i] >= threshold;
+        if (on && start < 0) {
+            start = i;
+        } else if (!on && start >= 0) {
+            positions.push_back((start + i - 1) / 2);
+            start = -1;
+        }
+    }
+
+    // Merge lines closer than a few pixels (double-stroked borders)
+    std::vector<int> merged;
+    for (int p : positions) {
+        if (!merged.empty() && p - merged.back() < 6) {
+            merged.back() = (merged.back() + p) / 2;
+        } else {
+            merged.push_back(p);
+        }
+    }
+
+    return merged;
+}
+
+float TableAnalyzer::borderCoverage(const cv::Mat& mask, bool horizontal, int pos, int from, int to) {
+    if (to <= from) {
+        return 0.0f;
+    }
+
+    // Thin strip around the border, collapsed across its thickness
+    const int halfThickness = 2;
+    cv::Rect strip;
+    if (horizontal) {
+        strip = cv::Rect(from, pos - halfThickness, to - from, halfThickness * 2 + 1);
+    } else {
+        strip = cv::Rect(pos - halfThickness, from, halfThickness * 2 + 1, to - from);
+    }
+    strip &= cv::Rect(0, 0, mask.cols, mask.rows);
+    if (strip.area() == 0) {
+        return 0.0f;
+    }
+
+    cv::Mat collapsed;
+    cv::reduce(mask(strip), collapsed, horizontal ? 0 : 1, cv::REDUCE_MAX);
+    return static_cast<float>(cv::countNonZero(collapsed)) / static_cast<float>(collapsed.total());
+}
+
+TableAnalysisResult TableAnalyzer::analyze(const cv::Mat& page) {
+    TableAnalysisResult result;
+
+    if (page.empty()) {
+        return result;
+    }
+
+    result.page_width = page.cols;
+    result.page_height = page.rows;
+
+    // Convert to grayscale
+    cv::Mat gray;
+    if (page.channels() == 3) {
+        cv::cvtColor(page, gray, cv::COLOR_BGR2GRAY);
+    } else if (page.channels() == 4) {
+        cv::cvtColor(page, gray, cv::COLOR_BGRA2GRAY);
+    } else {
+        gray = page;
+    }
+
+    // Downscale for speed; line geometry survives easily
+    float scale = 1.0f;
+    if (gray.cols > working_width_) {
+        scale = static_cast<float>(working_width_) / gray.cols;
+        cv::resize(gray, gray, cv::Size(), scale, scale, cv::INTER_AREA);
+    }
+
+    cv::Mat binary = binarize(gray);
+
+    // Separable morphology: 1-D opening keeps only long horizontal/vertical runs
+    int hLen = std::max(10, binary.cols / 25);
+    int vLen = std::max(10, binary.rows / 25);
+
+    cv::Mat hMask, vMask;
+    cv::morphologyEx(binary, hMask, cv::MORPH_OPEN,
+                     cv::getStructuringElement(cv::MORPH_RECT, cv::Size(hLen, 1)));
+    cv::morphologyEx(binary, vMask, cv::MORPH_OPEN,
+                     cv::getStructuringElement(cv::MORPH_RECT, cv::Size(1, vLen)));
+
+    // Bridge small gaps along the line direction (broken print, JPEG)
+    cv::dilate(hMask, hMask, cv::getStructuringElement(cv::MORPH_RECT, cv::Size(5, 1)));
+    cv::dilate(vMask, vMask, cv::getStructuringElement(cv::MORPH_RECT, cv::Size(1, 5)));
+
+    std::vector<int> ys = findLinePositions(hMask, true, binary.cols / 6);
+    std::vector<int> xs = findLinePositions(vMask, false, binary.rows / 10);
+
+    if (ys.size() < 2 || xs.size() < 2) {
+        return result;
+    }
+
+    const int rows = static_cast<int>(ys.size()) - 1;
+    const int cols = static_cast<int>(xs.size()) - 1;
+
+    // Union-find over grid cells; merge across missing borders
+    std::vector<int> parent(rows * cols);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    auto unite = [&](int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a != b) parent[std::max(a, b)] = std::min(a, b);
+    };
+
+    const float MIN_BORDER_COVERAGE = 0.6f;
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            // Border to the right (vertical line xs[c+1] between ys[r]..ys[r+1])
+            if (c + 1 < cols &&
+                borderCoverage(vMask, false, xs[c + 1], ys[r], ys[r + 1]) < MIN_BORDER_COVERAGE) {
+                unite(r * cols + c, r * cols + c + 1);
+            }
+            // Border below (horizontal line ys[r+1] between xs[c]..xs[c+1])
+            if (r + 1 < rows &&
+                borderCoverage(hMask, true, ys[r + 1], xs[c], xs[c + 1]) < MIN_BORDER_COVERAGE) {
+                unite(r * cols + c, (r + 1) * cols + c);
+            }
+        }
+    }
+
+    // Collect merged groups as grid spans
+    std::vector<int> minR(rows * cols, rows), minC(rows * cols, cols), maxR(rows * cols, -1), maxC(rows * cols, -1);
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            int g = find(r * cols + c);
+            minR[g] = std::min(minR[g], r);
+            minC[g] = std::min(minC[g], c);
+            maxR[g] = std::max(maxR[g], r);
+            maxC[g] = std::max(maxC[g], c);
+        }
+    }
+
+    const float inv = 1.0f / scale;
+    for (int g = 0; g < rows * cols; g++) {
+        if (maxR[g] < 0) continue;
+
+        int x0 = static_cast<int>(std::lround(xs[minC[g]] * inv));
+        int y0 = static_cast<int>(std::lround(ys[minR[g]] * inv));
+        int x1 = static_cast<int>(std::lround(xs[maxC[g] + 1] * inv));
+        int y1 = static_cast<int>(std::lround(ys[maxR[g] + 1] * inv));
+
+        // Skip slivers between double lines
+        if (x1 - x0 < 8 || y1 - y0 < 8) continue;
+
+        TableCell cell;
+        cell.bounds = cv::Rect(x0, y0, x1 - x0, y1 - y0) & cv::Rect(0, 0, page.cols, page.rows);
+        cell.row = minR[g];
+        cell.col = minC[g];
+        cell.row_span = maxR[g] - minR[g] + 1;
+        cell.col_span = maxC[g] - minC[g] + 1;
+        result.cells.push_back(cell);
+    }
+
+    // A single merged box is a frame, not a table
+    if (result.cells.size() < 2) {
+        result.cells.clear();
+        return result;
+    }
+
+    // Reading order: top-to-bottom, left-to-right
+    std::sort(result.cells.begin(), result.cells.end(),
+              [](const TableCell& a, const TableCell& b) {
+                  return a.row != b.row ? a.row < b.row : a.col < b.col;
+              });
+
+    for (int y : ys) result.row_lines.push_back(static_cast<int>(std::lround(y * inv)));
+    for (int x : xs) result.col_lines.push_back(static_cast<int>(std::lround(x * inv)));
+
+    result.found = true;
+    result.rows = rows;
+    result.cols = cols;
+    result.table_bounds = cv::Rect(
+        result.col_lines.front(), result.row_lines.front(),
+        result.col_lines.back() - result.col_lines.front(),
+        result.row_lines.back() - result.row_lines.front()) & cv::Rect(0, 0, page.cols, page.rows);
+
+    return result;
+}
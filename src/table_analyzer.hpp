@@ -0,0 +1,50 @@
+#ifndef TABLE_ANALYZER_HPP
+#define TABLE_ANALYZER_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+struct TableCell {
+    cv::Rect bounds;  // Cell rectangle in page coordinates
+    int row;          // Top-left grid row
+    int col;          // Top-left grid column
+    int row_span;
+    int col_span;
+
+    TableCell() : row(0), col(0), row_span(1), col_span(1) {}
+};
+
+struct TableAnalysisResult {
+    bool found;
+    int rows;                        // Grid rows (before merging)
+    int cols;                        // Grid columns (before merging)
+    std::vector<int> row_lines;      // Y of horizontal ruling lines (page coords)
+    std::vector<int> col_lines;      // X of vertical ruling lines (page coords)
+    std::vector<TableCell> cells;    // Cells (merged cells reported once with spans)
+    cv::Rect table_bounds;
+    int page_width;
+    int page_height;
+
+    TableAnalysisResult() : found(false), rows(0), cols(0), page_width(0), page_height(0) {}
+};
+
+// Extracts ruling-line table grids from a rectified page.
+// Lines are found with separable (1-D) morphology on a binarized downscale.
+class TableAnalyzer {
+public:
+    TableAnalyzer();
+    ~TableAnalyzer();
+
+    TableAnalysisResult analyze(const cv::Mat& page);
+
+    void setWorkingWidth(int width) { working_width_ = width; }
+
+private:
+    cv::Mat binarize(const cv::Mat& gray);
+    std::vector<int> findLinePositions(const cv::Mat& mask, bool horizontal, int minLength);
+    float borderCoverage(const cv::Mat& mask, bool horizontal, int pos, int from, int to);
+
+    int working_width_ = 800;
+};
+
+#endif // TABLE_ANALYZER_HPP
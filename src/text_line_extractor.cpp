@@ -0,0 +1,202 @@
+#include "text_line_extractor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+TextLineExtractor::TextLineExtractor() {}
+
+TextLineExtractor::~TextLineExtractor() {}
+
+std::vector<cv::Rect> TextLineExtractor::findLines(const cv::Mat& gray) {
+    std::vector<cv::Rect> lines;
+
+    if (gray.empty()) {
+        return lines;
+    }
+
+    // Segment at a fixed working width
+    cv::Mat work;
+    float scale = 1.0f;
+    if (gray.cols > working_width_) {
+        scale = static_cast<float>(working_width_) / gray.cols;
+        cv::resize(gray, work, cv::Size(), scale, scale, cv::INTER_AREA);
+    } else {
+        work = gray;
+    }
+
+    cv::Mat binary;
+    cv::adaptiveThreshold(work, binary, 255,
+                          cv::ADAPTIVE_THRESH_GAUSSIAN_C,
+                          cv::THRESH_BINARY_INV, 25, 15);
+
+    // Remove ruling lines so table borders don't become text lines
+    cv::Mat hLines, vLines;
+    cv::morphologyEx(binary, hLines, cv::MORPH_OPEN,
+                     cv::getStructuringElement(cv::MORPH_RECT, cv::Size(std::max(10, binary.cols / 20), 1)));
+    cv::morphologyEx(binary, vLines, cv::MORPH_OPEN,
+                     cv::getStructuringElement(cv::MORPH_RECT, cv::Size(1, std::max(10, binary.rows / 20))));
+    binary -= hLines;
+    binary -= vLines;
+
+    // Connect characters horizontally only (keeps adjacent lines apart)
+    cv::Mat connected;
+    cv::dilate(binary, connected,
+               cv::getStructuringElement(cv::MORPH_RECT, cv::Size(std::max(7, binary.cols / 60), 1)));
+
+    std::vector<std::vector<cv::Point>> contours;
+    cv::findContours(connected, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+
+    std::vector<cv::Rect> boxes;
+    const int maxHeight = std::max(12, work.rows / 6);
+    for (const auto& contour : contours) {
+        cv::Rect b = cv::boundingRect(contour);
+        if (b.height < 5 || b.height > maxHeight) continue;
+        if (b.width < b.height) continue;  // Specks and isolated marks
+        boxes.push_back(b);
+    }
+
+    // Group into rows with one sweep over boxes sorted by vertical center:
+    // a box more than half the row height below the row's running center
+    // starts a new row (a strict order, unlike a pairwise tolerance)
+    std::sort(boxes.begin(), boxes.end(), [](const cv::Rect& a, const cv::Rect& b) {
+        return a.y * 2 + a.height < b.y * 2 + b.height;
+    });
+
+    std::vector<std::vector<cv::Rect>> rows;
+    float rowCenter = 0.0f;
+    float rowHeight = 0.0f;
+    for (const auto& b : boxes) {
+        float center = b.y + b.height * 0.5f;
+        if (rows.empty() || center - rowCenter > rowHeight * 0.5f) {
+            rows.emplace_back();
+            rowCenter = 0.0f;
+            rowHeight = 0.0f;
+        }
+        std::vector<cv::Rect>& row = rows.back();
+        row.push_back(b);
+        float n = static_cast<float>(row.size());
+        rowCenter += (center - rowCenter) / n;
+        rowHeight += (b.height - rowHeight) / n;
+    }
+
+    // Reading order within a row is left to right; merge fragments of the
+    // same line (large word gaps) in one pass over neighbours
+    boxes.clear();
+    for (auto& row : rows) {
+        std::sort(row.begin(), row.end(),
+                  [](const cv::Rect& a, const cv::Rect& b) { return a.x < b.x; });
+
+        size_t first = boxes.size();
+        for (const auto& b : row) {
+            if (boxes.size() > first) {
+                cv::Rect& a = boxes.back();
+                int overlap = std::min(a.y + a.height, b.y + b.height) - std::max(a.y, b.y);
+                int minH = std::min(a.height, b.height);
+                int gap = b.x - (a.x + a.width);
+
+                if (overlap > minH * 0.6 && gap < minH * 2) {
+                    a |= b;
+                    continue;
+                }
+            }
+            boxes.push_back(b);
+        }
+    }
+
+    // Back to page coordinates with padding for ascenders/descenders
+    const cv::Rect pageRect(0, 0, gray.cols, gray.rows);
+    const float inv = 1.0f / scale;
+    for (const auto& b : boxes) {
+        int padY = static_cast<int>(b.height * 0.15f * inv);
+        int padX = static_cast<int>(b.height * 0.3f * inv);
+        cv::Rect r(static_cast<int>(b.x * inv) - padX,
+                   static_cast<int>(b.y * inv) - padY,
+                   static_cast<int>(b.width * inv) + padX * 2,
+                   static_cast<int>(b.height * inv) + padY * 2);
+        r &= pageRect;
+        if (r.area() > 0) {
+            lines.push_back(r);
+        }
+    }
+
+    return lines;
+}
+
+TextLineBatch TextLineExtractor::extract(const cv::Mat& page, int lineHeight, int maxLineWidth) {
+    TextLineBatch batch;
+
+    if (page.empty() || lineHeight <= 0) {
+        strncpy(batch.error_message, "Invalid page", sizeof(batch.error_message) - 1);
+        return batch;
+    }
+
+    cv::Mat gray;
+    if (page.channels() == 3) {
+        cv::cvtColor(page, gray, cv::COLOR_BGR2GRAY);
+    } else if (page.channels() == 4) {
+        cv::cvtColor(page, gray, cv::COLOR_BGRA2GRAY);
+    } else {
+        gray = page;
+    }
+
+    std::vector<cv::Rect> lines = findLines(gray);
+
+    batch.line_height = lineHeight;
+    batch.count = static_cast<int>(lines.size());
+    batch.success = true;
+
+    if (lines.empty()) {
+        return batch;
+    }
+
+    // Compute packed layout first so the buffer is allocated once
+    std::vector<int> widths(lines.size());
+    size_t total = 0;
+    for (size_t i = 0; i < lines.size(); i++) {
+        float aspect = static_cast<float>(lines[i].width) / lines[i].height;
+        widths[i] = std::max(1, std::min(maxLineWidth, static_cast<int>(std::lround(aspect * lineHeight))));
+        total += static_cast<size_t>(widths[i]) * lineHeight;
+    }
+
+    batch.data = new uint8_t[total];
+    batch.data_size = static_cast<int>(total);
+    batch.offsets = new int[lines.size()];
+    batch.widths = new int[lines.size()];
+    batch.boxes = new float[lines.size() * 4];
+
+    size_t offset = 0;
+    for (size_t i = 0; i < lines.size(); i++) {
+        const cv::Rect& r = lines[i];
+
+        // Resize straight into the packed buffer
+        cv::Mat dst(lineHeight, widths[i], CV_8UC1, batch.data + offset);
+        int interp = r.height > lineHeight ? cv::INTER_AREA : cv::INTER_LINEAR;
+        cv::resize(gray(r), dst, dst.size(), 0, 0, interp);
+
+        batch.offsets[i] = static_cast<int>(offset);
+        batch.widths[i] = widths[i];
+        batch.boxes[i * 4 + 0] = static_cast<float>(r.x);
+        batch.boxes[i * 4 + 1] = static_cast<float>(r.y);
+        batch.boxes[i * 4 + 2] = static_cast<float>(r.width);
+        batch.boxes[i * 4 + 3] = static_cast<float>(r.height);
+
+        offset += static_cast<size_t>(widths[i]) * lineHeight;
+    }
+
+    return batch;
+}
+
+void TextLineExtractor::freeBatch(TextLineBatch* batch) {
+    if (!batch) {
+        return;
+    }
+
+    delete[] batch->data;
+    delete[] batch->offsets;
+    delete[] batch->widths;
+    delete[] batch->boxes;
+    batch->data = nullptr;
+    batch->offsets = nullptr;
+    batch->widths = nullptr;
+    batch->boxes = nullptr;
+}
@@ -0,0 +1,52 @@
+#ifndef TEXT_LINE_EXTRACTOR_HPP
+#define TEXT_LINE_EXTRACTOR_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// All text-line crops of a page packed into one contiguous gray buffer.
+// Line i occupies line_height rows of widths[i] bytes starting at offsets[i].
+struct TextLineBatch {
+    uint8_t* data;
+    int data_size;
+    int line_height;
+    int count;
+    int* offsets;      // Byte offset of each line in data
+    int* widths;       // Width (and row stride) of each line
+    float* boxes;      // x,y,w,h of each line in page coordinates
+    bool success;
+    char error_message[256];
+
+    TextLineBatch() {
+        data = nullptr;
+        data_size = 0;
+        line_height = 0;
+        count = 0;
+        offsets = nullptr;
+        widths = nullptr;
+        boxes = nullptr;
+        success = false;
+        error_message[0] = '\0';
+    }
+};
+
+// Segments a rectified page into text lines for OCR recognizers,
+// so no separate text detection pass is needed.
+class TextLineExtractor {
+public:
+    TextLineExtractor();
+    ~TextLineExtractor();
+
+    // Line boxes in reading order (page coordinates)
+    std::vector<cv::Rect> findLines(const cv::Mat& gray);
+
+    // Crop, normalize height and pack all lines
+    TextLineBatch extract(const cv::Mat& page, int lineHeight = 48, int maxLineWidth = 2048);
+
+    static void freeBatch(TextLineBatch* batch);
+
+private:
+    int working_width_ = 1000;
+};
+
+#endif // TEXT_LINE_EXTRACTOR_HPP